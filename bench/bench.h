@@ -0,0 +1,200 @@
+/**
+ * @file bench.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 基准测试公共部分：纳秒计时与 JSON 输出。
+ * @version 0.1
+ * @date 2024-09-14
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_task.h"
+#include "port.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 一次基准测试的输出。
+ *
+ * 输出格式：
+ * @code
+ * {"bench":"dispatch","results":[
+ *   {"case":"ntask","blocked":0,"ops":200000,"ns":3100000,"ns_per_op":15.50,"ops_per_sec":64516129.03}
+ * ]}
+ * @endcode
+ * 每一行结果的 case 与参数组合唯一，可以直接按行对比不同版本的输出。
+ */
+typedef struct _bench_t {
+    FILE *out;                      /*!< 输出文件，默认为 stdout */
+    uint32_t rows;                  /*!< 已输出的结果行数 */
+} bench_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/* ==================== [Macros] ============================================ */
+
+/**
+ * @brief 单调时钟，单位为纳秒。
+ */
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec tp;
+    clock_gettime(CLOCK_MONOTONIC, &tp);
+    return (uint64_t)tp.tv_sec * 1000000000ULL + (uint64_t)tp.tv_nsec;
+}
+
+/**
+ * @brief 对接时间戳、上下文并初始化默认任务管理器，然后开始输出。
+ *
+ * @param bench 基准测试对象。
+ * @param name 基准测试名。
+ * @param argc main 的参数个数。
+ * @param argv main 的参数，argv[1] 存在时结果写入该文件，否则写到 stdout.
+ */
+static inline void bench_begin(bench_t *bench, const char *name, int argc, char *argv[])
+{
+    xf_task_tick_init(task_get_tick);
+#if XF_TASK_CONTEXT_IS_ENABLE
+    xf_task_context_init(create_context, swap_context);
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+    // 不设置空闲回调，基准测试中的空闲只是一次空转
+    xf_task_manager_default_init(NULL);
+
+    bench->out = stdout;
+    bench->rows = 0;
+    if (argc > 1) {
+        bench->out = fopen(argv[1], "w");
+        if (bench->out == NULL) {
+            fprintf(stderr, "cannot open %s\n", argv[1]);
+            exit(1);
+        }
+    }
+
+    fprintf(bench->out, "{\"bench\":\"%s\",\"results\":[", name);
+}
+
+/**
+ * @brief 结束输出。
+ */
+static inline void bench_end(bench_t *bench)
+{
+    fprintf(bench->out, "\n]}\n");
+    if (bench->out != stdout) {
+        fclose(bench->out);
+    }
+}
+
+/**
+ * @brief 开始一行结果。
+ *
+ * @param bench 基准测试对象。
+ * @param name 用例名。
+ * @param param 参数名，为 NULL 时不输出参数。
+ * @param value 参数值。
+ */
+static inline void bench_row_begin(bench_t *bench, const char *name, const char *param, uint64_t value)
+{
+    fprintf(bench->out, "%s\n  {\"case\":\"%s\"", bench->rows++ ? "," : "", name);
+    if (param != NULL) {
+        fprintf(bench->out, ",\"%s\":%llu", param, (unsigned long long)value);
+    }
+}
+
+/**
+ * @brief 在当前行中输出一个数值。
+ */
+static inline void bench_row_num(bench_t *bench, const char *key, double value)
+{
+    fprintf(bench->out, ",\"%s\":%.2f", key, value);
+}
+
+/**
+ * @brief 在当前行中输出一个整数。
+ */
+static inline void bench_row_u64(bench_t *bench, const char *key, uint64_t value)
+{
+    fprintf(bench->out, ",\"%s\":%llu", key, (unsigned long long)value);
+}
+
+/**
+ * @brief 在当前行中输出 ops 次操作耗时 ns 纳秒的速率。
+ */
+static inline void bench_row_rate(bench_t *bench, uint64_t ops, uint64_t ns)
+{
+    bench_row_u64(bench, "ops", ops);
+    bench_row_u64(bench, "ns", ns);
+    bench_row_num(bench, "ns_per_op", ops ? (double)ns / (double)ops : 0.0);
+    bench_row_num(bench, "ops_per_sec", ns ? (double)ops * 1e9 / (double)ns : 0.0);
+}
+
+/**
+ * @brief 结束当前行。
+ */
+static inline void bench_row_end(bench_t *bench)
+{
+    fprintf(bench->out, "}");
+    fflush(bench->out);
+}
+
+/**
+ * @brief qsort 使用的比较函数。
+ */
+static inline int bench_cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 对 count 个样本排序后在当前行中输出 p50/p90/p99/max.
+ */
+static inline void bench_row_percentile(bench_t *bench, uint64_t *samples, uint32_t count)
+{
+    if (count == 0) {
+        return;
+    }
+
+    qsort(samples, count, sizeof(samples[0]), bench_cmp_u64);
+    bench_row_u64(bench, "p50_ns", samples[count * 50 / 100]);
+    bench_row_u64(bench, "p90_ns", samples[count * 90 / 100]);
+    bench_row_u64(bench, "p99_ns", samples[count * 99 / 100]);
+    bench_row_u64(bench, "max_ns", samples[count - 1]);
+}
+
+/**
+ * @brief 删除任务后调度一次，让任务管理器在空闲时释放它们。
+ *
+ * @note 调用前需要保证任务管理器中没有其它就绪任务。
+ */
+static inline void bench_delete_tasks(xf_task_manager_t manager, xf_task_t *tasks, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        if (tasks[i] != NULL) {
+            xf_task_delete(tasks[i]);
+        }
+    }
+    xf_task_manager_run(manager);
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // __BENCH_H__
@@ -0,0 +1,69 @@
+/**
+ * @file bench_ctask_switch.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief ctask 让出再被调度回来的开销。
+ * @version 0.1
+ * @date 2024-09-14
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#include "bench.h"
+
+#define SWITCHES 200000
+#define TASKS_MAX 16
+#define STACK_SIZE (1024 * 16)
+
+static xf_task_manager_t s_manager = NULL;
+static uint32_t s_switches = 0;
+
+static void yield_task(xf_task_t task)
+{
+    while (1) {
+        // 立即超时的延时只是让出一次，下一次调度就会切换回来
+        xf_ctask_delay_with_manager(s_manager, 0);
+        s_switches++;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    static const uint32_t tasks_list[] = {1, 2, 16};
+    static xf_task_t tasks[TASKS_MAX];
+    bench_t bench;
+
+    bench_begin(&bench, "ctask_switch", argc, argv);
+
+    for (uint32_t i = 0; i < sizeof(tasks_list) / sizeof(tasks_list[0]); i++) {
+        uint32_t count = tasks_list[i];
+        s_manager = xf_task_manager_create(NULL);
+
+        for (uint32_t j = 0; j < count; j++) {
+            tasks[j] = xf_ctask_create_with_manager(s_manager, yield_task, NULL, 0, STACK_SIZE);
+        }
+        // 每个任务先运行到第一次让出
+        for (uint32_t j = 0; j < count; j++) {
+            xf_task_manager_run(s_manager);
+        }
+
+        s_switches = 0;
+        uint64_t start = bench_now_ns();
+        while (s_switches < SWITCHES) {
+            xf_task_manager_run(s_manager);
+        }
+        uint64_t ns = bench_now_ns() - start;
+
+        // 一次操作包括换入与换出两次上下文切换，以及一次调度
+        bench_row_begin(&bench, "yield", "tasks", count);
+        bench_row_rate(&bench, s_switches, ns);
+        bench_row_end(&bench);
+
+        bench_delete_tasks(s_manager, tasks, count);
+        xf_task_manager_delete(s_manager);
+    }
+
+    bench_end(&bench);
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file bench_dispatch.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 调度速率与阻塞任务数的关系。
+ * @version 0.1
+ * @date 2024-09-14
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#include "bench.h"
+
+#define DISPATCHES 200000
+#define BLOCKED_MAX 1024
+
+static uint32_t s_runs = 0;
+
+static void ready_task(xf_task_t task)
+{
+    s_runs++;
+    // 每次执行后重新触发自己，始终保持一个就绪任务
+    xf_task_trigger(task);
+}
+
+static void blocked_task(xf_task_t task)
+{
+}
+
+int main(int argc, char *argv[])
+{
+    static const uint32_t blocked_list[] = {0, 16, 64, 256, 1024};
+    static xf_task_t tasks[BLOCKED_MAX + 1];
+    bench_t bench;
+
+    bench_begin(&bench, "dispatch", argc, argv);
+
+    for (uint32_t i = 0; i < sizeof(blocked_list) / sizeof(blocked_list[0]); i++) {
+        uint32_t blocked = blocked_list[i];
+        xf_task_manager_t manager = xf_task_manager_create(NULL);
+
+        // 阻塞任务的周期足够长，在测试期间只参与阻塞队列的扫描
+        for (uint32_t j = 0; j < blocked; j++) {
+            tasks[j] = xf_ntask_create_loop_with_manager(manager, blocked_task, NULL, 1, 3600 * 1000);
+        }
+        tasks[blocked] = xf_ntask_create_loop_with_manager(manager, ready_task, NULL, 0, 0);
+        xf_task_trigger(tasks[blocked]);
+
+        // 单次调度的开销随阻塞任务数线性增长，相应减少次数
+        uint32_t dispatches = DISPATCHES * 16 / (16 + blocked);
+        s_runs = 0;
+        uint64_t start = bench_now_ns();
+        while (s_runs < dispatches) {
+            xf_task_manager_run(manager);
+        }
+        uint64_t ns = bench_now_ns() - start;
+
+        bench_row_begin(&bench, "ntask", "blocked", blocked);
+        bench_row_rate(&bench, s_runs, ns);
+        bench_row_end(&bench);
+
+        // 先让就绪任务回到阻塞，删除后的那次调度才会进入空闲
+        xf_task_delete(tasks[blocked]);
+        tasks[blocked] = NULL;
+        xf_task_manager_run(manager);
+        bench_delete_tasks(manager, tasks, blocked);
+        xf_task_manager_delete(manager);
+    }
+
+    bench_end(&bench);
+
+    return 0;
+}
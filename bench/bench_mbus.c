@@ -0,0 +1,80 @@
+/**
+ * @file bench_mbus.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 消息总线的扇出吞吐量。
+ * @version 0.1
+ * @date 2024-09-14
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#include "bench.h"
+
+#define MESSAGES 100000
+#define TOPIC_ID 1
+
+static uint32_t s_delivered = 0;
+
+// 同一个主题不允许重复订阅同一个回调，这里生成 64 个不同的回调
+#define SUB_FUNC(n) static void sub_##n(const void *const data, void *user_data) { s_delivered++; }
+#define SUB_FUNC4(n) SUB_FUNC(n##0) SUB_FUNC(n##1) SUB_FUNC(n##2) SUB_FUNC(n##3)
+#define SUB_FUNC16(n) SUB_FUNC4(n##0) SUB_FUNC4(n##1) SUB_FUNC4(n##2) SUB_FUNC4(n##3)
+SUB_FUNC16(0) SUB_FUNC16(1) SUB_FUNC16(2) SUB_FUNC16(3)
+
+#define SUB_NAME(n) sub_##n,
+#define SUB_NAME4(n) SUB_NAME(n##0) SUB_NAME(n##1) SUB_NAME(n##2) SUB_NAME(n##3)
+#define SUB_NAME16(n) SUB_NAME4(n##0) SUB_NAME4(n##1) SUB_NAME4(n##2) SUB_NAME4(n##3)
+static const xf_task_mbus_func_t s_subs[] = {SUB_NAME16(0) SUB_NAME16(1) SUB_NAME16(2) SUB_NAME16(3)};
+
+static void bench_fanout(bench_t *bench, bool sync, uint32_t subs)
+{
+    uint32_t data = 0;
+    uint32_t messages = 0;
+
+    s_delivered = 0;
+    uint64_t start = bench_now_ns();
+    if (sync) {
+        for (; messages < MESSAGES; messages++) {
+            xf_task_mbus_pub_sync(TOPIC_ID, &data);
+        }
+    } else {
+        // 异步发布的队列深度为 2，每发布两次处理一次
+        for (; messages < MESSAGES; messages += 2) {
+            xf_task_mbus_pub_async(TOPIC_ID, &data);
+            xf_task_mbus_pub_async(TOPIC_ID, &data);
+            xf_task_mbus_handle();
+        }
+    }
+    uint64_t ns = bench_now_ns() - start;
+
+    bench_row_begin(bench, sync ? "pub_sync" : "pub_async", "subs", subs);
+    bench_row_rate(bench, messages, ns);
+    bench_row_num(bench, "deliveries_per_sec", (double)s_delivered * 1e9 / (double)ns);
+    bench_row_end(bench);
+}
+
+int main(int argc, char *argv[])
+{
+    static const uint32_t subs_list[] = {1, 4, 16, 64};
+    bench_t bench;
+    uint32_t subs = 0;
+
+    bench_begin(&bench, "mbus", argc, argv);
+
+    xf_task_mbus_reg_topic(TOPIC_ID, sizeof(uint32_t));
+
+    for (uint32_t i = 0; i < sizeof(subs_list) / sizeof(subs_list[0]); i++) {
+        for (; subs < subs_list[i]; subs++) {
+            xf_task_mbus_sub(TOPIC_ID, s_subs[subs], NULL);
+        }
+        bench_fanout(&bench, true, subs);
+        bench_fanout(&bench, false, subs);
+    }
+
+    xf_task_mbus_unreg_topic(TOPIC_ID);
+
+    bench_end(&bench);
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file bench_memory.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 每个任务占用的堆内存。
+ * @version 0.1
+ * @date 2024-09-14
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#include "bench.h"
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define BENCH_HEAP_USED() ((uint64_t)mallinfo2().uordblks)
+#endif
+
+#define TASKS 1000
+
+static void task_func(xf_task_t task)
+{
+}
+
+#ifdef BENCH_HEAP_USED
+
+/**
+ * @brief 创建 TASKS 个任务，用堆内存的增量计算每个任务的开销（包括分配器的额外开销）。
+ */
+static void bench_tasks(bench_t *bench, const char *name, xf_task_type_t type, void *config, size_t stack_size)
+{
+    static xf_task_t tasks[TASKS];
+    xf_task_manager_t manager = xf_task_manager_create(NULL);
+
+    uint64_t before = BENCH_HEAP_USED();
+    for (uint32_t i = 0; i < TASKS; i++) {
+        tasks[i] = xf_task_create_with_manager(manager, type, task_func, NULL, 0, config);
+    }
+    uint64_t after = BENCH_HEAP_USED();
+
+    bench_row_begin(bench, name, "stack_size", stack_size);
+    bench_row_u64(bench, "tasks", TASKS);
+    bench_row_num(bench, "bytes_per_task", (double)(after - before) / TASKS);
+    bench_row_num(bench, "overhead_per_task", (double)(after - before) / TASKS - (double)stack_size);
+    bench_row_end(bench);
+
+    bench_delete_tasks(manager, tasks, TASKS);
+    xf_task_manager_delete(manager);
+}
+
+#endif // BENCH_HEAP_USED
+
+int main(int argc, char *argv[])
+{
+    bench_t bench;
+
+    bench_begin(&bench, "memory", argc, argv);
+
+#ifdef BENCH_HEAP_USED
+    uint64_t before = BENCH_HEAP_USED();
+    xf_task_manager_t manager = xf_task_manager_create(NULL);
+    uint64_t after = BENCH_HEAP_USED();
+    xf_task_manager_delete(manager);
+
+    bench_row_begin(&bench, "manager", NULL, 0);
+    bench_row_u64(&bench, "bytes", after - before);
+    bench_row_end(&bench);
+
+    xf_ntask_config_t nconfig = {.count = XF_NTASK_INFINITE_LOOP, .delay_ms = 1000};
+    bench_tasks(&bench, "ntask", XF_TASK_TYPE_NTASK, &nconfig, 0);
+
+    static const size_t stack_list[] = {1024 * 4, 1024 * 16};
+    for (uint32_t i = 0; i < sizeof(stack_list) / sizeof(stack_list[0]); i++) {
+        xf_ctask_config_t cconfig = {.stack_size = stack_list[i]};
+        bench_tasks(&bench, "ctask", XF_TASK_TYPE_CTASK, &cconfig, stack_list[i]);
+    }
+#else
+    fprintf(stderr, "heap statistics are not supported on this platform\n");
+#endif // BENCH_HEAP_USED
+
+    bench_end(&bench);
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file bench_pool.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 任务池取出与回收工作任务的速率。
+ * @version 0.1
+ * @date 2024-09-14
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#include "bench.h"
+
+#define ACQUIRES 200000
+#define STACK_SIZE (1024 * 16)
+
+static void nwork(xf_task_t task)
+{
+    // 周期为 0 的 ntask 不会按次数结束，执行完主动删除，在空闲时回收到任务池
+    xf_task_delete(task);
+}
+
+static void cwork(xf_task_t task)
+{
+    // ctask 返回后自动删除
+}
+
+static void bench_pool_run(bench_t *bench, const char *name, xf_task_manager_t manager, xf_task_pool_t pool,
+                           xf_task_func_t func, uint32_t works)
+{
+    uint32_t acquires = 0;
+    uint32_t used = 0;
+
+    // 每轮取出全部工作任务并触发，调度到它们全部回收到任务池
+    uint64_t start = bench_now_ns();
+    while (acquires < ACQUIRES) {
+        for (uint32_t i = 0; i < works; i++) {
+            xf_task_trigger(xf_task_init_from_pool(pool, func, NULL, 0));
+        }
+        acquires += works;
+        do {
+            xf_task_manager_run(manager);
+            xf_task_pool_get_works(pool, NULL, &used);
+        } while (used != 0);
+    }
+    uint64_t ns = bench_now_ns() - start;
+
+    bench_row_begin(bench, name, "works", works);
+    bench_row_rate(bench, acquires, ns);
+    bench_row_end(bench);
+
+    xf_task_pool_delete(pool);
+    xf_task_manager_run(manager);
+    xf_task_manager_delete(manager);
+}
+
+int main(int argc, char *argv[])
+{
+    static const uint32_t works_list[] = {1, 8, 64};
+    bench_t bench;
+
+    bench_begin(&bench, "pool", argc, argv);
+
+    for (uint32_t i = 0; i < sizeof(works_list) / sizeof(works_list[0]); i++) {
+        xf_task_manager_t manager = xf_task_manager_create(NULL);
+        xf_task_pool_t pool = xf_ntask_pool_create_with_manager(works_list[i], manager, 0, 1);
+        bench_pool_run(&bench, "ntask", manager, pool, nwork, works_list[i]);
+    }
+
+    for (uint32_t i = 0; i < sizeof(works_list) / sizeof(works_list[0]); i++) {
+        xf_task_manager_t manager = xf_task_manager_create(NULL);
+        xf_task_pool_t pool = xf_ctask_pool_create_with_manager(works_list[i], manager, STACK_SIZE);
+        bench_pool_run(&bench, "ctask", manager, pool, cwork, works_list[i]);
+    }
+
+    bench_end(&bench);
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file bench_queue.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 队列吞吐量与元素大小的关系。
+ * @version 0.1
+ * @date 2024-09-14
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#include "bench.h"
+
+#define ITEMS 200000
+#define DEPTH 64
+#define ITEM_SIZE_MAX 1024
+#define STACK_SIZE (1024 * 16)
+
+static xf_task_manager_t s_manager = NULL;
+static xf_ctask_queue_t s_queue = NULL;
+static uint32_t s_received = 0;
+
+static void send_task(xf_task_t task)
+{
+    static uint8_t item[ITEM_SIZE_MAX];
+    while (1) {
+        xf_ctask_queue_send(s_queue, item, 1000);
+    }
+}
+
+static void receive_task(xf_task_t task)
+{
+    static uint8_t item[ITEM_SIZE_MAX];
+    while (1) {
+        if (xf_ctask_queue_receive(s_queue, item, 1000) == XF_OK) {
+            s_received++;
+        }
+    }
+}
+
+static void bench_task_queue(bench_t *bench, size_t size)
+{
+    static uint8_t data[ITEM_SIZE_MAX * DEPTH];
+    static uint8_t item[ITEM_SIZE_MAX];
+    xf_task_queue_t queue;
+    uint32_t items = 0;
+
+    xf_task_queue_init(&queue, data, size, DEPTH);
+    memset(item, 0x5a, size);
+
+    // 写满再读空，每个元素都经过一次发送与一次接收
+    uint64_t start = bench_now_ns();
+    while (items < ITEMS) {
+        for (uint32_t i = 0; i < DEPTH; i++) {
+            xf_task_queue_send(&queue, item, XF_TASK_QUEUE_SEND_TO_BACK);
+        }
+        for (uint32_t i = 0; i < DEPTH; i++) {
+            xf_task_queue_receive(&queue, item);
+        }
+        items += DEPTH;
+    }
+    uint64_t ns = bench_now_ns() - start;
+
+    bench_row_begin(bench, "task_queue", "item_size", size);
+    bench_row_rate(bench, items, ns);
+    bench_row_num(bench, "mb_per_sec", (double)items * size * 1e3 / (double)ns);
+    bench_row_end(bench);
+}
+
+static void bench_ctask_queue(bench_t *bench, size_t size)
+{
+    xf_task_t tasks[2];
+
+    s_manager = xf_task_manager_create(NULL);
+    s_queue = xf_ctask_queue_create_with_manager(s_manager, size, DEPTH);
+    tasks[0] = xf_ctask_create_with_manager(s_manager, send_task, NULL, 0, STACK_SIZE);
+    tasks[1] = xf_ctask_create_with_manager(s_manager, receive_task, NULL, 0, STACK_SIZE);
+
+    // 生产者写满队列后阻塞，消费者读空后阻塞，两者交替
+    s_received = 0;
+    uint64_t start = bench_now_ns();
+    while (s_received < ITEMS) {
+        xf_task_manager_run(s_manager);
+    }
+    uint64_t ns = bench_now_ns() - start;
+
+    bench_row_begin(bench, "ctask_queue", "item_size", size);
+    bench_row_rate(bench, s_received, ns);
+    bench_row_num(bench, "mb_per_sec", (double)s_received * size * 1e3 / (double)ns);
+    bench_row_end(bench);
+
+    bench_delete_tasks(s_manager, tasks, 2);
+    xf_ctask_queue_delete(s_queue);
+    xf_task_manager_delete(s_manager);
+}
+
+int main(int argc, char *argv[])
+{
+    static const size_t size_list[] = {4, 16, 64, 256, 1024};
+    bench_t bench;
+
+    bench_begin(&bench, "queue", argc, argv);
+
+    for (uint32_t i = 0; i < sizeof(size_list) / sizeof(size_list[0]); i++) {
+        bench_task_queue(&bench, size_list[i]);
+    }
+    for (uint32_t i = 0; i < sizeof(size_list) / sizeof(size_list[0]); i++) {
+        bench_ctask_queue(&bench, size_list[i]);
+    }
+
+    bench_end(&bench);
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file bench_trigger.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 从触发到任务开始执行的延迟。
+ * @version 0.1
+ * @date 2024-09-14
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#include "bench.h"
+
+#define SAMPLES 20000
+#define BLOCKED_MAX 256
+
+static uint64_t s_trigger_ns = 0;
+static uint64_t s_samples[SAMPLES];
+static uint32_t s_count = 0;
+
+static void event_task(xf_task_t task)
+{
+    s_samples[s_count++] = bench_now_ns() - s_trigger_ns;
+}
+
+static void blocked_task(xf_task_t task)
+{
+}
+
+int main(int argc, char *argv[])
+{
+    static const uint32_t blocked_list[] = {0, 16, 256};
+    static xf_task_t tasks[BLOCKED_MAX + 1];
+    bench_t bench;
+
+    bench_begin(&bench, "trigger", argc, argv);
+
+    for (uint32_t i = 0; i < sizeof(blocked_list) / sizeof(blocked_list[0]); i++) {
+        uint32_t blocked = blocked_list[i];
+        xf_task_manager_t manager = xf_task_manager_create(NULL);
+
+        for (uint32_t j = 0; j < blocked; j++) {
+            tasks[j] = xf_ntask_create_loop_with_manager(manager, blocked_task, NULL, 1, 3600 * 1000);
+        }
+        // 周期为 0 的 ntask 只由触发唤醒
+        tasks[blocked] = xf_ntask_create_loop_with_manager(manager, event_task, NULL, 0, 0);
+        xf_task_manager_run(manager);
+
+        s_count = 0;
+        uint64_t start = bench_now_ns();
+        while (s_count < SAMPLES) {
+            uint32_t count = s_count;
+            s_trigger_ns = bench_now_ns();
+            xf_task_trigger(tasks[blocked]);
+            while (s_count == count) {
+                xf_task_manager_run(manager);
+            }
+        }
+        uint64_t ns = bench_now_ns() - start;
+
+        bench_row_begin(&bench, "ntask", "blocked", blocked);
+        bench_row_rate(&bench, s_count, ns);
+        bench_row_percentile(&bench, s_samples, s_count);
+        bench_row_end(&bench);
+
+        bench_delete_tasks(manager, tasks, blocked + 1);
+        xf_task_manager_delete(manager);
+    }
+
+    bench_end(&bench);
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include "xf_task.h"
+#include "port.h"
+#include <assert.h>
+#include <stdio.h>
+
+#define START_TICK  ((xf_task_time_t)0xFFFFFF00)   // 256ms 后 32 位时间戳回绕
+#define RUN_TICKS   400
+
+static xf_task_time_t s_tick = START_TICK;
+static int s_ntask_runs = 0;
+static int s_ctask_runs = 0;
+static xf_task_time_t s_once_at = 0;
+static XF_NTASK_STORAGE_DEFINE(s_static_task);
+
+/**
+ * @brief 虚拟时钟，从回绕前 256ms 开始，只在空闲时推进
+ *
+ * @return xf_task_time_t 当前时间
+ */
+static xf_task_time_t fake_get_tick(void)
+{
+    return s_tick;
+}
+
+/**
+ * @brief 空闲回调，直接把虚拟时钟推进到下一个任务唤醒的时间
+ *
+ * @param max_idle_ms 最大空闲时间
+ */
+static void fake_idle(unsigned long int max_idle_ms)
+{
+    s_tick += max_idle_ms;
+}
+
+/**
+ * @brief 周期 ntask，记录执行次数
+ *
+ * @param task 任务对象
+ */
+static void task_ntask(xf_task_t task)
+{
+    s_ntask_runs++;
+}
+
+/**
+ * @brief 循环延时的 ctask，记录执行次数
+ *
+ * @param task 任务对象
+ */
+static void task_ctask(xf_task_t task)
+{
+    while (1)
+    {
+        xf_ctask_delay(20);
+        s_ctask_runs++;
+    }
+}
+
+/**
+ * @brief 只执行一次的 ntask，记录执行时间
+ *
+ * @param task 任务对象
+ */
+static void task_once(xf_task_t task)
+{
+    s_once_at = s_tick;
+}
+
+/**
+ * @brief 推进虚拟时钟并调度一段时间
+ *
+ * @param ticks 时间
+ */
+static void run_for(xf_task_time_t ticks)
+{
+    xf_task_time_t start = s_tick;
+    while (s_tick - start < ticks)
+    {
+        xf_task_manager_run_default();
+    }
+}
+
+int main()
+{
+    // 对接上下文
+    xf_task_context_init(create_context, swap_context);
+    // 对接虚拟时钟
+    xf_task_tick_init(fake_get_tick);
+    xf_task_manager_default_init(fake_idle);
+
+    // 紧凑布局下时间戳默认为 32 位
+    assert(sizeof(xf_task_time_t) == 4);
+
+    // 周期任务与延时在 32 位时间戳回绕前后保持周期不变
+    xf_ntask_create_loop(task_ntask, NULL, 1, 10);
+    xf_ctask_create(task_ctask, NULL, 1, 1024 * 32);
+    // 回绕前 6ms 创建、延时 50ms 的任务，跨过回绕后仍然在 50ms 后执行
+    run_for(250);
+    xf_task_time_t once_start = s_tick;
+    xf_ntask_create(task_once, NULL, 1, 50, 1);
+    run_for(RUN_TICKS - 250);
+    printf("ntask:%d ctask:%d once:%u\n", s_ntask_runs, s_ctask_runs, (unsigned)(s_once_at - once_start));
+    // 周期任务在 10ms ~ 390ms 执行 39 次， ctask 在 20ms ~ 380ms 执行 19 次
+    assert(s_ntask_runs == 39 && s_ctask_runs == 19);
+    assert(s_tick < START_TICK && s_once_at - once_start == 50);
+
+    // 删除函数按索引查表：任务池回收、future 结束以及静态任务都使用各自的删除函数
+    xf_ntask_config_t config = {.count = 1, .delay_ms = 5};
+    xf_task_pool_t pool = xf_task_pool_create_with_manager(2, xf_task_get_default_manager(), XF_TASK_TYPE_NTASK,
+                          &config);
+    assert(pool != NULL);
+    assert(xf_task_init_from_pool(pool, task_ntask, NULL, 1) != NULL);
+    assert(xf_task_init_from_pool(pool, task_ntask, NULL, 1) != NULL);
+    assert(xf_task_init_from_pool(pool, task_ntask, NULL, 1) == NULL);
+    xf_task_future_t future = xf_ntask_spawn_future(task_ntask, NULL, 1, 5, 3);
+    assert(future != NULL);
+    xf_task_t static_task = xf_ntask_create_static(task_ntask, NULL, 1, 5, 2, &s_static_task);
+    assert(static_task != NULL);
+    s_ntask_runs = 0;
+    run_for(30);
+
+    uint32_t total = 0;
+    uint32_t used = 0;
+    xf_task_pool_get_works(pool, &total, &used);
+    printf("runs:%d pool used:%u future:%d\n", s_ntask_runs, (unsigned)used, xf_task_future_get(future, NULL));
+    // 周期任务 3 次，任务池 2 个各 1 次， future 任务 3 次，静态任务 2 次
+    assert(s_ntask_runs == 3 + 2 + 3 + 2);
+    assert(used == 0 && xf_task_future_get(future, NULL) == XF_OK);
+    assert(xf_task_future_delete(future) == XF_OK);
+    assert(xf_task_pool_delete(pool) == XF_OK);
+    run_for(10);
+
+    printf("compact ok\n");
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include "xf_task.h"
+#include "port.h"
+#include <assert.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#define JOB_STEP_NUM 5
+
+static char order[8];
+static int order_num = 0;
+static int job_num = 0;
+
+/**
+ * @brief 事件任务，记录自己的执行顺序
+ *
+ * @param task 任务对象
+ */
+static void task_record(xf_task_t task)
+{
+    char name = (char)(uintptr_t)xf_task_get_arg(task);
+    printf("run:%c\n", name);
+    order[order_num++] = name;
+}
+
+/**
+ * @brief 周期任务，每次执行都超过申报的最坏执行时间
+ *
+ * @param task 任务对象
+ */
+static void task_overrun(xf_task_t task)
+{
+    usleep(30 * 1000); // 模拟函数运行消耗 30ms 时间，超过申报的 10ms
+}
+
+/**
+ * @brief 周期 ctask，每个作业分 5 步执行，步与步之间让出 CPU
+ *
+ * @param task 任务对象
+ */
+static void task_job(xf_task_t task)
+{
+    while (1)
+    {
+        for (int i = 0; i < JOB_STEP_NUM; i++)
+        {
+            usleep(6 * 1000); // 模拟每一步消耗 6ms 时间
+            // 作业中途让出 CPU，截止时间不会因此后移
+            xf_ctask_delay(0);
+        }
+        job_num++;
+        // 作业结束，下一次唤醒视为新作业释放
+        xf_task_deadline_job_done(task);
+        xf_ctask_delay(100);
+    }
+}
+
+/**
+ * @brief 运行默认任务管理器一段时间
+ *
+ * @param ms 运行时间，单位为 ms
+ */
+static void run_for(xf_task_time_t ms)
+{
+    xf_task_time_t start = task_get_tick();
+    while (task_get_tick() - start < ms)
+    {
+        xf_task_manager_run_default();
+    }
+}
+
+int main()
+{
+    // 对接上下文
+    xf_task_context_init(create_context, swap_context);
+    // 对接时间戳
+    xf_task_tick_init(task_get_tick);
+    // 初始化默认任务管理器，例程按时间运行，空闲时直接返回继续轮询
+    xf_task_manager_default_init(NULL);
+    xf_task_manager_t manager = xf_task_get_default_manager();
+
+    // 三个同优先级的事件任务，A 和 B 设置截止时间，C 只按优先级调度
+    xf_task_t task_a = xf_ntask_create(task_record, (void *)'A', 1, 0, 1);
+    xf_task_t task_b = xf_ntask_create(task_record, (void *)'B', 1, 0, 1);
+    xf_task_t task_c = xf_ntask_create(task_record, (void *)'C', 1, 0, 1);
+    // A 最坏执行 5ms ，相对截止时间 50ms ； B 最坏执行 1ms ，截止时间等于周期 10ms
+    assert(xf_task_set_deadline(task_a, 5, 100, 50) == XF_OK);
+    assert(xf_task_set_deadline(task_b, 1, 10, 0) == XF_OK);
+    // 利用率为 5/50 + 1/10 = 200‰ ，再加入 9/10 会超过上限，准入失败
+    assert(xf_task_manager_get_utilization(manager) == 200);
+    assert(xf_task_set_deadline(task_c, 9, 10, 0) == XF_FAIL);
+
+    // 按 C、A、B 的顺序触发，截止时间任务先于普通任务，截止时间早的先执行
+    xf_task_trigger(task_c);
+    xf_task_trigger(task_a);
+    xf_task_trigger(task_b);
+    run_for(20);
+    printf("order:%.3s\n", order);
+    assert(order_num == 3 && order[0] == 'B' && order[1] == 'A' && order[2] == 'C');
+
+    // 周期 40ms 、截止时间 20ms 的任务每次执行 30ms ，每个周期都会错过截止时间
+    xf_task_t task_d = xf_ntask_create_loop(task_overrun, NULL, 1, 40);
+    assert(xf_task_set_deadline(task_d, 10, 40, 20) == XF_OK);
+    run_for(200);
+    printf("miss:%u total:%u\n", xf_task_get_deadline_miss(task_d), xf_task_manager_get_deadline_miss(manager));
+    assert(xf_task_get_deadline_miss(task_d) >= 2);
+    assert(xf_task_get_deadline_miss(task_a) == 0 && xf_task_get_deadline_miss(task_b) == 0);
+
+    // 删除任务后释放其利用率
+    xf_task_delete(task_d);
+    run_for(10);
+    assert(xf_task_manager_get_utilization(manager) == 200);
+
+    // 截止时间 20ms 的作业一共执行 30ms ，中途多次让出 CPU ，每个作业只记一次错过
+    xf_task_t task_e = xf_ctask_create(task_job, NULL, 1, 1024 * 32);
+    assert(xf_task_set_deadline(task_e, 10, 100, 20) == XF_OK);
+    xf_task_time_t start = task_get_tick();
+    while (job_num < 2 && task_get_tick() - start < 1000)
+    {
+        xf_task_manager_run_default();
+    }
+    printf("job:%d miss:%u\n", job_num, xf_task_get_deadline_miss(task_e));
+    assert(job_num == 2 && xf_task_get_deadline_miss(task_e) == 2);
+
+    printf("deadline ok\n");
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "xf_task.h"
+#include "port.h"
+#include <assert.h>
+#include <stdio.h>
+
+static uint32_t run_count[2];
+static uint32_t check_count = 0;
+
+/**
+ * @brief 忙碌的事件任务，每次执行 2ms 后重新触发自己
+ *
+ * @param task 任务对象
+ */
+static void task_busy(xf_task_t task)
+{
+    uintptr_t num = (uintptr_t)xf_task_get_arg(task);
+    xf_task_time_t start = task_get_tick();
+    run_count[num]++;
+    while (task_get_tick() - start < 2); // 模拟函数运行消耗 2ms 时间
+    xf_task_trigger(task);
+}
+
+/**
+ * @brief 普通优先级的周期任务，不受公平调度任务影响
+ *
+ * @param task 任务对象
+ */
+static void task_check(xf_task_t task)
+{
+    check_count++;
+}
+
+/**
+ * @brief 运行默认任务管理器一段时间
+ *
+ * @param ms 运行时间，单位为 ms
+ */
+static void run_for(xf_task_time_t ms)
+{
+    xf_task_time_t start = task_get_tick();
+    while (task_get_tick() - start < ms)
+    {
+        xf_task_manager_run_default();
+    }
+}
+
+int main()
+{
+    // 对接时间戳
+    xf_task_tick_init(task_get_tick);
+    // 初始化默认任务管理器，例程按时间运行，空闲时直接返回继续轮询
+    xf_task_manager_default_init(NULL);
+
+    // 两个一直忙碌的任务，权重为 1:3
+    xf_task_t task0 = xf_ntask_create(task_busy, (void *)0, 0, 0, XF_NTASK_INFINITE_LOOP);
+    xf_task_t task1 = xf_ntask_create(task_busy, (void *)1, 0, 0, XF_NTASK_INFINITE_LOOP);
+    assert(xf_task_set_weight(task0, XF_TASK_FAIR_WEIGHT_BASE) == XF_OK);
+    assert(xf_task_set_weight(task1, XF_TASK_FAIR_WEIGHT_BASE * 3) == XF_OK);
+    // 每 10ms 执行一次的普通任务，公平调度任务处于所有优先级之下，不会挤占它
+    xf_ntask_create_loop(task_check, NULL, 10, 10);
+
+    xf_task_trigger(task0);
+    xf_task_trigger(task1);
+    run_for(800);
+
+    // 两个任务的执行次数之比接近权重之比
+    printf("task0:%u task1:%u check:%u\n", run_count[0], run_count[1], check_count);
+    assert(run_count[0] > 0);
+    assert(run_count[1] * 10 > run_count[0] * 25 && run_count[1] * 10 < run_count[0] * 35);
+    assert(check_count >= 60);
+
+    printf("fair ok\n");
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include "xf_task.h"
+#include "port.h"
+#include <assert.h>
+#include <stdio.h>
+
+static xf_task_future_t s_all = NULL;
+static xf_task_future_t s_any = NULL;
+static int s_then_count = 0;
+static int s_ctask_result = -1;
+static int s_ntask_result = -1;
+
+/**
+ * @brief 模拟耗时的请求，完成时通过 future 返回结果
+ *
+ * @param task 任务对象
+ */
+static void task_request(xf_task_t task)
+{
+    uintptr_t ms = (uintptr_t)xf_task_get_arg(task);
+    xf_ctask_delay(ms);
+    printf("request:%lu done\n", ms);
+    xf_task_future_resolve(xf_task_future_of(task), XF_OK, (void *)(ms * 10));
+}
+
+/**
+ * @brief 执行 3 次后结束的 ntask，结束时 future 自动完成
+ *
+ * @param task 任务对象
+ */
+static void task_count(xf_task_t task)
+{
+    printf("count:%u\n", xf_ntask_get_count(task));
+}
+
+/**
+ * @brief future 完成时执行的续体
+ *
+ * @param future 完成的 future
+ * @param arg 注册续体时传入的参数
+ */
+static void on_done(xf_task_future_t future, void *arg)
+{
+    s_then_count++;
+}
+
+/**
+ * @brief ctask 阻塞等待所有请求完成
+ *
+ * @param task 任务对象
+ */
+static void task_wait_all(xf_task_t task)
+{
+    s_ctask_result = xf_task_future_wait(s_all, 1000, NULL);
+    printf("all done:%d\n", s_ctask_result);
+}
+
+/**
+ * @brief ntask 等待任意一个请求完成
+ *
+ * @param task 任务对象
+ */
+static void task_wait_any(xf_task_t task)
+{
+    XF_NTASK_BEGIN(task);
+    XF_NTASK_FUTURE_WAIT(s_any);
+    s_ntask_result = xf_task_future_get(s_any, NULL);
+    printf("any done:%d\n", s_ntask_result);
+    XF_NTASK_END();
+}
+
+/**
+ * @brief 运行默认任务管理器一段时间
+ *
+ * @param ms 运行时间，单位为 ms
+ */
+static void run_for(xf_task_time_t ms)
+{
+    xf_task_time_t start = task_get_tick();
+    while (task_get_tick() - start < ms)
+    {
+        xf_task_manager_run_default();
+    }
+}
+
+int main()
+{
+    // 对接上下文
+    xf_task_context_init(create_context, swap_context);
+    // 对接时间戳
+    xf_task_tick_init(task_get_tick);
+    // 初始化默认任务管理器，例程按时间运行，空闲时直接返回继续轮询
+    xf_task_manager_default_init(NULL);
+
+    // 两个耗时不同的请求和一个执行 3 次的 ntask，各自对应一个 future
+    xf_task_future_t futures[3];
+    futures[0] = xf_ctask_spawn_future(task_request, (void *)30, 1, 1024 * 32);
+    futures[1] = xf_ctask_spawn_future(task_request, (void *)10, 1, 1024 * 32);
+    futures[2] = xf_ntask_spawn_future(task_count, NULL, 1, 5, 3);
+    for (int i = 0; i < 3; i++)
+    {
+        assert(futures[i] != NULL);
+        xf_task_future_then(futures[i], on_done, NULL);
+    }
+
+    // 组合 future，分别由 ctask 阻塞等待和 ntask 触发等待
+    s_all = xf_task_future_when_all(futures, 3);
+    s_any = xf_task_future_when_any(futures, 3);
+    xf_ctask_create(task_wait_all, NULL, 0, 1024 * 32);
+    xf_task_trigger(xf_ntask_create(task_wait_any, NULL, 0, 0, 1));
+
+    run_for(80);
+
+    // 所有 future 都已完成，续体各执行一次
+    void *value = NULL;
+    assert(s_then_count == 3);
+    assert(xf_task_future_is_done(s_all) && s_ctask_result == XF_OK);
+    assert(xf_task_future_get(futures[0], &value) == XF_OK && (uintptr_t)value == 300);
+    // 最先完成的是 10ms 的请求
+    assert(xf_task_future_get(s_any, &value) == XF_OK && value == futures[1] && s_ntask_result == XF_OK);
+
+    xf_task_future_delete(s_all);
+    xf_task_future_delete(s_any);
+    for (int i = 0; i < 3; i++)
+    {
+        xf_task_future_delete(futures[i]);
+    }
+    run_for(10);
+
+    printf("future ok\n");
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "xf_task.h"
+#include "port.h"
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#define FRAME_NUM 3
+
+static char s_order[32];
+static int s_order_num = 0;
+static int s_frame = 0;
+
+/**
+ * @brief 节点任务，记录自己的执行顺序
+ *
+ * @param task 任务对象
+ */
+static void task_node(xf_task_t task)
+{
+    s_order[s_order_num++] = (char)(uintptr_t)xf_task_get_arg(task);
+}
+
+/**
+ * @brief 任务依赖图执行完成回调，记录一帧结束并启动下一帧
+ *
+ * @param graph 任务依赖图
+ * @param arg 用户参数
+ */
+static void on_done(xf_task_graph_t graph, void *arg)
+{
+    s_order[s_order_num++] = '|';
+    if (++s_frame < FRAME_NUM)
+    {
+        xf_task_graph_launch(graph);
+    }
+}
+
+/**
+ * @brief 运行默认任务管理器一段时间
+ *
+ * @param ms 运行时间，单位为 ms
+ */
+static void run_for(xf_task_time_t ms)
+{
+    xf_task_time_t start = task_get_tick();
+    while (task_get_tick() - start < ms)
+    {
+        xf_task_manager_run_default();
+    }
+}
+
+int main()
+{
+    // 对接时间戳
+    xf_task_tick_init(task_get_tick);
+    // 初始化默认任务管理器，例程按时间运行，空闲时直接返回继续轮询
+    xf_task_manager_default_init(NULL);
+
+    /**
+     *      ┌──> B ─────────┐
+     *  A ──┤               ├──> D
+     *      └──> C ──> E ───┘
+     *
+     * E 的耗时为 5 ，A -> C -> E -> D 是关键路径
+     */
+    xf_task_graph_t graph = xf_task_graph_create(8, 8, 1);
+    assert(graph != NULL);
+    xf_ntask_config_t config = {0};
+    uint32_t a, b, c, d, e;
+    assert(xf_task_graph_add_node(graph, XF_TASK_TYPE_NTASK, task_node, (void *)'A', &config, &a) == XF_OK);
+    assert(xf_task_graph_add_node(graph, XF_TASK_TYPE_NTASK, task_node, (void *)'B', &config, &b) == XF_OK);
+    assert(xf_task_graph_add_node(graph, XF_TASK_TYPE_NTASK, task_node, (void *)'C', &config, &c) == XF_OK);
+    assert(xf_task_graph_add_node(graph, XF_TASK_TYPE_NTASK, task_node, (void *)'D', &config, &d) == XF_OK);
+    assert(xf_task_graph_add_node(graph, XF_TASK_TYPE_NTASK, task_node, (void *)'E', &config, &e) == XF_OK);
+    xf_task_graph_add_edge(graph, a, b);
+    xf_task_graph_add_edge(graph, a, c);
+    xf_task_graph_add_edge(graph, c, e);
+    xf_task_graph_add_edge(graph, b, d);
+    xf_task_graph_add_edge(graph, e, d);
+    xf_task_graph_set_cost(graph, e, 5);
+    xf_task_graph_set_done_cb(graph, on_done, NULL);
+
+    // 启动后在执行完之前不能再次启动
+    assert(xf_task_graph_launch(graph) == XF_OK);
+    assert(xf_task_graph_launch(graph) == XF_ERR_BUSY);
+    run_for(20);
+
+    // 每一帧都按依赖执行，关键路径上的 C 先于 B 执行
+    s_order[s_order_num] = '\0';
+    printf("order:%s\n", s_order);
+    assert(s_frame == FRAME_NUM && !xf_task_graph_is_running(graph));
+    for (int i = 0; i < FRAME_NUM; i++)
+    {
+        const char *frame = &s_order[i * 6];
+        assert(frame[0] == 'A' && frame[1] == 'C' && frame[4] == 'D' && frame[5] == '|');
+        assert(strchr(frame, 'B') < frame + 4 && strchr(frame, 'E') < frame + 4);
+    }
+
+    // 存在环时拒绝启动
+    xf_task_graph_add_edge(graph, d, a);
+    assert(xf_task_graph_launch(graph) == XF_ERR_INVALID_STATE);
+
+    assert(xf_task_graph_delete(graph) == XF_OK);
+    run_for(10);
+
+    printf("graph ok\n");
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "xf_task.h"
+#include "port.h"
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+
+// 随便定义一个 topic id
+#define TOPIC_ID    1
+#define PUB_NUM     100
+
+static xf_task_manager_t s_worker_manager = NULL;
+static xf_task_mbus_t s_worker_bus = NULL;
+static int s_received = 0;
+static int s_sum = 0;
+
+/**
+ * @brief 工作线程总线上的订阅回调，运行在工作线程中
+ *
+ * @param data 用户发布的消息
+ * @param user_data 创建订阅时候的用户自定义参数
+ */
+static void worker_cb(const void *const data, void *user_data)
+{
+    s_received++;
+    s_sum += *(const int *)data;
+}
+
+/**
+ * @brief 工作线程的总线处理任务
+ *
+ * @param task 任务对象
+ */
+static void task_worker_handle(xf_task_t task)
+{
+    xf_task_mbus_handle_with_bus(s_worker_bus);
+}
+
+/**
+ * @brief 工作线程，运行自己的任务管理器，直到收齐消息或超时
+ *
+ * @param arg 线程参数
+ */
+static void *worker_thread(void *arg)
+{
+    xf_task_time_t start = task_get_tick();
+    while (s_received < PUB_NUM && task_get_tick() - start < 1000)
+    {
+        xf_task_manager_run(s_worker_manager);
+    }
+    return NULL;
+}
+
+int main()
+{
+    // 对接时间戳
+    xf_task_tick_init(task_get_tick);
+    // 主线程使用默认任务管理器与默认总线
+    xf_task_manager_default_init(NULL);
+    xf_task_mbus_reg_topic(TOPIC_ID, sizeof(int));
+
+    // 工作线程使用自己的任务管理器与总线，总线只在所属管理器的线程中使用
+    s_worker_manager = xf_task_manager_create(NULL);
+    s_worker_bus = xf_task_mbus_create_with_manager(s_worker_manager);
+    assert(s_worker_bus != NULL && xf_task_mbus_get_manager(s_worker_bus) == s_worker_manager);
+    xf_task_mbus_reg_topic_with_bus(s_worker_bus, TOPIC_ID, sizeof(int));
+    xf_task_mbus_sub_with_bus(s_worker_bus, TOPIC_ID, worker_cb, NULL);
+    xf_task_t handle = xf_ntask_create_loop_with_manager(s_worker_manager, task_worker_handle, NULL, 0, 1);
+
+    // 桥接需要在两个总线运行前建立，之后默认总线上发布的消息经无锁队列送到工作线程的总线
+    assert(xf_task_mbus_bridge(xf_task_mbus_get_default(), s_worker_bus, TOPIC_ID, PUB_NUM) == XF_OK);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, worker_thread, NULL);
+    int expect_sum = 0;
+    for (int i = 0; i < PUB_NUM; i++)
+    {
+        xf_task_mbus_pub_sync(TOPIC_ID, &i);
+        expect_sum += i;
+    }
+    pthread_join(thread, NULL);
+
+    // 队列深度足够时没有丢弃，所有消息按顺序到达
+    printf("received:%d sum:%d dropped:%u\n", s_received, s_sum,
+           xf_task_mbus_bridge_get_dropped(xf_task_mbus_get_default(), s_worker_bus, TOPIC_ID));
+    assert(s_received == PUB_NUM && s_sum == expect_sum);
+    assert(xf_task_mbus_bridge_get_dropped(xf_task_mbus_get_default(), s_worker_bus, TOPIC_ID) == 0);
+
+    // 两个总线都停止后才能解除桥接
+    assert(xf_task_mbus_unbridge(xf_task_mbus_get_default(), s_worker_bus, TOPIC_ID) == XF_OK);
+    assert(xf_task_mbus_delete(s_worker_bus) == XF_OK);
+    // 删除任务，在空闲时回收后再删除任务管理器
+    xf_task_delete(handle);
+    xf_task_manager_run(s_worker_manager);
+    xf_task_manager_delete(s_worker_manager);
+
+    printf("mbus_bridge ok\n");
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "xf_task.h"
+#include "port.h"
+#include <assert.h>
+#include <stdio.h>
+
+// 传感器 topic 按层级编号：0x12xx 为温度，0x13xx 为湿度
+#define TOPIC_TEMP_0    0x1200
+#define TOPIC_TEMP_1    0x1201
+#define TOPIC_HUMI_0    0x1300
+#define TOPIC_TEMP_2    0x1202
+
+static int s_range_count = 0;
+static int s_temp_count = 0;
+static uint32_t s_temp_last = 0;
+
+/**
+ * @brief 范围订阅回调，收到 [0x1200, 0x13FF] 内所有 topic 的消息
+ *
+ * @param data 用户发布的消息
+ * @param user_data 创建订阅时候的用户自定义参数
+ */
+static void range_cb(const void *const data, void *user_data)
+{
+    s_range_count++;
+}
+
+/**
+ * @brief 掩码订阅回调，只收到 0x12xx 温度 topic 的消息
+ *
+ * @param data 用户发布的消息
+ * @param user_data 创建订阅时候的用户自定义参数
+ */
+static void temp_cb(const void *const data, void *user_data)
+{
+    uint32_t topic_id = 0;
+    // 模式订阅的回调通过当前分发的 topic id 区分消息来源
+    xf_task_mbus_get_current_topic(&topic_id);
+    printf("temp topic:0x%x data:%d\n", (unsigned)topic_id, *(const int *)data);
+    s_temp_count++;
+    s_temp_last = topic_id;
+}
+
+int main()
+{
+    // 对接时间戳
+    xf_task_tick_init(task_get_tick);
+    // 初始化默认任务管理器
+    xf_task_manager_default_init(NULL);
+
+    xf_task_mbus_reg_topic(TOPIC_TEMP_0, sizeof(int));
+    xf_task_mbus_reg_topic(TOPIC_TEMP_1, sizeof(int));
+    xf_task_mbus_reg_topic(TOPIC_HUMI_0, sizeof(int));
+
+    // 范围订阅与层级（前缀）订阅
+    assert(xf_task_mbus_sub_range(0x1200, 0x13FF, range_cb, NULL) == XF_OK);
+    assert(xf_task_mbus_sub_mask(0x1200, 0xFFFFFF00, temp_cb, NULL) == XF_OK);
+    assert(xf_task_mbus_sub_mask(0x1200, 0xFFFFFF00, temp_cb, NULL) == XF_ERR_INITED);
+
+    // 之后注册的 topic 落在模式内同样生效
+    xf_task_mbus_reg_topic(TOPIC_TEMP_2, sizeof(int));
+
+    int data = 25;
+    xf_task_mbus_pub_sync(TOPIC_TEMP_0, &data);
+    xf_task_mbus_pub_sync(TOPIC_TEMP_1, &data);
+    xf_task_mbus_pub_sync(TOPIC_HUMI_0, &data);
+    data = 26;
+    xf_task_mbus_pub_sync(TOPIC_TEMP_2, &data);
+    printf("range:%d temp:%d\n", s_range_count, s_temp_count);
+    assert(s_range_count == 4 && s_temp_count == 3 && s_temp_last == TOPIC_TEMP_2);
+
+    // 解除订阅后不再收到消息
+    assert(xf_task_mbus_unsub_mask(0x1200, 0xFFFFFF00, temp_cb) == XF_OK);
+    assert(xf_task_mbus_unsub_range(0x1200, 0x13FF, range_cb) == XF_OK);
+    xf_task_mbus_pub_sync(TOPIC_TEMP_0, &data);
+    assert(s_range_count == 4 && s_temp_count == 3);
+
+    printf("mbus_pattern ok\n");
+    return 0;
+}
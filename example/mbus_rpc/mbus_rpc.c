@@ -0,0 +1,133 @@
+#include "xf_task.h"
+#include "port.h"
+#include <assert.h>
+#include <stdio.h>
+
+// 随便定义两个 topic id
+#define TOPIC_SERVICE   1
+#define TOPIC_NONE      2
+
+static xf_task_mbus_reply_t s_deferred;
+static int s_deferred_req = 0;
+static bool s_has_deferred = false;
+
+static xf_task_mbus_call_t s_call;
+static int s_resp = 0;
+static bool s_done = false;
+
+/**
+ * @brief 服务回调：小于 100 的请求直接应答，大于等于 100 的稍后由其他任务应答，负数不应答
+ *
+ * @param req 请求数据
+ * @param reply 应答句柄
+ * @param user_data 用户的数据
+ */
+static void service_cb(const void *const req, const xf_task_mbus_reply_t *reply, void *user_data)
+{
+    int num = *(const int *)req;
+    if (num >= 100)
+    {
+        // 保存应答句柄，之后再应答
+        s_deferred = *reply;
+        s_deferred_req = num;
+        s_has_deferred = true;
+        return;
+    }
+    if (num < 0)
+    {
+        return;
+    }
+    int resp = num * 2;
+    xf_task_mbus_reply(reply, &resp);
+}
+
+/**
+ * @brief 周期处理延后的请求
+ *
+ * @param task 任务对象
+ */
+static void task_replier(xf_task_t task)
+{
+    if (s_has_deferred)
+    {
+        s_has_deferred = false;
+        int resp = s_deferred_req + 1;
+        xf_task_mbus_reply(&s_deferred, &resp);
+    }
+}
+
+static void task_mbus_handle(xf_task_t task)
+{
+    xf_task_mbus_handle();
+}
+
+/**
+ * @brief 无栈协程中依次发起请求
+ *
+ * @param task 任务对象
+ */
+static void task_caller(xf_task_t task)
+{
+    // 请求数据在等待期间需要保持有效，局部变量也不会在协程让出后保留，都放在静态变量中
+    static int req = 0;
+    static xf_err_t err = XF_OK;
+
+    XF_NTASK_BEGIN(task);
+
+    // 服务在回调中直接应答
+    req = 21;
+    xf_ntask_mbus_call(&s_call, TOPIC_SERVICE, &req, &s_resp, 100);
+    err = xf_task_mbus_call_get_err(&s_call);
+    printf("call:%d err:%d resp:%d\n", req, err, s_resp);
+    assert(err == XF_OK && s_resp == 42);
+
+    // 服务稍后由其他任务应答，应答按关联 id 直接唤醒本任务
+    req = 200;
+    xf_ntask_mbus_call(&s_call, TOPIC_SERVICE, &req, &s_resp, 100);
+    err = xf_task_mbus_call_get_err(&s_call);
+    printf("call:%d err:%d resp:%d\n", req, err, s_resp);
+    assert(err == XF_OK && s_resp == 201);
+
+    // 服务不应答，超时后返回
+    req = -1;
+    xf_ntask_mbus_call(&s_call, TOPIC_SERVICE, &req, &s_resp, 30);
+    err = xf_task_mbus_call_get_err(&s_call);
+    printf("call:%d err:%d\n", req, err);
+    assert(err == XF_ERR_TIMEOUT);
+
+    s_done = true;
+
+    XF_NTASK_END();
+}
+
+int main()
+{
+    // 对接时间戳
+    xf_task_tick_init(task_get_tick);
+    // 初始化默认任务管理器，例程按时间运行，空闲时直接返回继续轮询
+    xf_task_manager_default_init(NULL);
+
+    // 注册 topic 并在上面提供服务，每个 topic 只能有一个服务
+    xf_task_mbus_reg_topic(TOPIC_SERVICE, sizeof(int));
+    assert(xf_task_mbus_serve(TOPIC_SERVICE, sizeof(int), service_cb, NULL) == XF_OK);
+    assert(xf_task_mbus_serve(TOPIC_SERVICE, sizeof(int), service_cb, NULL) == XF_ERR_INITED);
+    // 没有服务的 topic 请求直接失败
+    xf_task_mbus_reg_topic(TOPIC_NONE, sizeof(int));
+    int req = 1;
+    assert(xf_task_mbus_call_start_with_bus(xf_task_mbus_get_default(), &s_call, NULL, TOPIC_NONE, &req, &s_resp,
+                                            10) == XF_ERR_NOT_FOUND);
+
+    xf_task_trigger(xf_ntask_create(task_caller, NULL, 1, 0, 1));
+    xf_ntask_create_loop(task_replier, NULL, 2, 5);
+    xf_ntask_create_loop(task_mbus_handle, NULL, 0, 5);
+
+    xf_task_time_t start = task_get_tick();
+    while (!s_done && task_get_tick() - start < 1000)
+    {
+        xf_task_manager_run_default();
+    }
+    assert(s_done);
+
+    printf("mbus_rpc ok\n");
+    return 0;
+}
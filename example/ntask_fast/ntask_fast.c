@@ -0,0 +1,163 @@
+#include "xf_task.h"
+#include <assert.h>
+#include <stdio.h>
+
+#define EVENT_NUM   64
+#define RUN_MAX     16
+
+static xf_task_time_t s_tick = 0;
+static int s_event_runs[EVENT_NUM];
+static uintptr_t s_order[8];
+static int s_order_num = 0;
+static xf_task_time_t s_periodic[RUN_MAX];
+static int s_periodic_num = 0;
+static xf_task_time_t s_changed[RUN_MAX];
+static int s_changed_num = 0;
+static int s_count_runs = 0;
+
+/**
+ * @brief 虚拟时钟，只在空闲时推进，保证每次运行的结果一致
+ *
+ * @return xf_task_time_t 当前时间
+ */
+static xf_task_time_t fake_get_tick(void)
+{
+    return s_tick;
+}
+
+/**
+ * @brief 空闲回调，直接把虚拟时钟推进到下一个任务唤醒的时间
+ *
+ * @param max_idle_ms 最大空闲时间
+ */
+static void fake_idle(unsigned long int max_idle_ms)
+{
+    s_tick += max_idle_ms;
+}
+
+/**
+ * @brief 事件任务，记录执行次数和顺序
+ *
+ * @param task 任务对象
+ */
+static void task_event(xf_task_t task)
+{
+    uintptr_t index = (uintptr_t)xf_task_get_arg(task);
+    s_event_runs[index]++;
+    if (s_order_num < (int)(sizeof(s_order) / sizeof(s_order[0])))
+    {
+        s_order[s_order_num++] = index;
+    }
+}
+
+/**
+ * @brief 周期任务，记录执行时间
+ *
+ * @param task 任务对象
+ */
+static void task_periodic(xf_task_t task)
+{
+    if (s_periodic_num < RUN_MAX)
+    {
+        s_periodic[s_periodic_num++] = s_tick;
+    }
+}
+
+/**
+ * @brief 创建时只靠事件触发，之后改为周期任务，记录执行时间
+ *
+ * @param task 任务对象
+ */
+static void task_changed(xf_task_t task)
+{
+    if (s_changed_num < RUN_MAX)
+    {
+        s_changed[s_changed_num++] = s_tick;
+    }
+}
+
+/**
+ * @brief 限定次数的周期任务
+ *
+ * @param task 任务对象
+ */
+static void task_count(xf_task_t task)
+{
+    s_count_runs++;
+}
+
+/**
+ * @brief 推进虚拟时钟并调度到指定时间
+ *
+ * @param ticks 时间
+ */
+static void run_until(xf_task_time_t ticks)
+{
+    while (s_tick < ticks)
+    {
+        xf_task_manager_run_default();
+    }
+}
+
+int main()
+{
+    // 对接虚拟时钟
+    xf_task_tick_init(fake_get_tick);
+    xf_task_manager_default_init(fake_idle);
+    xf_task_manager_t manager = xf_task_get_default_manager();
+
+    // 64 个只靠事件触发的任务，一个周期 10ms 的任务，一个周期 5ms 执行 3 次的任务，
+    // 以及一个先只靠事件触发、之后改为周期任务的任务
+    xf_task_t events[EVENT_NUM];
+    for (uintptr_t i = 0; i < EVENT_NUM; i++)
+    {
+        events[i] = xf_ntask_create(task_event, (void *)i, 2, 0, 1);
+    }
+    xf_ntask_create_loop(task_periodic, NULL, 1, 10);
+    xf_ntask_create(task_count, NULL, 1, 5, 3);
+    xf_task_t changed = xf_ntask_create(task_changed, NULL, 2, 0, XF_NTASK_INFINITE_LOOP);
+    run_until(100);
+    printf("periodic:%d count:%d\n", s_periodic_num, s_count_runs);
+    assert(s_periodic_num == 9 && s_count_runs == 3);
+    for (int i = 0; i < s_periodic_num; i++)
+    {
+        assert(s_periodic[i] == (xf_task_time_t)(i + 1) * 10);
+    }
+
+    // 事件任务第一次扫描后移到事件队列，之后每次调度只扫描周期任务
+    xf_task_manager_stats_t stats;
+    assert(xf_task_manager_reset_stats(manager) == XF_OK);
+    run_until(200);
+    assert(xf_task_manager_get_stats(manager, &stats) == XF_OK);
+    printf("passes:%u scan_max:%u scan_total:%u\n", (unsigned)stats.passes, (unsigned)stats.scan_max,
+           (unsigned)stats.scan_total);
+    assert(stats.scan_max == 1 && stats.scan_total == stats.passes);
+    // 快照中仍然包含事件队列中的任务
+    xf_task_stats_entry_t entries[EVENT_NUM + 4];
+    assert(xf_task_manager_get_task_stats(manager, entries, EVENT_NUM + 4) == EVENT_NUM + 2);
+
+    // 触发后扫描整个事件队列（64 个事件任务加上之后改为周期的任务），被触发的任务按优先级执行一次
+    assert(xf_task_set_priority(events[40], 0) == XF_OK);
+    xf_task_trigger(events[5]);
+    xf_task_trigger(events[40]);
+    assert(xf_task_manager_reset_stats(manager) == XF_OK);
+    run_until(210);
+    assert(xf_task_manager_get_stats(manager, &stats) == XF_OK);
+    printf("order:%u %u scan_max:%u\n", (unsigned)s_order[0], (unsigned)s_order[1], (unsigned)stats.scan_max);
+    assert(s_order_num == 2 && s_order[0] == 40 && s_order[1] == 5);
+    assert(s_event_runs[5] == 1 && s_event_runs[40] == 1 && s_event_runs[6] == 0);
+    assert(stats.scan_max == 1 + EVENT_NUM + 1);
+
+    // 事件任务改为周期 20ms 后移回阻塞队列，立即执行一次，之后每 20ms 执行
+    assert(xf_task_set_delay(changed, 20) == XF_OK);
+    run_until(300);
+    printf("changed:%d first:%u\n", s_changed_num, (unsigned)s_changed[0]);
+    assert(s_changed_num == 5 && s_changed[0] == 210);
+    for (int i = 1; i < s_changed_num; i++)
+    {
+        assert(s_changed[i] - s_changed[i - 1] == 20);
+    }
+
+    printf("ntask_fast ok\n");
+    return 0;
+}
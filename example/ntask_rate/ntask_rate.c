@@ -0,0 +1,140 @@
+#include "xf_task.h"
+#include <assert.h>
+#include <stdio.h>
+
+#define PERIOD      10
+#define LATE        25
+#define RUN_NUM     6
+
+static xf_task_time_t s_tick = 0;
+static xf_task_time_t s_run[RUN_NUM];
+static int s_run_num = 0;
+static bool s_late = true;
+
+/**
+ * @brief 虚拟时钟，由例程手动推进，保证每次运行的结果一致
+ *
+ * @return xf_task_time_t 当前时间
+ */
+static xf_task_time_t fake_get_tick(void)
+{
+    return s_tick;
+}
+
+/**
+ * @brief 周期任务，记录每次执行的时间，s_late 为真时第 2 次执行耗时 25ms ，错过后面两个周期点
+ *
+ * @param task 任务对象
+ */
+static void task_periodic(xf_task_t task)
+{
+    if (s_run_num < RUN_NUM)
+    {
+        s_run[s_run_num++] = s_tick;
+    }
+    if (s_late && s_run_num == 2)
+    {
+        s_tick += LATE;
+    }
+}
+
+/**
+ * @brief 按 1ms 推进虚拟时钟并调度，直到周期任务执行够指定次数
+ *
+ * @param num 执行次数
+ */
+static void run_until(int num)
+{
+    while (s_run_num < num)
+    {
+        xf_task_manager_run_default();
+        s_tick++;
+    }
+}
+
+/**
+ * @brief 从零时刻开始以指定模式运行周期任务
+ *
+ * @param rate 周期模式
+ * @param late 第 2 次执行是否超时
+ * @return xf_task_t 周期任务
+ */
+static xf_task_t start(xf_ntask_rate_t rate, bool late)
+{
+    s_tick = 0;
+    s_run_num = 0;
+    s_late = late;
+    xf_task_t task = xf_ntask_create_loop(task_periodic, NULL, 1, PERIOD);
+    assert(xf_ntask_set_rate(task, rate) == XF_OK);
+    return task;
+}
+
+/**
+ * @brief 打印并检查周期任务的执行时间与错过的周期数，检查完删除任务
+ *
+ * @param name 模式名称
+ * @param task 周期任务
+ * @param expect 期望的执行时间
+ * @param overrun 期望的错过周期数
+ */
+static void check_run(const char *name, xf_task_t task, const xf_task_time_t expect[RUN_NUM], uint32_t overrun)
+{
+    printf("%-8s run:", name);
+    for (int i = 0; i < RUN_NUM; i++)
+    {
+        printf(" %u", (unsigned)s_run[i]);
+    }
+    printf(" overrun:%u\n", (unsigned)xf_ntask_get_overrun(task));
+
+    for (int i = 0; i < RUN_NUM; i++)
+    {
+        assert(s_run[i] == expect[i]);
+    }
+    assert(xf_ntask_get_overrun(task) == overrun);
+
+    xf_task_delete(task);
+    xf_task_manager_run_default();
+}
+
+int main()
+{
+    // 对接虚拟时钟
+    xf_task_tick_init(fake_get_tick);
+    // 初始化默认任务管理器，例程自己推进时钟，空闲时直接返回继续轮询
+    xf_task_manager_default_init(NULL);
+
+    // 周期 10ms ，第 2 次执行在 20ms 开始并持续到 45ms ，错过 30ms 和 40ms 两个周期点
+    // SKIP ：跳过错过的周期点，在 50ms 继续，记 2 个错过周期
+    xf_task_t task = start(XF_NTASK_RATE_SKIP, true);
+    run_until(RUN_NUM);
+    const xf_task_time_t skip[RUN_NUM] = {10, 20, 50, 60, 70, 80};
+    check_run("skip", task, skip, 2);
+
+    // BURST ：立即连续补执行 30ms 和 40ms 两个周期点，之后回到 50ms 的相位，记 2 个补执行周期
+    task = start(XF_NTASK_RATE_BURST, true);
+    run_until(RUN_NUM);
+    const xf_task_time_t burst[RUN_NUM] = {10, 20, 46, 47, 50, 60};
+    check_run("burst", task, burst, 2);
+
+    // COALESCE ：30ms 和 40ms 两个周期点合并为一次立即执行，之后回到 50ms 的相位，记 1 个合并掉的周期
+    task = start(XF_NTASK_RATE_COALESCE, true);
+    run_until(RUN_NUM);
+    const xf_task_time_t coalesce[RUN_NUM] = {10, 20, 46, 50, 60, 70};
+    check_run("coalesce", task, coalesce, 1);
+
+    // 周期点之前被触发提前执行，不推进周期点，也不算错过
+    task = start(XF_NTASK_RATE_SKIP, false);
+    run_until(2);
+    while (s_tick < 25)
+    {
+        xf_task_manager_run_default();
+        s_tick++;
+    }
+    xf_task_trigger(task);
+    run_until(RUN_NUM);
+    const xf_task_time_t trigger[RUN_NUM] = {10, 20, 25, 30, 40, 50};
+    check_run("trigger", task, trigger, 0);
+
+    printf("ntask_rate ok\n");
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include "xf_task.h"
+#include "port.h"
+#include <assert.h>
+#include <stdio.h>
+
+#define DATA_NUM    100000
+#define DATA_GRAIN  1000
+
+static uint32_t s_data[DATA_NUM];
+static uint32_t s_fill_count = 0;
+static int32_t s_other_at = -1;
+static bool s_done = false;
+
+/**
+ * @brief parallel_for 块函数，填充 [begin, end) 的数据
+ *
+ * @param begin 起始下标
+ * @param end 结束下标（不包括）
+ * @param arg 协作执行时为需要触发的任务，多线程执行时为 NULL
+ */
+static void fill(uint32_t begin, uint32_t end, void *arg)
+{
+    // 多线程执行时块函数运行在其他线程上，不能调用 xf_task 的接口
+    if (arg != NULL)
+    {
+        if (begin == 0)
+        {
+            xf_task_trigger((xf_task_t)arg);
+        }
+        s_fill_count++;
+    }
+    for (uint32_t i = begin; i < end; i++)
+    {
+        s_data[i] = i % 7;
+    }
+}
+
+/**
+ * @brief parallel_reduce 块函数，把 [begin, end) 的和累加到 partial
+ *
+ * @param begin 起始下标
+ * @param end 结束下标（不包括）
+ * @param partial 当前线程的部分结果
+ * @param arg 用户参数
+ */
+static void sum(uint32_t begin, uint32_t end, void *partial, void *arg)
+{
+    uint64_t total = 0;
+    for (uint32_t i = begin; i < end; i++)
+    {
+        total += s_data[i];
+    }
+    *(uint64_t *)partial += total;
+}
+
+/**
+ * @brief parallel_reduce 合并函数
+ *
+ * @param result 最终结果
+ * @param partial 某个线程的部分结果
+ * @param arg 用户参数
+ */
+static void join(void *result, const void *partial, void *arg)
+{
+    *(uint64_t *)result += *(const uint64_t *)partial;
+}
+
+/**
+ * @brief 串行计算期望的和
+ */
+static uint64_t expect_sum(void)
+{
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < DATA_NUM; i++)
+    {
+        total += i % 7;
+    }
+    return total;
+}
+
+/**
+ * @brief 在 ctask 中填充并求和，没有对接多线程时每块之间让出 CPU
+ *
+ * @param task 任务对象
+ */
+static void task_compute(xf_task_t task)
+{
+    uint64_t total = 0;
+    xf_task_parallel_for(0, DATA_NUM, DATA_GRAIN, fill, xf_task_get_arg(task));
+    xf_task_parallel_reduce(0, DATA_NUM, DATA_GRAIN, sum, join, NULL, &total, sizeof(total));
+    printf("coop sum:%llu\n", (unsigned long long)total);
+    assert(total == expect_sum());
+    s_done = true;
+}
+
+/**
+ * @brief 高优先级事件任务，记录自己执行时填充进行到了第几块
+ *
+ * @param task 任务对象
+ */
+static void task_other(xf_task_t task)
+{
+    s_other_at = (int32_t)s_fill_count;
+}
+
+int main()
+{
+    // 对接上下文
+    xf_task_context_init(create_context, swap_context);
+    // 对接时间戳
+    xf_task_tick_init(task_get_tick);
+    // 初始化默认任务管理器，例程按时间运行，空闲时直接返回继续轮询
+    xf_task_manager_default_init(NULL);
+
+    // 没有对接多线程：在 ctask 中协作执行，其他任务照常调度
+    // 第一块中触发高优先级任务，它在下一块之前就得到执行，而不是等到全部块执行完
+    xf_task_t other = xf_ntask_create(task_other, NULL, 0, 0, 1);
+    xf_ctask_create(task_compute, other, 1, 1024 * 32);
+    while (!s_done)
+    {
+        xf_task_manager_run_default();
+    }
+    printf("other task ran after chunk:%d\n", s_other_at);
+    assert(s_other_at == 1);
+
+    // 对接多线程：块在 4 个线程上执行，结果与串行计算一致
+    xf_task_parallel_init(4, parallel_run);
+    for (uint32_t i = 0; i < DATA_NUM; i++)
+    {
+        s_data[i] = 0;
+    }
+    uint64_t total = 0;
+    assert(xf_task_parallel_for(0, DATA_NUM, 0, fill, NULL) == XF_OK);
+    assert(xf_task_parallel_reduce(0, DATA_NUM, 0, sum, join, NULL, &total, sizeof(total)) == XF_OK);
+    printf("threaded sum:%llu\n", (unsigned long long)total);
+    assert(total == expect_sum());
+
+    printf("parallel ok\n");
+    return 0;
+}
@@ -0,0 +1,226 @@
+#include "xf_task.h"
+#include "port.h"
+#include <assert.h>
+#include <stdio.h>
+
+#define WORK_HOLD_MS    20
+#define JOB_NUM         100
+
+static xf_task_time_t s_tick = 0;
+static xf_task_pool_t s_pool = NULL;
+static char s_order[32];
+static int s_order_num = 0;
+static xf_err_t s_block_err[3];
+static int s_block_done = 0;
+static int s_job_count = 0;
+static int s_done_count = 0;
+static int s_ctask_job_count = 0;
+
+/**
+ * @brief 虚拟时钟，只在空闲时推进，保证每次运行的结果一致
+ *
+ * @return xf_task_time_t 当前时间
+ */
+static xf_task_time_t fake_get_tick(void)
+{
+    return s_tick;
+}
+
+/**
+ * @brief 空闲回调，直接把虚拟时钟推进到下一个任务唤醒的时间
+ *
+ * @param max_idle_ms 最大空闲时间
+ */
+static void fake_idle(unsigned long int max_idle_ms)
+{
+    s_tick += max_idle_ms;
+}
+
+/**
+ * @brief 工作任务执行的函数，记录自己的执行顺序
+ *
+ * @param task 任务对象
+ */
+static void task_work(xf_task_t task)
+{
+    s_order[s_order_num++] = (char)(uintptr_t)xf_task_get_arg(task);
+}
+
+/**
+ * @brief 有栈协程中以 XF_TASK_POOL_BLOCK 方式取工作任务
+ *
+ * @param task 任务对象
+ */
+static void task_block(xf_task_t task)
+{
+    uintptr_t timeout = (uintptr_t)xf_task_get_arg(task);
+    s_block_err[s_block_done++] = xf_task_pool_acquire(s_pool, task_work, (void *)'B', 1, XF_TASK_POOL_BLOCK,
+                                  timeout, NULL);
+}
+
+static void job(void *arg)
+{
+    s_job_count++;
+}
+
+static void job_done(void *arg)
+{
+    s_done_count++;
+}
+
+/**
+ * @brief ctask 类型任务池的作业，可以在作业中阻塞等待
+ *
+ * @param arg 作业参数
+ */
+static void ctask_job(void *arg)
+{
+    xf_ctask_delay(5);
+    s_ctask_job_count++;
+}
+
+/**
+ * @brief 运行默认任务管理器一段时间
+ *
+ * @param ms 运行时间，单位为 ms
+ */
+static void run_for(xf_task_time_t ms)
+{
+    xf_task_time_t start = s_tick;
+    while (s_tick - start < ms)
+    {
+        xf_task_manager_run_default();
+    }
+}
+
+/**
+ * @brief 取出所有工作任务，让任务池耗尽
+ */
+static void exhaust(void)
+{
+    uint32_t total = 0;
+    uint32_t used = 0;
+    for (int i = 0; i < 5; i++)
+    {
+        assert(xf_task_init_from_pool(s_pool, task_work, (void *)(uintptr_t)('0' + i), 1) != NULL);
+    }
+    xf_task_pool_get_works(s_pool, &total, &used);
+    assert(total == 5 && used == 5);
+}
+
+int main()
+{
+    // 对接上下文
+    xf_task_context_init(create_context, swap_context);
+    // 对接虚拟时钟
+    xf_task_tick_init(fake_get_tick);
+    xf_task_manager_default_init(fake_idle);
+
+    // 常驻 1 个，最多 5 个，每次扩充 2 个，空闲 50ms 后回收，等待队列长度为 3
+    // 工作任务取出后 20ms 执行一次，执行完回收到任务池
+    xf_ntask_config_t config = {.count = 1, .delay_ms = WORK_HOLD_MS};
+    xf_task_pool_attr_t attr = {
+        .min_works = 1,
+        .max_works = 5,
+        .grow_step = 2,
+        .idle_shrink_ms = 50,
+        .pending_max = 3,
+    };
+    s_pool = xf_task_pool_create_with_attr(xf_task_get_default_manager(), XF_TASK_TYPE_NTASK, &config, &attr);
+    assert(s_pool != NULL);
+    uint32_t total = 0;
+    uint32_t used = 0;
+    xf_task_pool_get_works(s_pool, &total, &used);
+    assert(total == 1 && used == 0);
+
+    // XF_TASK_POOL_NOWAIT：耗尽后立即返回失败
+    exhaust();
+    assert(xf_task_init_from_pool(s_pool, task_work, NULL, 1) == NULL);
+    assert(xf_task_pool_acquire(s_pool, task_work, NULL, 1, XF_TASK_POOL_NOWAIT, 0, NULL) == XF_ERR_NO_MEM);
+    // XF_TASK_POOL_BLOCK：不在有栈协程中时不能阻塞
+    assert(xf_task_pool_acquire(s_pool, task_work, NULL, 1, XF_TASK_POOL_BLOCK, 10, NULL) == XF_ERR_NOT_SUPPORTED);
+
+    // XF_TASK_POOL_PENDING：耗尽后按先后顺序排队，等待队列满时返回失败
+    assert(xf_task_pool_acquire(s_pool, task_work, (void *)'a', 1, XF_TASK_POOL_PENDING, 0, NULL) == XF_OK);
+    assert(xf_task_pool_acquire(s_pool, task_work, (void *)'b', 1, XF_TASK_POOL_PENDING, 0, NULL) == XF_OK);
+    assert(xf_task_pool_acquire(s_pool, task_work, (void *)'c', 1, XF_TASK_POOL_PENDING, 0, NULL) == XF_OK);
+    assert(xf_task_pool_acquire(s_pool, task_work, (void *)'d', 1, XF_TASK_POOL_PENDING, 0, NULL) == XF_ERR_NO_MEM);
+    run_for(WORK_HOLD_MS * 3);
+    s_order[s_order_num] = '\0';
+    printf("pending order:%s\n", s_order);
+    assert(s_order_num == 8);
+    assert(s_order[5] == 'a' && s_order[6] == 'b' && s_order[7] == 'c');
+
+    // 空闲超过 idle_shrink_ms 后收缩回 min_works
+    run_for(150);
+    xf_task_pool_get_works(s_pool, &total, &used);
+    printf("after shrink total:%u used:%u\n", total, used);
+    assert(total == 1 && used == 0);
+
+    // XF_TASK_POOL_BLOCK：等待时间短于工作任务回收时间时超时，足够长时取到工作任务
+    exhaust();
+    xf_ctask_create(task_block, (void *)5, 0, 1024 * 32);
+    run_for(WORK_HOLD_MS / 2);
+    xf_ctask_create(task_block, (void *)200, 0, 1024 * 32);
+    run_for(WORK_HOLD_MS * 3);
+    printf("block err:%d %d\n", s_block_err[0], s_block_err[1]);
+    assert(s_block_done == 2 && s_block_err[0] == XF_ERR_TIMEOUT && s_block_err[1] == XF_OK);
+    run_for(WORK_HOLD_MS * 2);
+    assert(xf_task_pool_delete(s_pool) == XF_OK);
+
+    // 作业队列：大量短小的作业由常驻工作任务按批次执行，作业队列满时提交失败
+    xf_task_pool_attr_t job_attr = {
+        .min_works = 1,
+        .max_works = 1,
+        .job_queue_size = 64,
+        .job_workers = 1,
+        .job_priority = 2,
+    };
+    xf_task_pool_t job_pool = xf_task_pool_create_with_attr(xf_task_get_default_manager(), XF_TASK_TYPE_NTASK,
+                              &config, &job_attr);
+    assert(job_pool != NULL);
+    for (int i = 0; i < 64; i++)
+    {
+        assert(xf_task_pool_submit_with_done(job_pool, job, NULL, job_done) == XF_OK);
+    }
+    assert(xf_task_pool_submit(job_pool, job, NULL) == XF_ERR_NO_MEM);
+    assert(xf_task_pool_get_jobs(job_pool) == 64);
+    int submitted = 64;
+    while (submitted < JOB_NUM)
+    {
+        xf_task_manager_run_default();
+        if (xf_task_pool_submit_with_done(job_pool, job, NULL, job_done) == XF_OK)
+        {
+            submitted++;
+        }
+    }
+    run_for(10);
+    printf("jobs:%d done:%d\n", s_job_count, s_done_count);
+    assert(s_job_count == JOB_NUM && s_done_count == JOB_NUM && xf_task_pool_get_jobs(job_pool) == 0);
+    assert(xf_task_pool_delete(job_pool) == XF_OK);
+
+    // ctask 类型的任务池：3 个常驻工作任务同时执行可以阻塞的作业
+    xf_ctask_config_t ctask_config = {.stack_size = 1024 * 32};
+    xf_task_pool_attr_t ctask_attr = {
+        .min_works = 0,
+        .max_works = 1,
+        .job_queue_size = 8,
+        .job_workers = 3,
+        .job_priority = 1,
+    };
+    xf_task_pool_t ctask_pool = xf_task_pool_create_with_attr(xf_task_get_default_manager(), XF_TASK_TYPE_CTASK,
+                                &ctask_config, &ctask_attr);
+    assert(ctask_pool != NULL);
+    for (int i = 0; i < 6; i++)
+    {
+        assert(xf_task_pool_submit(ctask_pool, ctask_job, NULL) == XF_OK);
+    }
+    run_for(30);
+    printf("ctask jobs:%d\n", s_ctask_job_count);
+    assert(s_ctask_job_count == 6);
+    assert(xf_task_pool_delete(ctask_pool) == XF_OK);
+    run_for(10);
+
+    printf("pool ok\n");
+    return 0;
+}
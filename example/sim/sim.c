@@ -0,0 +1,51 @@
+#include "xf_task.h"
+#include "port.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static void print_report(uint32_t ntasks, const xf_task_sim_report_t *report)
+{
+    printf("%6u %6u.%u%% %8u %6u %6u %5u %5u %5u %5u %5u\n", (unsigned)ntasks,
+           (unsigned)(report->utilization / 10), (unsigned)(report->utilization % 10),
+           (unsigned)report->throughput, (unsigned)report->deadline_miss, (unsigned)report->skipped,
+           (unsigned)report->latency.p50, (unsigned)report->latency.p99, (unsigned)report->latency.max,
+           (unsigned)report->queue.p99, (unsigned)report->queue.max);
+}
+
+int main(int argc, char *argv[])
+{
+    // 对接上下文
+    xf_task_context_init(create_context, swap_context);
+    // 对接虚拟时钟，仿真不依赖真实时间
+    xf_task_tick_init(xf_task_sim_get_ticks);
+
+    // 模拟一个小时的负载，同样的种子得到同样的结果
+    xf_task_sim_config_t config = {
+        .seed = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 1,
+        .duration_ms = 60 * 60 * 1000,
+        .event_tasks = 4,
+        .ctask_pairs = 2,
+        .priorities = 4,
+        .period_min_ms = 10,
+        .period_max_ms = 100,
+        .exec_min_ticks = 0,
+        .exec_max_ticks = 3,
+        .trigger_permille = 100,
+        .queue_depth = 4,
+        .stack_size = 1024 * 16,
+    };
+    xf_task_sim_report_t report;
+
+    // 逐步增加周期任务数，观察利用率上升时截止时间与延迟的变化
+    printf("ntasks   util      thr   miss   skip   p50   p99   max  q.p99 q.max\n");
+    for (uint16_t ntasks = 8; ntasks <= 64; ntasks += 8) {
+        config.ntasks = ntasks;
+        if (xf_task_sim_run(&config, &report) != XF_OK) {
+            printf("sim failed\n");
+            return -1;
+        }
+        print_report(ntasks, &report);
+    }
+
+    return 0;
+}
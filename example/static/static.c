@@ -0,0 +1,169 @@
+#include "xf_task.h"
+#include "port.h"
+#include <assert.h>
+#include <stdio.h>
+
+#define STACK_SIZE  (1024 * 32)
+#define MSG_NUM     5
+#define TOPIC_ID    1
+
+static XF_TASK_MANAGER_STORAGE_DEFINE(s_default_manager);
+static XF_TASK_MANAGER_STORAGE_DEFINE(s_worker_manager);
+static XF_CTASK_STORAGE_DEFINE(s_producer, STACK_SIZE);
+static XF_CTASK_STORAGE_DEFINE(s_consumer, STACK_SIZE);
+static XF_CTASK_QUEUE_STORAGE_DEFINE(s_queue, sizeof(int), 2);
+static XF_NTASK_STORAGE_DEFINE(s_counter);
+static XF_NTASK_STORAGE_DEFINE(s_handler);
+static XF_TASK_MBUS_STORAGE_DEFINE(s_worker_bus);
+static XF_TASK_MTOPIC_STORAGE_DEFINE(s_default_topic, sizeof(int));
+static XF_TASK_MTOPIC_STORAGE_DEFINE(s_worker_topic, sizeof(int));
+
+static xf_ctask_queue_t s_queue_handle = NULL;
+static int s_sum = 0;
+static int s_count = 0;
+static int s_default_received = 0;
+static int s_worker_received = 0;
+
+/**
+ * @brief 静态 ctask ，通过静态消息队列依次发送 1 ~ MSG_NUM
+ *
+ * @param task 任务对象
+ */
+static void task_producer(xf_task_t task)
+{
+    for (int i = 1; i <= MSG_NUM; i++)
+    {
+        assert(xf_ctask_queue_send(s_queue_handle, &i, 100) == XF_OK);
+    }
+}
+
+/**
+ * @brief 静态 ctask ，从静态消息队列接收并累加
+ *
+ * @param task 任务对象
+ */
+static void task_consumer(xf_task_t task)
+{
+    int value = 0;
+    for (int i = 0; i < MSG_NUM; i++)
+    {
+        assert(xf_ctask_queue_receive(s_queue_handle, &value, 100) == XF_OK);
+        s_sum += value;
+    }
+}
+
+/**
+ * @brief 静态 ntask ，执行 3 次后结束
+ *
+ * @param task 任务对象
+ */
+static void task_counter(xf_task_t task)
+{
+    s_count++;
+}
+
+/**
+ * @brief 工作任务管理器上的总线处理任务
+ *
+ * @param task 任务对象
+ */
+static void task_handler(xf_task_t task)
+{
+    xf_task_mbus_handle_with_bus((xf_task_mbus_t)&s_worker_bus);
+}
+
+/**
+ * @brief 默认总线静态 topic 的订阅回调
+ *
+ * @param data 消息数据
+ * @param user_data 用户参数
+ */
+static void default_cb(const void *const data, void *user_data)
+{
+    s_default_received += *(const int *)data;
+}
+
+/**
+ * @brief 静态总线静态 topic 的订阅回调
+ *
+ * @param data 消息数据
+ * @param user_data 用户参数
+ */
+static void worker_cb(const void *const data, void *user_data)
+{
+    s_worker_received += *(const int *)data;
+}
+
+/**
+ * @brief 运行默认任务管理器一段时间
+ *
+ * @param ms 运行时间，单位为 ms
+ */
+static void run_for(xf_task_time_t ms)
+{
+    xf_task_time_t start = task_get_tick();
+    while (task_get_tick() - start < ms)
+    {
+        xf_task_manager_run_default();
+    }
+}
+
+int main()
+{
+    // 对接上下文
+    xf_task_context_init(create_context, swap_context);
+    // 对接时间戳
+    xf_task_tick_init(task_get_tick);
+    // 默认任务管理器与另一个任务管理器都使用静态内存
+    assert(xf_task_manager_default_init_static(NULL, &s_default_manager) == XF_OK);
+    assert(xf_task_get_default_manager() == (xf_task_manager_t)&s_default_manager);
+    xf_task_manager_t worker = xf_task_manager_create_static(NULL, &s_worker_manager);
+    assert(worker == (xf_task_manager_t)&s_worker_manager);
+
+    // 静态 ctask 通过静态消息队列传递数据，队列长度小于消息数，双方会交替阻塞
+    s_queue_handle = xf_ctask_queue_create_static_with_manager(xf_task_get_default_manager(), sizeof(int), 2,
+                     &s_queue);
+    assert(s_queue_handle == (xf_ctask_queue_t)&s_queue);
+    assert(xf_ctask_create_static(task_producer, NULL, 1, STACK_SIZE, &s_producer) == (xf_task_t)&s_producer);
+    assert(xf_ctask_create_static(task_consumer, NULL, 1, STACK_SIZE, &s_consumer) == (xf_task_t)&s_consumer);
+    // 静态 ntask 执行 3 次后结束，删除时不释放静态内存
+    assert(xf_ntask_create_static(task_counter, NULL, 1, 5, 3, &s_counter) == (xf_task_t)&s_counter);
+    run_for(50);
+    printf("sum:%d count:%d\n", s_sum, s_count);
+    assert(s_sum == MSG_NUM * (MSG_NUM + 1) / 2 && s_count == 3);
+    xf_ctask_queue_delete(s_queue_handle);
+
+    // 默认总线上的静态 topic
+    assert(xf_task_mbus_reg_topic_static(TOPIC_ID, sizeof(int), &s_default_topic) == XF_OK);
+    assert(xf_task_mbus_sub(TOPIC_ID, default_cb, NULL) == XF_OK);
+    int value = 7;
+    assert(xf_task_mbus_pub_sync(TOPIC_ID, &value) == XF_OK);
+    assert(s_default_received == 7);
+    assert(xf_task_mbus_unreg_topic(TOPIC_ID) == XF_OK);
+
+    // 绑定到静态任务管理器的静态总线与静态 topic ，异步发布由该管理器上的静态 ntask 处理
+    xf_task_mbus_t bus = xf_task_mbus_create_static_with_manager(worker, &s_worker_bus);
+    assert(bus == (xf_task_mbus_t)&s_worker_bus && xf_task_mbus_get_manager(bus) == worker);
+    assert(xf_task_mbus_reg_topic_static_with_bus(bus, TOPIC_ID, sizeof(int), &s_worker_topic) == XF_OK);
+    assert(xf_task_mbus_sub_with_bus(bus, TOPIC_ID, worker_cb, NULL) == XF_OK);
+    assert(xf_ntask_create_static_with_manager(worker, task_handler, NULL, 0, 1, XF_NTASK_INFINITE_LOOP,
+            &s_handler) == (xf_task_t)&s_handler);
+    value = 9;
+    assert(xf_task_mbus_pub_async_with_bus(bus, TOPIC_ID, &value) == XF_OK);
+    assert(s_worker_received == 0);
+    xf_task_time_t start = task_get_tick();
+    while (s_worker_received == 0 && task_get_tick() - start < 100)
+    {
+        xf_task_manager_run(worker);
+    }
+    printf("default:%d worker:%d\n", s_default_received, s_worker_received);
+    assert(s_worker_received == 9);
+
+    // 删除静态对象只从调度器和总线中移除，不释放内存
+    xf_task_delete((xf_task_t)&s_handler);
+    xf_task_manager_run(worker);
+    assert(xf_task_mbus_delete(bus) == XF_OK);
+
+    printf("static ok\n");
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "xf_task.h"
+#include <assert.h>
+#include <stdio.h>
+
+#define RUN_TICKS   100
+
+static xf_task_time_t s_tick = 0;
+
+/**
+ * @brief 虚拟时钟，只在任务执行和空闲时推进，保证每次运行的结果一致
+ *
+ * @return xf_task_time_t 当前时间
+ */
+static xf_task_time_t fake_get_tick(void)
+{
+    return s_tick;
+}
+
+/**
+ * @brief 空闲回调，直接把虚拟时钟推进到下一个任务唤醒的时间
+ *
+ * @param max_idle_ms 最大空闲时间
+ */
+static void fake_idle(unsigned long int max_idle_ms)
+{
+    s_tick += max_idle_ms;
+}
+
+/**
+ * @brief 周期任务，每次执行消耗参数指定的时间
+ *
+ * @param task 任务对象
+ */
+static void task_busy(xf_task_t task)
+{
+    s_tick += (xf_task_time_t)(uintptr_t)xf_task_get_arg(task);
+}
+
+int main()
+{
+    // 对接虚拟时钟
+    xf_task_tick_init(fake_get_tick);
+    xf_task_manager_default_init(fake_idle);
+    xf_task_manager_t manager = xf_task_get_default_manager();
+
+    // A 周期 10ms 每次执行 3ms ， B 周期 10ms 每次执行 5ms ，A 的优先级更高
+    xf_task_t task_a = xf_ntask_create_loop(task_busy, (void *)3, 1, 10);
+    xf_task_t task_b = xf_ntask_create_loop(task_busy, (void *)5, 2, 10);
+    assert(xf_task_manager_reset_stats(manager) == XF_OK);
+    while (s_tick < RUN_TICKS)
+    {
+        xf_task_manager_run_default();
+    }
+
+    // 单个任务的统计
+    xf_task_stats_t stats_a;
+    xf_task_stats_t stats_b;
+    assert(xf_task_get_stats(task_a, &stats_a) == XF_OK);
+    assert(xf_task_get_stats(task_b, &stats_b) == XF_OK);
+    printf("A dispatch:%u exec:%u max:%u ready_max:%u\n", (unsigned)stats_a.dispatch, (unsigned)stats_a.exec_total,
+           (unsigned)stats_a.exec_max, (unsigned)stats_a.ready_max);
+    printf("B dispatch:%u exec:%u max:%u ready_max:%u\n", (unsigned)stats_b.dispatch, (unsigned)stats_b.exec_total,
+           (unsigned)stats_b.exec_max, (unsigned)stats_b.ready_max);
+    // 执行时间只由任务自己消耗，两个任务同时就绪时 B 要等 A 执行完的 3ms
+    assert(stats_a.dispatch > 0 && stats_a.exec_total == stats_a.dispatch * 3 && stats_a.exec_max == 3);
+    assert(stats_b.dispatch > 0 && stats_b.exec_total == stats_b.dispatch * 5 && stats_b.exec_max == 5);
+    assert(stats_a.ready_max == 0 && stats_b.ready_max == 3);
+
+    // 任务管理器的调度统计
+    xf_task_manager_stats_t stats;
+    assert(xf_task_manager_get_stats(manager, &stats) == XF_OK);
+    printf("passes:%u dispatches:%u idle:%u busy:%u idle_ticks:%u elapsed:%u\n", (unsigned)stats.passes,
+           (unsigned)stats.dispatches, (unsigned)stats.idle_entries, (unsigned)stats.busy_ticks,
+           (unsigned)stats.idle_ticks, (unsigned)stats.elapsed);
+    // 虚拟时钟只在任务执行和空闲时推进，经过的时间全部记在执行和空闲上
+    assert(stats.dispatches == stats_a.dispatch + stats_b.dispatch && stats.passes >= stats.dispatches);
+    assert(stats.busy_ticks == stats_a.exec_total + stats_b.exec_total);
+    assert(stats.idle_entries > 0 && stats.elapsed == stats.busy_ticks + stats.idle_ticks);
+    assert(stats.urgent == 0 && stats.scan_ticks == 0);
+
+    // 所有任务的快照
+    xf_task_stats_entry_t entries[4];
+    uint32_t count = xf_task_manager_get_task_stats(manager, entries, 4);
+    printf("snapshot:%u\n", (unsigned)count);
+    assert(count == 2);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const xf_task_stats_t *expect = (entries[i].task == task_a) ? &stats_a : &stats_b;
+        assert(entries[i].task == task_a || entries[i].task == task_b);
+        assert(entries[i].stats.dispatch == expect->dispatch && entries[i].stats.exec_total == expect->exec_total);
+    }
+    // 数组不够长时只填写前面的项，仍然返回任务总数
+    assert(xf_task_manager_get_task_stats(manager, entries, 1) == 2);
+
+    // 清零后重新统计
+    assert(xf_task_reset_stats(task_a) == XF_OK);
+    assert(xf_task_get_stats(task_a, &stats_a) == XF_OK && stats_a.dispatch == 0 && stats_a.exec_total == 0);
+    assert(xf_task_manager_reset_stats(manager) == XF_OK);
+    assert(xf_task_manager_get_stats(manager, &stats) == XF_OK && stats.passes == 0 && stats.elapsed == 0);
+
+    printf("stats ok\n");
+    return 0;
+}
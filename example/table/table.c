@@ -0,0 +1,64 @@
+#include "xf_task.h"
+#include "port.h"
+#include <stdio.h>
+
+static void heartbeat_task(xf_task_t task);
+static void producer_task(xf_task_t task);
+static void consumer_task(xf_task_t task);
+
+// 展开任务表，生成任务内存、任务 id 与 xf_task_table_init
+#define XF_TASK_TABLE_FILE "table_tasks.inc"
+#include "task/xf_task_static_table.h"
+
+// 队列同样使用静态内存
+static XF_CTASK_QUEUE_STORAGE_DEFINE(s_queue_storage, sizeof(uint32_t), 4);
+static xf_ctask_queue_t s_queue;
+
+static void heartbeat_task(xf_task_t task)
+{
+    printf("heartbeat\n");
+}
+
+static void producer_task(xf_task_t task)
+{
+    uint32_t count = 0;
+    while (1) {
+        count++;
+        xf_ctask_queue_send(s_queue, &count, 1000);
+        xf_ctask_delay(1000);
+    }
+}
+
+static void consumer_task(xf_task_t task)
+{
+    uint32_t count;
+    while (1) {
+        if (xf_ctask_queue_receive(s_queue, &count, 5000) == XF_OK) {
+            printf("consumer receive:%u\n", (unsigned)count);
+        }
+    }
+}
+
+int main()
+{
+    // 对接上下文
+    xf_task_context_init(create_context, swap_context);
+    // 对接时间戳
+    xf_task_tick_init(task_get_tick);
+
+    // 创建默认任务管理器与任务表中的全部任务，不申请堆内存
+    if (xf_task_table_init(task_on_idle) != XF_OK) {
+        printf("table init failed\n");
+        return -1;
+    }
+    s_queue = xf_ctask_queue_create_static(sizeof(uint32_t), 4, &s_queue_storage);
+
+    printf("%d tasks, producer:%p\n", XF_TASK_TABLE_COUNT, xf_task_table_get(XF_TASK_TABLE_ID_producer));
+
+    // 启动任务管理器
+    while (1) {
+        xf_task_manager_run_default();
+    }
+
+    return 0;
+}
@@ -0,0 +1,174 @@
+#include "xf_task.h"
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TRACE_MAX   XF_TASK_TRACE_BUFFER_SIZE
+
+static xf_task_time_t s_tick = 0;
+static xf_task_t s_task_b = NULL;
+static char s_json[16 * 1024];
+static size_t s_json_len = 0;
+
+/**
+ * @brief 虚拟时钟，只在任务执行和空闲时推进，保证每次运行的结果一致
+ *
+ * @return xf_task_time_t 当前时间
+ */
+static xf_task_time_t fake_get_tick(void)
+{
+    return s_tick;
+}
+
+/**
+ * @brief 空闲回调，直接把虚拟时钟推进到下一个任务唤醒的时间
+ *
+ * @param max_idle_ms 最大空闲时间
+ */
+static void fake_idle(unsigned long int max_idle_ms)
+{
+    s_tick += max_idle_ms;
+}
+
+/**
+ * @brief 周期任务，执行 2ms 后触发事件任务 B
+ *
+ * @param task 任务对象
+ */
+static void task_a(xf_task_t task)
+{
+    s_tick += 2;
+    xf_task_trigger(s_task_b);
+}
+
+/**
+ * @brief 事件任务，执行 1ms
+ *
+ * @param task 任务对象
+ */
+static void task_b(xf_task_t task)
+{
+    s_tick += 1;
+}
+
+/**
+ * @brief Chrome trace 的输出函数，保存到内存中
+ *
+ * @param str 文本
+ * @param len 文本长度
+ * @param arg 用户参数
+ */
+static void json_write(const char *str, size_t len, void *arg)
+{
+    assert(s_json_len + len < sizeof(s_json));
+    memcpy(s_json + s_json_len, str, len);
+    s_json_len += len;
+    s_json[s_json_len] = '\0';
+}
+
+/**
+ * @brief 统计子串出现的次数
+ *
+ * @param str 字符串
+ * @param sub 子串
+ * @return int 出现次数
+ */
+static int count_str(const char *str, const char *sub)
+{
+    int count = 0;
+    for (const char *p = strstr(str, sub); p != NULL; p = strstr(p + 1, sub))
+    {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief 推进虚拟时钟并调度到指定时间
+ *
+ * @param ticks 时间
+ */
+static void run_until(xf_task_time_t ticks)
+{
+    while (s_tick < ticks)
+    {
+        xf_task_manager_run_default();
+    }
+}
+
+int main()
+{
+    // 对接虚拟时钟
+    xf_task_tick_init(fake_get_tick);
+    xf_task_manager_default_init(fake_idle);
+    xf_task_manager_t manager = xf_task_get_default_manager();
+
+    // A 周期 10ms 执行 2ms 后触发 B ， B 执行 1ms
+    xf_task_t a = xf_ntask_create_loop(task_a, NULL, 1, 10);
+    s_task_b = xf_ntask_create(task_b, NULL, 2, 0, 1);
+    run_until(25);
+
+    // 二进制读取：第一个周期的事件顺序和时间
+    const struct {
+        xf_task_trace_type_t type;
+        const void *obj;
+        uint32_t ticks;
+    } expect[] = {
+        {XF_TASK_TRACE_IDLE_BEGIN, manager, 0},
+        {XF_TASK_TRACE_IDLE_END, manager, 10},
+        {XF_TASK_TRACE_TASK_BEGIN, a, 10},
+        {XF_TASK_TRACE_TRIGGER, s_task_b, 12},
+        {XF_TASK_TRACE_TASK_END, a, 12},
+        {XF_TASK_TRACE_TASK_BEGIN, s_task_b, 12},
+        {XF_TASK_TRACE_TASK_END, s_task_b, 13},
+    };
+    xf_task_trace_event_t events[TRACE_MAX];
+    uint32_t count = xf_task_trace_read(manager, events, TRACE_MAX);
+    printf("events:%u\n", (unsigned)count);
+    assert(count == 14);
+    for (uint32_t i = 0; i < sizeof(expect) / sizeof(expect[0]); i++)
+    {
+        assert(events[i].type == expect[i].type && events[i].obj == expect[i].obj && events[i].ticks == expect[i].ticks);
+    }
+    // B 执行完空闲到 A 的下一个周期点，之后与第一个周期相同，整体后移 12ms
+    assert(events[7].type == XF_TASK_TRACE_IDLE_BEGIN && events[7].ticks == 13 && events[7].arg == 9);
+    assert(events[8].type == XF_TASK_TRACE_IDLE_END && events[8].ticks == 22);
+    for (uint32_t i = 9; i < count; i++)
+    {
+        assert(events[i].type == events[i - 7].type && events[i].ticks == events[i - 7].ticks + 12);
+    }
+
+    // Chrome trace ：区间成对，触发到执行之间有箭头，最后一个事件后面没有多余的逗号
+    assert(xf_task_trace_dump_chrome(manager, json_write, NULL) == XF_OK);
+    printf("json begin:%d end:%d flow:%d\n", count_str(s_json, "\"ph\":\"B\""), count_str(s_json, "\"ph\":\"E\""),
+           count_str(s_json, "\"ph\":\"s\""));
+    const char *head = "{\"traceEvents\":[\n";
+    const char *tail = "}\n],\"displayTimeUnit\":\"ms\"}\n";
+    assert(strncmp(s_json, head, strlen(head)) == 0);
+    assert(strcmp(s_json + s_json_len - strlen(tail), tail) == 0);
+    assert(count_str(s_json, "\"ph\":\"B\"") == 6 && count_str(s_json, "\"ph\":\"E\"") == 6);
+    assert(count_str(s_json, "\"ph\":\"s\"") == 2 && count_str(s_json, "\"ph\":\"f\"") == 4);
+    assert(count_str(s_json, ",\n]") == 0);
+
+    // 关闭后不再记录，清空后从零开始
+    assert(xf_task_trace_enable(manager, false) == XF_OK);
+    run_until(50);
+    assert(xf_task_trace_read(manager, events, TRACE_MAX) == count);
+    assert(xf_task_trace_enable(manager, true) == XF_OK);
+    assert(xf_task_trace_clear(manager) == XF_OK);
+    assert(xf_task_trace_read(manager, events, TRACE_MAX) == 0);
+
+    // 写满后覆盖最早的事件，读取的始终是最新的事件并按时间排序
+    run_until(500);
+    count = xf_task_trace_read(manager, events, TRACE_MAX);
+    printf("after wrap:%u last:%u\n", (unsigned)count, (unsigned)events[count - 1].ticks);
+    assert(count == TRACE_MAX);
+    for (uint32_t i = 1; i < count; i++)
+    {
+        assert(events[i].ticks >= events[i - 1].ticks);
+    }
+    assert(events[count - 1].ticks == s_tick);
+
+    printf("trace ok\n");
+    return 0;
+}
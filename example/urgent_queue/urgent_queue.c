@@ -0,0 +1,84 @@
+#include "xf_task.h"
+#include "port.h"
+#include <assert.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#define URGENT_NUM 4
+
+static char s_order[32];
+static int s_order_num = 0;
+
+/**
+ * @brief 记录自己的执行顺序
+ *
+ * @param task 任务对象
+ */
+static void task_record(xf_task_t task)
+{
+    char name = (char)(uintptr_t)xf_task_get_arg(task);
+    if (s_order_num < (int)sizeof(s_order) - 1)
+    {
+        s_order[s_order_num++] = name;
+    }
+}
+
+int main()
+{
+    // 对接时间戳
+    xf_task_tick_init(task_get_tick);
+    // 初始化默认任务管理器，例程按时间运行，空闲时直接返回继续轮询
+    xf_task_manager_default_init(NULL);
+
+    // 一个已经到期的周期任务，下一次扫描阻塞队列时就会就绪
+    xf_ntask_create_loop(task_record, (void *)'P', 0, 1);
+    usleep(5 * 1000);
+
+    // 连续设置多个紧急任务，不需要 force，全部按先后顺序排队
+    xf_task_t urgent[URGENT_NUM];
+    for (int i = 0; i < URGENT_NUM; i++)
+    {
+        urgent[i] = xf_ntask_create(task_record, (void *)(uintptr_t)('1' + i), 10, 0, XF_NTASK_INFINITE_LOOP);
+        assert(xf_task_set_urgent_task(urgent[i], false) == XF_OK);
+    }
+
+    // 每次调度执行一个紧急任务，全部执行完之前不处理阻塞队列
+    for (int i = 0; i < URGENT_NUM + 1; i++)
+    {
+        xf_task_manager_run_default();
+    }
+    s_order[s_order_num] = '\0';
+    printf("order:%s\n", s_order);
+    assert(s_order_num == URGENT_NUM + 1);
+    for (int i = 0; i < URGENT_NUM; i++)
+    {
+        assert(s_order[i] == '1' + i);
+    }
+    assert(s_order[URGENT_NUM] == 'P');
+
+    // 队列满时才会设置失败
+    for (int i = 0; i < XF_TASK_URGENT_QUEUE_SIZE; i++)
+    {
+        assert(xf_task_set_urgent_task(urgent[i % URGENT_NUM], false) == XF_OK);
+    }
+    assert(xf_task_set_urgent_task(urgent[0], true) == XF_ERR_BUSY);
+    s_order_num = 0;
+    for (int i = 0; i < XF_TASK_URGENT_QUEUE_SIZE; i++)
+    {
+        xf_task_manager_run_default();
+    }
+    s_order[s_order_num] = '\0';
+    printf("order:%s\n", s_order);
+    assert(s_order_num == XF_TASK_URGENT_QUEUE_SIZE);
+
+    // 已被删除的任务在取出时直接丢弃
+    assert(xf_task_set_urgent_task(urgent[0], false) == XF_OK);
+    assert(xf_task_set_urgent_task(urgent[1], false) == XF_OK);
+    xf_task_delete(urgent[0]);
+    s_order_num = 0;
+    xf_task_manager_run_default();
+    assert(s_order_num == 1 && s_order[0] == '2');
+
+    printf("urgent_queue ok\n");
+    return 0;
+}
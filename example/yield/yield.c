@@ -0,0 +1,84 @@
+#include "xf_task.h"
+#include "port.h"
+#include <assert.h>
+#include <stdio.h>
+
+#define STEP_NUM    100
+#define STEP_EVENT  10
+
+static xf_task_t s_urgent = NULL;
+static int s_step = 0;
+static int s_urgent_step = -1;
+
+/**
+ * @brief 高优先级事件任务，记录自己执行时长循环进行到了哪一步
+ *
+ * @param task 任务对象
+ */
+static void task_urgent(xf_task_t task)
+{
+    printf("urgent run at step:%d\n", s_step);
+    s_urgent_step = s_step;
+}
+
+/**
+ * @brief 低优先级的长循环，每一步检查是否需要让出 CPU
+ *
+ * @param task 任务对象
+ */
+static void task_long(xf_task_t task)
+{
+    XF_NTASK_BEGIN(task);
+
+    // 让出后局部变量不会保留，循环变量放在静态变量中
+    while (s_step < STEP_NUM)
+    {
+        s_step++;
+        if (s_step == STEP_EVENT)
+        {
+            // 循环中途有高优先级任务就绪
+            xf_task_trigger(s_urgent);
+        }
+        XF_NTASK_YIELD_IF_NEEDED();
+    }
+    printf("long done at step:%d\n", s_step);
+
+    XF_NTASK_END();
+}
+
+/**
+ * @brief 运行默认任务管理器一段时间
+ *
+ * @param ms 运行时间，单位为 ms
+ */
+static void run_for(xf_task_time_t ms)
+{
+    xf_task_time_t start = task_get_tick();
+    while (task_get_tick() - start < ms)
+    {
+        xf_task_manager_run_default();
+    }
+}
+
+int main()
+{
+    // 对接时间戳
+    xf_task_tick_init(task_get_tick);
+    // 初始化默认任务管理器，例程按时间运行，空闲时直接返回继续轮询
+    xf_task_manager_default_init(NULL);
+
+    s_urgent = xf_ntask_create(task_urgent, NULL, 1, 0, 1);
+    xf_task_trigger(xf_ntask_create(task_long, NULL, 10, 0, 1));
+
+    // 不在任务中调用时总是返回 false
+    assert(!xf_task_should_yield());
+
+    run_for(20);
+
+    // 高优先级任务在触发后的下一次检查就得到执行，而不是等长循环结束
+    assert(s_step == STEP_NUM);
+    assert(s_urgent_step >= STEP_EVENT && s_urgent_step <= STEP_EVENT + 1);
+
+    printf("yield ok\n");
+    return 0;
+}
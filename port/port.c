@@ -13,9 +13,14 @@
 #include "port.h"
 #include <time.h>
 #include <unistd.h>
+#if USE_PTHREAD
+#include <pthread.h>
+#endif
 
 /* ==================== [Defines] =========================================== */
 
+#define PARALLEL_WORKERS_MAX 64
+
 /* ==================== [Typedefs] ========================================== */
 
 #if !XF_TASK_CONTEXT_DISABLE && !USE_GNU_UC
@@ -45,6 +50,23 @@ static xf_context_func_t s_context_func = NULL;
 
 #endif
 
+#if USE_PTHREAD
+
+static void *parallel_thread(void *arg);
+
+static pthread_mutex_t s_parallel_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_parallel_start = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t s_parallel_done = PTHREAD_COND_INITIALIZER;
+static uint32_t s_parallel_threads = 1;     // 已经启动的线程数（包括调用线程）
+static uint32_t s_parallel_workers = 0;     // 本轮参与的线程数
+static uint32_t s_parallel_pending = 0;     // 本轮还未完成的线程数
+static uint32_t s_parallel_round = 0;
+static uint32_t s_parallel_seen[PARALLEL_WORKERS_MAX];  // 每个线程已经处理到的轮次
+static xf_task_parallel_entry_t s_parallel_entry = NULL;
+static void *s_parallel_arg = NULL;
+
+#endif // USE_PTHREAD
+
 /* ==================== [Macros] ============================================ */
 
 /* ==================== [Global Functions] ================================== */
@@ -108,6 +130,42 @@ void task_on_idle(unsigned long int max_idle_ms)
     usleep(max_idle_ms);
 }
 
+#if USE_PTHREAD
+void parallel_run(uint32_t workers, xf_task_parallel_entry_t entry, void *arg)
+{
+    workers = (workers > PARALLEL_WORKERS_MAX) ? PARALLEL_WORKERS_MAX : workers;
+
+    pthread_mutex_lock(&s_parallel_mutex);
+    // 线程按需启动，之后常驻
+    while (s_parallel_threads < workers) {
+        pthread_t thread;
+        // 新线程要参与本轮，轮次在启动前记录
+        s_parallel_seen[s_parallel_threads] = s_parallel_round;
+        if (pthread_create(&thread, NULL, parallel_thread, (void *)(uintptr_t)s_parallel_threads) != 0) {
+            break;
+        }
+        pthread_detach(thread);
+        s_parallel_threads++;
+    }
+    workers = (workers > s_parallel_threads) ? s_parallel_threads : workers;
+    s_parallel_entry = entry;
+    s_parallel_arg = arg;
+    s_parallel_workers = workers;
+    s_parallel_pending = workers - 1;
+    s_parallel_round++;
+    pthread_cond_broadcast(&s_parallel_start);
+    pthread_mutex_unlock(&s_parallel_mutex);
+
+    entry(0, arg);
+
+    pthread_mutex_lock(&s_parallel_mutex);
+    while (s_parallel_pending != 0) {
+        pthread_cond_wait(&s_parallel_done, &s_parallel_mutex);
+    }
+    pthread_mutex_unlock(&s_parallel_mutex);
+}
+#endif // USE_PTHREAD
+
 /* ==================== [Static Functions] ================================== */
 #if !XF_TASK_CONTEXT_DISABLE && !USE_GNU_UC
 static void fcontext(transfer_t arg)
@@ -118,3 +176,34 @@ static void fcontext(transfer_t arg)
 }
 
 #endif // !XF_TASK_CONTEXT_DISABLE
+
+#if USE_PTHREAD
+static void *parallel_thread(void *arg)
+{
+    uint32_t index = (uint32_t)(uintptr_t)arg;
+
+    pthread_mutex_lock(&s_parallel_mutex);
+    while (1) {
+        while (s_parallel_seen[index] == s_parallel_round) {
+            pthread_cond_wait(&s_parallel_start, &s_parallel_mutex);
+        }
+        s_parallel_seen[index] = s_parallel_round;
+        if (index >= s_parallel_workers) {
+            continue;
+        }
+
+        xf_task_parallel_entry_t entry = s_parallel_entry;
+        void *entry_arg = s_parallel_arg;
+        pthread_mutex_unlock(&s_parallel_mutex);
+
+        entry(index, entry_arg);
+
+        pthread_mutex_lock(&s_parallel_mutex);
+        if (--s_parallel_pending == 0) {
+            pthread_cond_signal(&s_parallel_done);
+        }
+    }
+
+    return NULL;
+}
+#endif // USE_PTHREAD
@@ -25,6 +25,10 @@ extern "C" {
 #define USE_GNU_UC 0
 #endif
 
+#ifndef USE_PTHREAD
+#define USE_PTHREAD 1
+#endif
+
 /* ==================== [Typedefs] ========================================== */
 
 /* ==================== [Global Prototypes] ================================= */
@@ -40,6 +44,10 @@ void swap_context(xf_task_manager_t manager, void *old_context, void *new_contex
 xf_task_time_t task_get_tick(void);
 void task_on_idle(unsigned long int max_idle_ms);
 
+#if USE_PTHREAD
+void parallel_run(uint32_t workers, xf_task_parallel_entry_t entry, void *arg);
+#endif // USE_PTHREAD
+
 /* ==================== [Macros] ============================================ */
 
 #ifdef __cplusplus
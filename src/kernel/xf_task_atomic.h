@@ -0,0 +1,71 @@
+/**
+ * @file xf_task_atomic.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_task 内部使用的原子操作（仅 xf_task 内部使用）。
+ *        GCC/Clang 下使用 `__atomic` 内建函数，
+ *        其他编译器退化为 volatile 访问（只适用于单核）。
+ * @version 0.1
+ * @date 2024-08-20
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_TASK_ATOMIC_H__
+#define __XF_TASK_ATOMIC_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "../xf_task_config_internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/* ==================== [Macros] ============================================ */
+
+#if defined(__GNUC__) || defined(__clang__)
+
+/**
+ * @brief 以 acquire 语义读取。
+ */
+#define XF_TASK_ATOMIC_LOAD(ptr)            __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+
+/**
+ * @brief 以 release 语义写入。
+ */
+#define XF_TASK_ATOMIC_STORE(ptr, val)      __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+
+/**
+ * @brief 比较并交换，成功返回 true；失败返回 false 并把当前值写回 *expected.
+ */
+#define XF_TASK_ATOMIC_CAS(ptr, expected, desired) \
+    __atomic_compare_exchange_n((ptr), (expected), (desired), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+
+/**
+ * @brief 原子加，返回加之前的值。
+ */
+#define XF_TASK_ATOMIC_FETCH_ADD(ptr, val)  __atomic_fetch_add((ptr), (val), __ATOMIC_ACQ_REL)
+
+#else
+
+/* 退化实现依赖被访问的变量声明为 volatile */
+#define XF_TASK_ATOMIC_LOAD(ptr)            (*(ptr))
+#define XF_TASK_ATOMIC_STORE(ptr, val)      (*(ptr) = (val))
+#define XF_TASK_ATOMIC_CAS(ptr, expected, desired) \
+    ((*(ptr) == *(expected)) ? ((*(ptr) = (desired)), true) : ((*(expected) = *(ptr)), false))
+#define XF_TASK_ATOMIC_FETCH_ADD(ptr, val)  ((*(ptr) += (val)) - (val))
+
+#endif
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // __XF_TASK_ATOMIC_H__
@@ -14,6 +14,8 @@
 #include "xf_task_base.h"
 #include "xf_task.h"
 #include "xf_task_manager.h"
+#include "xf_task_probe.h"
+#include "../port/xf_task_port_internal.h"
 
 /* ==================== [Defines] =========================================== */
 
@@ -23,9 +25,19 @@
 
 /* ==================== [Static Prototypes] ================================= */
 
+#if XF_TASK_STATS_IS_ENABLE
+static void xf_task_stats_transit(xf_task_base_t *base, xf_task_state_t state);
+#endif // XF_TASK_STATS_IS_ENABLE
+
 /* ==================== [Static Variables] ================================== */
 
+#if XF_TASK_COMPACT_IS_ENABLE
+// 紧凑布局下调度器通过 XF_TASK_VFUNC 与 XF_TASK_DELETE 直接查表
+const xf_task_vfunc_t *_xf_task_vfunc_group[_XF_TASK_TYPE_MAX] = {0};
+xf_task_delete_t _xf_task_delete_group[XF_TASK_DELETE_TYPES] = {xf_task_destructor, xf_task_static_destructor};
+#else
 static const xf_task_vfunc_t *_xf_task_vfunc_group[_XF_TASK_TYPE_MAX] = {0};
+#endif // XF_TASK_COMPACT_IS_ENABLE
 
 /* ==================== [Macros] ============================================ */
 
@@ -73,8 +85,22 @@ void xf_task_base_init(xf_task_base_t *task_base, xf_task_manager_t manager, xf_
     task_base->suspend_time = 0;
     task_base->timeout = 0;
     task_base->state = XF_TASK_STATE_BLOCKED;
+#if XF_TASK_COMPACT_IS_ENABLE
+    task_base->delete_id = 0;
+#else
     task_base->vfunc = _xf_task_vfunc_group[type];
-    task_base->delete = xf_task_destructor;
+    task_base->on_delete = xf_task_destructor;
+#endif // XF_TASK_COMPACT_IS_ENABLE
+#if XF_TASK_DEADLINE_IS_ENABLE
+    task_base->deadline = NULL;
+#endif // XF_TASK_DEADLINE_IS_ENABLE
+#if XF_TASK_FAIR_IS_ENABLE
+    task_base->fair = NULL;
+#endif // XF_TASK_FAIR_IS_ENABLE
+#if XF_TASK_STATS_IS_ENABLE
+    xf_memset(&task_base->stats, 0, sizeof(xf_task_stats_t));
+    task_base->stats.since = xf_task_get_ticks();
+#endif // XF_TASK_STATS_IS_ENABLE
     xf_list_init(&task_base->node);
     xf_task_manager_task_blocked(manager, task_base);
 #if XF_TASK_HUNGER_IS_ENABLE
@@ -84,6 +110,7 @@ void xf_task_base_init(xf_task_base_t *task_base, xf_task_manager_t manager, xf_
 #if XF_TASK_USER_DATA_IS_ENABLE
     task_base->user_data = NULL;
 #endif
+    XF_TASK_PROBE3(task__create, task_base, type, priority);
 }
 
 void xf_task_base_reset(xf_task_base_t *task_base)
@@ -108,6 +135,7 @@ xf_err_t xf_task_base_set_state(xf_task_t task, xf_task_state_t state)
     xf_task_base_t *base = (xf_task_base_t *)task;
 
     if (state == XF_TASK_STATE_DELETE) {
+        XF_TASK_PROBE3(task__state, base, (int)base->state, (int)state);
         base->state = XF_TASK_STATE_DELETE;
         return XF_OK;
     }
@@ -127,17 +155,70 @@ xf_err_t xf_task_base_set_state(xf_task_t task, xf_task_state_t state)
         }
     }
 
+#if XF_TASK_STATS_IS_ENABLE
+    xf_task_stats_transit(base, state);
+#endif // XF_TASK_STATS_IS_ENABLE
+
+    XF_TASK_PROBE3(task__state, base, (int)base->state, (int)state);
     base->state = state;
 
     return XF_OK;
 }
 
+xf_err_t xf_task_base_set_delete(xf_task_base_t *task_base, xf_task_delete_t on_delete)
+{
+#if XF_TASK_COMPACT_IS_ENABLE
+    // 删除函数只有少数几种，按地址查找已有的索引，没有则占用一个空位
+    for (uint8_t i = 0; i < XF_TASK_DELETE_TYPES; i++) {
+        if (_xf_task_delete_group[i] == NULL) {
+            _xf_task_delete_group[i] = on_delete;
+        }
+        if (_xf_task_delete_group[i] == on_delete) {
+            task_base->delete_id = i;
+            return XF_OK;
+        }
+    }
+
+    XF_LOGE(TAG, "delete table is full, increase XF_TASK_DELETE_TYPES");
+    return XF_ERR_NO_MEM;
+#else
+    task_base->on_delete = on_delete;
+    return XF_OK;
+#endif // XF_TASK_COMPACT_IS_ENABLE
+}
+
 void xf_task_destructor(xf_task_t task)
 {
     xf_free(task);
     XF_LOGD(TAG, "task was delete");
 }
 
+void xf_task_static_destructor(xf_task_t task)
+{
+    XF_LOGD(TAG, "static task was delete");
+}
+
 /* ==================== [Static Functions] ================================== */
 
+#if XF_TASK_STATS_IS_ENABLE
+
+static void xf_task_stats_transit(xf_task_base_t *base, xf_task_state_t state)
+{
+    if (base->state == state) {
+        return;
+    }
+
+    xf_task_time_t ticks = xf_task_get_ticks();
+
+    // 离开阻塞状态时累计阻塞时间
+    if (base->state == XF_TASK_STATE_BLOCKED) {
+        base->stats.blocked_total += ticks - base->stats.since;
+    }
+
+    // 就绪等待时间在开始执行时计算
+    if (state == XF_TASK_STATE_READY || state == XF_TASK_STATE_BLOCKED) {
+        base->stats.since = ticks;
+    }
+}
 
+#endif // XF_TASK_STATS_IS_ENABLE
@@ -105,14 +105,53 @@ typedef struct _xf_task_vfunc_t {
     const xf_task_exec_t exec;          /*!< 执行任务虚函数 */
 } xf_task_vfunc_t;
 
+#if XF_TASK_DEADLINE_IS_ENABLE || XF_TASK_FAIR_IS_ENABLE
+/**
+ * @brief 调度堆节点，manager 中截止时间任务与公平调度任务按 key 从小到大排列。
+ */
+typedef struct _xf_task_heap_node_t {
+    xf_task_time_t key;             /*!< 排序键，按差值比较，允许计数回绕 */
+    uint32_t index;                 /*!< 在堆中的位置，不在堆中时为 UINT32_MAX */
+    struct _xf_task_base_t *task;   /*!< 节点所属任务 */
+} xf_task_heap_node_t;
+#endif // XF_TASK_DEADLINE_IS_ENABLE || XF_TASK_FAIR_IS_ENABLE
+
+#if XF_TASK_DEADLINE_IS_ENABLE
+/**
+ * @brief 截止时间调度参数，设置后任务按截止时间调度，不再参与优先级调度。
+ */
+typedef struct _xf_task_deadline_t {
+    uint32_t wcet;                  /*!< 最坏执行时间，单位为 ms */
+    uint32_t period;                /*!< 周期，单位为 ms */
+    uint32_t relative;              /*!< 相对截止时间，单位为 ms */
+    uint32_t density;               /*!< 准入时占用的利用率，单位为千分之一 */
+    uint32_t miss;                  /*!< 错过截止时间的次数 */
+    bool active;                    /*!< 当前作业已释放且尚未完成，期间的唤醒不重新计算截止时间 */
+    bool missed;                    /*!< 当前作业已经记为错过，每个作业最多记一次 */
+    xf_task_heap_node_t heap;       /*!< key 为当前作业的绝对截止时间 */
+} xf_task_deadline_t;
+#endif // XF_TASK_DEADLINE_IS_ENABLE
+
+#if XF_TASK_FAIR_IS_ENABLE
+/**
+ * @brief 加权公平调度参数，设置后任务按虚拟运行时间调度，不再参与优先级调度。
+ */
+typedef struct _xf_task_fair_t {
+    uint32_t weight;                /*!< 权重，参考 @ref XF_TASK_FAIR_WEIGHT_BASE */
+    xf_task_heap_node_t heap;       /*!< key 为虚拟运行时间，单位为 1/1024 tick */
+} xf_task_fair_t;
+#endif // XF_TASK_FAIR_IS_ENABLE
+
 /**
  * @brief task 的父对象，保存了 task 的公共属性。
+ *
+ * 调度器扫描阻塞队列时访问的字段放在最前面，其余字段放在后面，
+ * 这样扫描时每个任务只需要读取开头的一小段内存。
+ * 打开 XF_TASK_COMPACT_ENABLE 后，这一段在 32 位时间戳下不超过 32 字节（编译时检查），
+ * 虚函数与删除函数也改为按类型与索引查表，64 位平台上不含可选字段时整个对象为 64 字节。
  */
 typedef struct _xf_task_base_t {
     xf_list_t node;                 /*!< 任务节点，挂载在 manager 上 */
-    xf_task_manager_t manager;      /*!< 保存 task 所属的 manager ，以便更快访问 manager */
-    xf_task_func_t func;            /*!< 每个任务所执行的内容 */
-    void *arg;                      /*!< 任务中用户定义参数 */
     uint32_t type:      1;          /*!< 任务类型，见 @ref xf_task_type_t */
     uint32_t state:     3;          /*!< 任务状态，见 @ref xf_task_state_t */
     uint32_t flag:      9;          /*!< 任务标志位，外部设置的标志位，内部只会读取不会设置 */
@@ -121,12 +160,20 @@ typedef struct _xf_task_base_t {
     uint32_t priority:  10;         /*!< 任务优先级，具体最大值参考 @ref XF_TASK_PRIORITY_LEVELS */
     uint32_t delay;                 /*!< 对类型于有上下文是延时时间，对于没有上下文则是定时周期  */
     xf_task_time_t weakup;          /*!< 唤醒时间，通过延时时间计算而来 */
-    xf_task_time_t suspend_time;    /*!< 挂起时间，挂起期间内的时间不会算入延时时间 */
     int32_t timeout;                /*!< 超时时间，正数为超时时间，负数则属于提前唤醒 */
+
+    xf_task_manager_t manager;      /*!< 保存 task 所属的 manager ，以便更快访问 manager */
+    xf_task_func_t func;            /*!< 每个任务所执行的内容 */
+    void *arg;                      /*!< 任务中用户定义参数 */
+    xf_task_time_t suspend_time;    /*!< 挂起时间，挂起期间内的时间不会算入延时时间 */
+#if XF_TASK_COMPACT_IS_ENABLE
+    uint8_t delete_id;              /*!< 删除函数在删除函数表中的索引，虚函数则直接按 type 查表 */
+#else
     const xf_task_vfunc_t *vfunc;   /*!< 虚函数指针，由子对象实现具体操作。
                                      *   虚函数指针是实现不同类型任务统一调度的关键 */
-    xf_task_delete_t delete;        /*!< 虚函数指针，其内容通常为回收任务内存
+    xf_task_delete_t on_delete;     /*!< 虚函数指针，其内容通常为回收任务内存
                                      *   task pool 中通过替换它实现任务池回收任务 */
+#endif // XF_TASK_COMPACT_IS_ENABLE
 
 #if XF_TASK_HUNGER_IS_ENABLE
     xf_list_t hunger_node;          /*!< 饥饿节点，挂载在 manager 上的 hunger_list 上，
@@ -134,12 +181,32 @@ typedef struct _xf_task_base_t {
     uint32_t hunger_time;           /*!< 任务饥饿度，单位为 ms。超过该时间，任务爬升一个优先级 */
 #endif
 
+#if XF_TASK_DEADLINE_IS_ENABLE
+    xf_task_deadline_t *deadline;   /*!< 截止时间调度参数，为 NULL 则按优先级调度 */
+#endif // XF_TASK_DEADLINE_IS_ENABLE
+
+#if XF_TASK_FAIR_IS_ENABLE
+    xf_task_fair_t *fair;           /*!< 公平调度参数，为 NULL 则按优先级调度 */
+#endif // XF_TASK_FAIR_IS_ENABLE
+
+#if XF_TASK_STATS_IS_ENABLE
+    xf_task_stats_t stats;          /*!< 任务运行统计 */
+#endif // XF_TASK_STATS_IS_ENABLE
+
 #if XF_TASK_USER_DATA_IS_ENABLE
     void *user_data;                /*!< 用户传递的参数 */
 #endif // XF_TASK_USER_DATA_IS_ENABLE
 
 } xf_task_base_t;
 
+#if XF_TASK_COMPACT_IS_ENABLE
+// 热数据超过 32 字节时这里编译报错，通常是 XF_TASK_TIME_TYPE 被设置成了 64 位
+typedef char xf_task_base_hot_check_t[(offsetof(xf_task_base_t, manager) <= 32) ? 1 : -1];
+
+extern const xf_task_vfunc_t *_xf_task_vfunc_group[_XF_TASK_TYPE_MAX];
+extern xf_task_delete_t _xf_task_delete_group[XF_TASK_DELETE_TYPES];
+#endif // XF_TASK_COMPACT_IS_ENABLE
+
 /* ==================== [Global Prototypes] ================================= */
 
 /**
@@ -203,6 +270,20 @@ void xf_task_base_init(xf_task_base_t *task_base, xf_task_manager_t manager, xf_
  */
 void xf_task_base_reset(xf_task_base_t *task_base);
 
+/**
+ * @brief 设置任务的删除函数，任务池等通过替换它回收任务。
+ *
+ * @note 紧凑布局下删除函数保存在全局的删除函数表中，
+ *       不同的删除函数最多 XF_TASK_DELETE_TYPES 个，超出时保持原来的删除函数。
+ *
+ * @param task_base task base 对象。
+ * @param on_delete 删除函数。
+ * @return xf_err_t
+ *      - XF_ERR_NO_MEM 删除函数表已满
+ *      - XF_OK 设置成功
+ */
+xf_err_t xf_task_base_set_delete(xf_task_base_t *task_base, xf_task_delete_t on_delete);
+
 /**
  * @brief 任务销毁。回收任务资源
  *
@@ -210,8 +291,68 @@ void xf_task_base_reset(xf_task_base_t *task_base);
  */
 void xf_task_destructor(xf_task_t task);
 
+/**
+ * @brief 静态任务销毁。内存由用户提供，不需要回收
+ *
+ * @param task 任务对象
+ */
+void xf_task_static_destructor(xf_task_t task);
+
+/**
+ * @brief xf_task_reg.inc 中注册的任务类型的更新与执行函数，
+ *        命名为 xf_<name>_update 与 xf_<name>_exec ，直接分派时由调度器调用。
+ */
+#define XF_TASK_REG_DISPATCH_EXTERN
+#include "../task/xf_task_reg.inc"
+
 /* ==================== [Macros] ============================================ */
 
+/**
+ * @brief 获取任务的虚函数表与删除函数，紧凑布局下按类型与索引查表。
+ */
+#if XF_TASK_COMPACT_IS_ENABLE
+#define XF_TASK_VFUNC(task)     (_xf_task_vfunc_group[(task)->type])
+#define XF_TASK_DELETE(task)    (_xf_task_delete_group[(task)->delete_id])
+#else
+#define XF_TASK_VFUNC(task)     ((task)->vfunc)
+#define XF_TASK_DELETE(task)    ((task)->on_delete)
+#endif // XF_TASK_COMPACT_IS_ENABLE
+
+#if XF_TASK_DIRECT_DISPATCH_IS_ENABLE
+
+static inline xf_task_time_t xf_task_dispatch_update(xf_task_base_t *task)
+{
+    switch (task->type) {
+#define XF_TASK_REG_UPDATE_CASE
+#include "../task/xf_task_reg.inc"
+    default:
+        return XF_TASK_VFUNC(task)->update(task);
+    }
+}
+
+static inline void xf_task_dispatch_exec(xf_task_base_t *task, xf_task_manager_t manager)
+{
+    switch (task->type) {
+#define XF_TASK_REG_EXEC_CASE
+#include "../task/xf_task_reg.inc"
+    default:
+        XF_TASK_VFUNC(task)->exec(manager);
+    }
+}
+
+#endif // XF_TASK_DIRECT_DISPATCH_IS_ENABLE
+
+/**
+ * @brief 调度器更新与执行任务，直接分派时按类型 switch 调用，没有间接调用。
+ */
+#if XF_TASK_DIRECT_DISPATCH_IS_ENABLE
+#define XF_TASK_UPDATE(task)            xf_task_dispatch_update(task)
+#define XF_TASK_EXEC(task, manager)     xf_task_dispatch_exec(task, manager)
+#else
+#define XF_TASK_UPDATE(task)            (XF_TASK_VFUNC(task)->update(task))
+#define XF_TASK_EXEC(task, manager)     (XF_TASK_VFUNC(task)->exec(manager))
+#endif // XF_TASK_DIRECT_DISPATCH_IS_ENABLE
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -60,7 +60,7 @@ void xf_task_reset(xf_task_t task)
 
     xf_task_base_t *handle = (xf_task_base_t *)task;
 
-    handle->vfunc->reset(task);
+    XF_TASK_VFUNC(handle)->reset(task);
 }
 
 void *xf_task_get_arg(xf_task_t task)
@@ -143,6 +143,9 @@ xf_err_t xf_task_resume(xf_task_t task)
     xf_task_time_t resume_time = xf_task_get_ticks() - task_base->suspend_time;
 
     task_base->weakup += resume_time;
+#if XF_TASK_YIELD_CHECK_IS_ENABLE
+    xf_task_manager_check_preempt(manager, task);
+#endif // XF_TASK_YIELD_CHECK_IS_ENABLE
 
     return XF_OK;
 }
@@ -153,6 +156,15 @@ xf_err_t xf_task_trigger(xf_task_t task)
     xf_task_base_t *handle = (xf_task_base_t *)task;
 
     BITS_SET1(handle->signal, XF_TASK_SIGNAL_EVENT);
+#if XF_TASK_NTASK_FAST_IS_ENABLE
+    xf_task_manager_task_event(handle->manager);
+#endif // XF_TASK_NTASK_FAST_IS_ENABLE
+#if XF_TASK_TRACE_IS_ENABLE
+    xf_task_trace_record(handle->manager, XF_TASK_TRACE_TRIGGER, task, 0, 0);
+#endif // XF_TASK_TRACE_IS_ENABLE
+#if XF_TASK_YIELD_CHECK_IS_ENABLE
+    xf_task_manager_check_preempt(handle->manager, task);
+#endif // XF_TASK_YIELD_CHECK_IS_ENABLE
 
     return XF_OK;
 }
@@ -204,6 +216,12 @@ xf_err_t xf_task_set_delay(xf_task_t task, uint32_t delay_ms)
     XF_ASSERT(task, XF_ERR_INVALID_ARG, TAG, "task must not be NULL");
     xf_task_base_t *handle = (xf_task_base_t *)task;
 
+#if XF_TASK_NTASK_FAST_IS_ENABLE
+    // 事件队列中的任务改为周期任务，移回阻塞队列
+    if (handle->delay == 0 && delay_ms != 0 && handle->state == XF_TASK_STATE_BLOCKED) {
+        xf_task_manager_task_blocked(handle->manager, task);
+    }
+#endif // XF_TASK_NTASK_FAST_IS_ENABLE
     handle->delay = delay_ms;
 
     return XF_OK;
@@ -15,6 +15,7 @@
 /* ==================== [Includes] ========================================== */
 
 #include "xf_task_manager.h"
+#include "xf_task_trace.h"
 
 /**
  * @ingroup group_xf_task_user
@@ -46,6 +46,168 @@ extern "C" {
 #   define XF_TASK_HUNGER_IS_ENABLE (0)
 #endif
 
+/**
+ * @brief 每个任务管理器紧急任务队列的长度，必须是 2 的幂。
+ */
+#ifndef XF_TASK_URGENT_QUEUE_SIZE
+#   define XF_TASK_URGENT_QUEUE_SIZE (8)
+#endif
+
+#if (XF_TASK_URGENT_QUEUE_SIZE < 1) || (XF_TASK_URGENT_QUEUE_SIZE & (XF_TASK_URGENT_QUEUE_SIZE - 1))
+#   error "XF_TASK_URGENT_QUEUE_SIZE must be a power of 2"
+#endif
+
+/**
+ * @brief 配置是否启用协作式让出检查（xf_task_should_yield），默认关闭。
+ */
+#if defined(XF_TASK_YIELD_CHECK_ENABLE) && (XF_TASK_YIELD_CHECK_ENABLE)
+#   define XF_TASK_YIELD_CHECK_IS_ENABLE (1)
+#else
+#   define XF_TASK_YIELD_CHECK_IS_ENABLE (0)
+#endif
+
+/**
+ * @brief 任务时间片，单位为毫秒。任务单次连续执行超过该时间后 xf_task_should_yield 返回 true, 为 0 则不检查时间片。
+ */
+#ifndef XF_TASK_TIME_SLICE_MS
+#   define XF_TASK_TIME_SLICE_MS (10)
+#endif
+
+/**
+ * @brief 配置是否启用截止时间（EDF）调度，默认关闭。
+ */
+#if defined(XF_TASK_DEADLINE_ENABLE) && (XF_TASK_DEADLINE_ENABLE)
+#   define XF_TASK_DEADLINE_IS_ENABLE (1)
+#else
+#   define XF_TASK_DEADLINE_IS_ENABLE (0)
+#endif
+
+/**
+ * @brief 每个任务管理器最多的截止时间任务数。
+ */
+#ifndef XF_TASK_DEADLINE_MAX_TASKS
+#   define XF_TASK_DEADLINE_MAX_TASKS (16)
+#endif
+
+/**
+ * @brief 截止时间任务的利用率上限，单位为千分之一，准入时所有任务 wcet / min(period, deadline) 之和不能超过它。
+ */
+#ifndef XF_TASK_DEADLINE_UTILIZATION_MAX
+#   define XF_TASK_DEADLINE_UTILIZATION_MAX (1000)
+#endif
+
+/**
+ * @brief 配置是否启用加权公平调度，默认关闭。
+ */
+#if defined(XF_TASK_FAIR_ENABLE) && (XF_TASK_FAIR_ENABLE)
+#   define XF_TASK_FAIR_IS_ENABLE (1)
+#else
+#   define XF_TASK_FAIR_IS_ENABLE (0)
+#endif
+
+/**
+ * @brief 每个任务管理器最多的公平调度任务数。
+ */
+#ifndef XF_TASK_FAIR_MAX_TASKS
+#   define XF_TASK_FAIR_MAX_TASKS (16)
+#endif
+
+/**
+ * @brief 公平调度的基准权重，权重为该值时虚拟运行时间等于实际运行时间。
+ */
+#ifndef XF_TASK_FAIR_WEIGHT_BASE
+#   define XF_TASK_FAIR_WEIGHT_BASE (1024)
+#endif
+
+/**
+ * @brief 配置是否启用任务运行统计（执行时间、就绪等待时间、调度次数等），默认关闭。
+ */
+#if defined(XF_TASK_STATS_ENABLE) && (XF_TASK_STATS_ENABLE)
+#   define XF_TASK_STATS_IS_ENABLE (1)
+#else
+#   define XF_TASK_STATS_IS_ENABLE (0)
+#endif
+
+/**
+ * @brief 配置是否启用调度跟踪（记录调度事件到环形缓冲区，可导出为 Chrome trace），默认关闭。
+ */
+#if defined(XF_TASK_TRACE_ENABLE) && (XF_TASK_TRACE_ENABLE)
+#   define XF_TASK_TRACE_IS_ENABLE (1)
+#else
+#   define XF_TASK_TRACE_IS_ENABLE (0)
+#endif
+
+/**
+ * @brief 每个任务管理器调度跟踪环形缓冲区的事件数，必须是 2 的幂。
+ */
+#ifndef XF_TASK_TRACE_BUFFER_SIZE
+#   define XF_TASK_TRACE_BUFFER_SIZE (256)
+#endif
+
+#if (XF_TASK_TRACE_BUFFER_SIZE < 1) || (XF_TASK_TRACE_BUFFER_SIZE & (XF_TASK_TRACE_BUFFER_SIZE - 1))
+#   error "XF_TASK_TRACE_BUFFER_SIZE must be a power of 2"
+#endif
+
+/**
+ * @brief 配置是否启用 USDT 静态探针（需要 sys/sdt.h，可用 perf 或 bpftrace 观察），默认关闭。
+ */
+#if defined(XF_TASK_USDT_ENABLE) && (XF_TASK_USDT_ENABLE)
+#   define XF_TASK_USDT_IS_ENABLE (1)
+#else
+#   define XF_TASK_USDT_IS_ENABLE (0)
+#endif
+
+/**
+ * @brief 配置是否启用紧凑的任务布局，默认关闭。
+ *
+ * 时间戳默认改为 32 位（所有比较都按差值进行，允许回绕），虚函数与删除函数改为查表，
+ * 减少调度器扫描大量任务时的缓存占用。
+ */
+#if defined(XF_TASK_COMPACT_ENABLE) && (XF_TASK_COMPACT_ENABLE)
+#   define XF_TASK_COMPACT_IS_ENABLE (1)
+#else
+#   define XF_TASK_COMPACT_IS_ENABLE (0)
+#endif
+
+/**
+ * @brief 紧凑布局下删除函数表的大小，即不同删除函数的最大个数。
+ *
+ * 默认的删除函数与静态任务的删除函数固定占用前两个。
+ */
+#ifndef XF_TASK_DELETE_TYPES
+#   define XF_TASK_DELETE_TYPES (4)
+#endif
+
+/**
+ * @brief 配置是否启用直接分派，默认关闭。
+ *
+ * 调度器按任务类型 switch 直接调用 xf_task_reg.inc 中注册的更新与执行函数，
+ * 不再经过虚函数表，此时 xf_task_vfunc_register 替换的 update 与 exec 不会生效。
+ * 启用 XF_TASK_NTASK_FAST_ENABLE 时同时启用。
+ */
+#if (defined(XF_TASK_DIRECT_DISPATCH_ENABLE) && (XF_TASK_DIRECT_DISPATCH_ENABLE)) \
+    || (defined(XF_TASK_NTASK_FAST_ENABLE) && (XF_TASK_NTASK_FAST_ENABLE))
+#   define XF_TASK_DIRECT_DISPATCH_IS_ENABLE (1)
+#else
+#   define XF_TASK_DIRECT_DISPATCH_IS_ENABLE (0)
+#endif
+
+/**
+ * @brief 配置是否启用 ntask 专用的快速扫描，默认关闭，需要同时关闭 ctask （XF_TASK_CONTEXT_DISABLE）。
+ *
+ * 每次调度只读取一次时钟，阻塞任务的超时判断内联在扫描中，不再调用任务的更新函数；
+ * 周期为 0 、只靠事件触发的 ntask 放在单独的事件队列中，只有调用过 xf_task_trigger 才扫描。
+ * 接口与行为不变，只是同一次扫描中同时就绪的同优先级任务，先后顺序可能与关闭时不同。
+ */
+#if defined(XF_TASK_NTASK_FAST_ENABLE) && (XF_TASK_NTASK_FAST_ENABLE)
+#   if XF_TASK_CONTEXT_IS_ENABLE
+#       error "XF_TASK_NTASK_FAST_ENABLE requires XF_TASK_CONTEXT_DISABLE"
+#   endif
+#   define XF_TASK_NTASK_FAST_IS_ENABLE (1)
+#else
+#   define XF_TASK_NTASK_FAST_IS_ENABLE (0)
+#endif
+
 /**
  * @brief 配置是否使用任务用户参数。
  */
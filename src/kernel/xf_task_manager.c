@@ -14,36 +14,69 @@
 #include "xf_task_kernel_config.h"
 #include "../port/xf_task_port_internal.h"
 #include "xf_task_manager.h"
+#include "xf_task_manager_internal.h"
 #include "xf_task_base.h"
+#include "xf_task_atomic.h"
+#include "xf_task_probe.h"
 #include "xf_utils.h"
+#if XF_TASK_NTASK_FAST_IS_ENABLE
+#include "../task/xf_ntask_internal.h"
+#endif // XF_TASK_NTASK_FAST_IS_ENABLE
 
 /* ==================== [Defines] =========================================== */
 
 #define TAG "manager"
 
-/* ==================== [Typedefs] ========================================== */
+#define HEAP_NOT_QUEUED (UINT32_MAX)        // 任务不在调度堆中
+#define VRUNTIME_SCALE (1024)               // 虚拟运行时间的单位为 1/1024 tick，避免权重较大时累加值被截断为 0
 
-typedef struct _xf_task_manager_handle_t {
-    xf_task_t current_task;                         /*!< 当前执行任务 */
-    xf_task_t urgent_task;                          /*!< 紧急任务 */
-    xf_list_t ready_list[XF_TASK_PRIORITY_LEVELS];  /*!< 任务就绪队列 */
-    xf_list_t blocked_list;                         /*!< 任务阻塞队列 */
-    xf_list_t suspend_list;                         /*!< 任务挂起队列，挂起任务不参与调度，需要手动恢复 */
-    xf_list_t destroy_list;                         /*!< 任务销毁队列，进行异步销毁 */
-    xf_task_on_idle_t on_idle;                      /*!< 空闲任务回调 */
-#if XF_TASK_HUNGER_IS_ENABLE
-    xf_list_t hunger_list;                          /*!< 任务饥饿队列，达到其指定值进行跳跃 */
-#endif // XF_TASK_HUNGER_IS_ENABLE
-#if XF_TASK_CONTEXT_IS_ENABLE
-    xf_task_context_t context;                      /*!< 调度器上下文 */
-#endif // XF_TASK_CONTEXT_IS_ENABLE
-} xf_task_manager_handle_t;
+#if XF_TASK_DEADLINE_IS_ENABLE
+#define XF_TASK_IS_DEADLINE(task) ((task)->deadline != NULL)
+#else
+#define XF_TASK_IS_DEADLINE(task) (0)
+#endif // XF_TASK_DEADLINE_IS_ENABLE
+
+#if XF_TASK_FAIR_IS_ENABLE
+#define XF_TASK_IS_FAIR(task) ((task)->fair != NULL)
+#else
+#define XF_TASK_IS_FAIR(task) (0)
+#endif // XF_TASK_FAIR_IS_ENABLE
 
+/* ==================== [Typedefs] ========================================== */
 
 /* ==================== [Static Prototypes] ================================= */
 
+static void xf_task_manager_init(xf_task_manager_handle_t *manager, xf_task_on_idle_t on_idle, bool is_static);
 static inline void xf_task_run(xf_task_base_t *task);
 static inline void xf_task_update_timeout(xf_task_base_t *task);
+static inline void xf_task_manager_unlink(xf_task_manager_handle_t *manager, xf_task_base_t *task);
+static inline void xf_task_manager_enqueue(xf_task_manager_handle_t *manager, xf_task_base_t *task);
+static inline void xf_task_manager_wakeup(xf_task_manager_handle_t *manager, xf_task_base_t *task);
+#if XF_TASK_DEADLINE_IS_ENABLE || XF_TASK_FAIR_IS_ENABLE
+static inline bool xf_task_time_before(xf_task_time_t a, xf_task_time_t b);
+static void xf_task_heap_push(xf_task_heap_t *heap, xf_task_heap_node_t *node);
+static void xf_task_heap_remove(xf_task_heap_t *heap, xf_task_heap_node_t *node);
+static void xf_task_heap_sift(xf_task_heap_t *heap, uint32_t index);
+#endif // XF_TASK_DEADLINE_IS_ENABLE || XF_TASK_FAIR_IS_ENABLE
+#if XF_TASK_DEADLINE_IS_ENABLE
+static void xf_task_deadline_release(xf_task_base_t *task);
+static void xf_task_deadline_free(xf_task_manager_handle_t *manager, xf_task_base_t *task);
+#endif // XF_TASK_DEADLINE_IS_ENABLE
+#if XF_TASK_FAIR_IS_ENABLE
+static void xf_task_fair_place(xf_task_manager_handle_t *manager, xf_task_base_t *task);
+static void xf_task_fair_charge(xf_task_manager_handle_t *manager, xf_task_base_t *task, xf_task_time_t ticks);
+static void xf_task_fair_free(xf_task_manager_handle_t *manager, xf_task_base_t *task);
+#endif // XF_TASK_FAIR_IS_ENABLE
+#if XF_TASK_YIELD_CHECK_IS_ENABLE
+static inline int32_t xf_task_rank(xf_task_base_t *task);
+#endif // XF_TASK_YIELD_CHECK_IS_ENABLE
+#if XF_TASK_STATS_IS_ENABLE
+static uint32_t xf_task_stats_collect_list(xf_list_t *list, xf_task_stats_entry_t *entries, uint32_t max,
+        uint32_t count);
+static inline uint32_t xf_task_stats_collect(xf_task_base_t *task, xf_task_stats_entry_t *entries, uint32_t max,
+        uint32_t count);
+static void xf_task_stats_ready_depth(xf_task_manager_handle_t *manager);
+#endif // XF_TASK_STATS_IS_ENABLE
 
 /* ==================== [Static Variables] ================================== */
 
@@ -56,19 +89,18 @@ xf_task_manager_t xf_task_manager_create(xf_task_on_idle_t on_idle)
     xf_task_manager_handle_t *manager = (xf_task_manager_handle_t *)xf_malloc(sizeof(xf_task_manager_handle_t));
     XF_ASSERT(manager, NULL, TAG, "memory alloc failed!");
 
-    manager->current_task = NULL;
-    manager->urgent_task = NULL;
-    manager->on_idle = on_idle;
+    xf_task_manager_init(manager, on_idle, false);
 
-    for (size_t i = 0; i < XF_TASK_PRIORITY_LEVELS; i++) {
-        xf_list_init(&manager->ready_list[i]);
-    }
-    xf_list_init(&manager->blocked_list);
-    xf_list_init(&manager->destroy_list);
-    xf_list_init(&manager->suspend_list);
-#if XF_TASK_HUNGER_IS_ENABLE
-    xf_list_init(&manager->hunger_list);
-#endif // XF_TASK_HUNGER_IS_ENABLE
+    return (xf_task_manager_t)manager;
+}
+
+xf_task_manager_t xf_task_manager_create_static(xf_task_on_idle_t on_idle, void *storage)
+{
+    XF_ASSERT(storage, NULL, TAG, "storage must not be NULL!");
+
+    xf_task_manager_handle_t *manager = (xf_task_manager_handle_t *)storage;
+
+    xf_task_manager_init(manager, on_idle, true);
 
     return (xf_task_manager_t)manager;
 }
@@ -86,6 +118,11 @@ xf_err_t xf_task_manager_set_idle(xf_task_manager_t manager, xf_task_on_idle_t o
 void xf_task_manager_delete(xf_task_manager_t manager)
 {
     XF_ASSERT(manager, XF_RETURN_VOID, TAG, "manager must not be NULL!");
+
+    if (((xf_task_manager_handle_t *)manager)->is_static) {
+        return;
+    }
+
     xf_free(manager);
 }
 
@@ -101,23 +138,61 @@ void xf_task_manager_run(xf_task_manager_t manager)
     volatile uint32_t idle_time_ticks = 0;
     volatile bool is_get_func = false;
     xf_task_base_t *task, *_task;
+#if XF_TASK_STATS_IS_ENABLE
+    manager_handle->stats.passes++;
+#endif // XF_TASK_STATS_IS_ENABLE
+
+    // 如果有紧急任务则优先执行紧急任务，并跳过后续调度，延迟与任务总数无关
+    uint32_t urgent_head = manager_handle->urgent_head;
+    while (urgent_head != XF_TASK_ATOMIC_LOAD(&manager_handle->urgent_tail)) {
+        task = (xf_task_base_t *)manager_handle->urgent_queue[urgent_head & (XF_TASK_URGENT_QUEUE_SIZE - 1)];
+        XF_TASK_ATOMIC_STORE(&manager_handle->urgent_head, ++urgent_head);
+        // 已被删除或挂起的任务设置就绪失败，直接丢弃，在进入空闲释放任务前清空
+        if (xf_task_base_set_state(task, XF_TASK_STATE_READY) == XF_OK) {
+#if XF_TASK_DEADLINE_IS_ENABLE
+            if (XF_TASK_IS_DEADLINE(task)) {
+                xf_task_deadline_release(task);
+            }
+#endif // XF_TASK_DEADLINE_IS_ENABLE
+#if XF_TASK_STATS_IS_ENABLE
+            manager_handle->stats.urgent++;
+#endif // XF_TASK_STATS_IS_ENABLE
+            xf_task_run(task);
+            return;
+        }
+    }
+
+#if XF_TASK_STATS_IS_ENABLE
+    xf_task_time_t scan_ticks = xf_task_get_ticks();
+    uint32_t scan_count = 0;
+#endif // XF_TASK_STATS_IS_ENABLE
+
+#if XF_TASK_NTASK_FAST_IS_ENABLE
+    // 只有 ntask ，整个扫描只读取一次时钟
+    xf_task_time_t time_ticks = xf_task_get_ticks();
+#endif // XF_TASK_NTASK_FAST_IS_ENABLE
 
     // 阻塞任务队列处理
     xf_list_for_each_entry_safe(task, _task, &manager_handle->blocked_list, xf_task_base_t, node) {
+#if XF_TASK_STATS_IS_ENABLE
+        scan_count++;
+#endif // XF_TASK_STATS_IS_ENABLE
+#if XF_TASK_NTASK_FAST_IS_ENABLE
+        // 周期为 0 又没有被触发的任务移到事件队列，之后只在有任务被触发时扫描
+        if (task->delay == 0 && !BITS_CHECK(task->signal, XF_TASK_SIGNAL_EVENT)) {
+            xf_list_del_init(&task->node);
+            xf_list_add_tail(&task->node, &manager_handle->event_list);
+            continue;
+        }
+        xf_ntask_update_at((xf_ntask_handle_t *)task, time_ticks);
+#else
         // 更新信号
-        uint32_t time_ticks = task->vfunc->update(task);
+        uint32_t time_ticks = XF_TASK_UPDATE(task);
+#endif // XF_TASK_NTASK_FAST_IS_ENABLE
 
         // 检查信号，如果符合则加入就绪
         if (BITS_CHECK(task->signal, XF_TASK_SIGNAL_READY)) {
-            xf_list_del_init(&task->node);
-            xf_task_base_set_state(task, XF_TASK_STATE_READY); // 设置为就绪态
-            xf_list_add_tail(&task->node, &manager_handle->ready_list[task->priority]);
-            BITS_SET0(task->signal, XF_TASK_SIGNAL_READY);
-#if XF_TASK_HUNGER_IS_ENABLE
-            if (BITS_CHECK(task->flag, XF_TASK_FALG_FEEL_HUNGERY)) {
-                xf_list_add_tail(&task->hunger_node, &manager_handle->hunger_list);
-            }
-#endif // XF_TASK_HUNGER_IS_ENABLE
+            xf_task_manager_wakeup(manager_handle, task);
         }
 
         // 事件触发任务，这里始终等于0，不会被计算进入
@@ -129,17 +204,42 @@ void xf_task_manager_run(xf_task_manager_t manager)
         idle_time_ticks = time_ticks;
     }
 
-    // 如果有紧急任务则优先执行紧急任务，并跳过后续调度
-    if (NULL != manager_handle->urgent_task) {
-        task = (xf_task_base_t *)manager_handle->urgent_task;
-        manager_handle->urgent_task = NULL;
-        xf_task_run(task);
-        return;
+#if XF_TASK_NTASK_FAST_IS_ENABLE
+    // 事件队列中的任务只能被触发，没有任务被触发过时整个跳过
+    if (manager_handle->event_pending) {
+        manager_handle->event_pending = 0;
+        xf_list_for_each_entry_safe(task, _task, &manager_handle->event_list, xf_task_base_t, node) {
+#if XF_TASK_STATS_IS_ENABLE
+            scan_count++;
+#endif // XF_TASK_STATS_IS_ENABLE
+            if (BITS_CHECK(task->signal, XF_TASK_SIGNAL_EVENT)) {
+                BITS_SET0(task->signal, XF_TASK_SIGNAL_EVENT);
+                xf_task_manager_wakeup(manager_handle, task);
+            }
+        }
     }
+#endif // XF_TASK_NTASK_FAST_IS_ENABLE
+
+#if XF_TASK_STATS_IS_ENABLE
+    manager_handle->stats.scan_ticks += xf_task_get_ticks() - scan_ticks;
+    manager_handle->stats.scan_total += scan_count;
+    if (scan_count > manager_handle->stats.scan_max) {
+        manager_handle->stats.scan_max = scan_count;
+    }
+    xf_task_stats_ready_depth(manager_handle);
+#endif // XF_TASK_STATS_IS_ENABLE
+
+#if XF_TASK_DEADLINE_IS_ENABLE
+    // 截止时间任务处于所有优先级之上，截止时间最早的优先执行
+    if (manager_handle->deadline_heap.size != 0) {
+        xf_task_run(manager_handle->deadline_heap.nodes[0]->task);
+        is_get_func = true;
+    }
+#endif // XF_TASK_DEADLINE_IS_ENABLE
 
     // 就绪任务队列处理
     // 这里决定了它的优先级数值越小优先级越高
-    for (index = 0; index < XF_TASK_PRIORITY_LEVELS; index++) {
+    for (index = 0; false == is_get_func && index < XF_TASK_PRIORITY_LEVELS; index++) {
         if (xf_list_empty(&manager_handle->ready_list[index])) {
             continue;
         }
@@ -152,12 +252,20 @@ void xf_task_manager_run(xf_task_manager_t manager)
         }
     }
 
+#if XF_TASK_FAIR_IS_ENABLE
+    // 公平调度任务处于所有优先级之下，虚拟运行时间最小的优先执行
+    if (false == is_get_func && manager_handle->fair_heap.size != 0) {
+        xf_task_run(manager_handle->fair_heap.nodes[0]->task);
+        is_get_func = true;
+    }
+#endif // XF_TASK_FAIR_IS_ENABLE
+
     // 上述循环正常退出，则说明没有就绪任务，运行空闲任务
     if (false == is_get_func) {
         // 空闲时间，处理一下需要删除的任务
         xf_list_for_each_entry_safe(task, _task, &manager_handle->destroy_list, xf_task_base_t, node) {
             xf_list_del_init(&task->node);
-            task->delete (task);
+            XF_TASK_DELETE(task)(task);
         }
         // 进一步修正空闲时间
         xf_task_time_t ticks = xf_task_get_ticks();
@@ -165,7 +273,19 @@ void xf_task_manager_run(xf_task_manager_t manager)
         max_idle_ms = max_idle_ms < 0 ? 0 : max_idle_ms;
         // 执行空闲回调
         if (manager_handle->on_idle != NULL) {
+#if XF_TASK_STATS_IS_ENABLE
+            manager_handle->stats.idle_entries++;
+#endif // XF_TASK_STATS_IS_ENABLE
+#if XF_TASK_TRACE_IS_ENABLE
+            xf_task_trace_record(manager, XF_TASK_TRACE_IDLE_BEGIN, manager, (uint32_t)max_idle_ms, 0);
             manager_handle->on_idle(max_idle_ms);
+            xf_task_trace_record(manager, XF_TASK_TRACE_IDLE_END, manager, 0, 0);
+#else
+            manager_handle->on_idle(max_idle_ms);
+#endif // XF_TASK_TRACE_IS_ENABLE
+#if XF_TASK_STATS_IS_ENABLE
+            manager_handle->stats.idle_ticks += xf_task_get_ticks() - ticks;
+#endif // XF_TASK_STATS_IS_ENABLE
         }
     }
 #if XF_TASK_HUNGER_IS_ENABLE
@@ -184,6 +304,12 @@ void xf_task_manager_run(xf_task_manager_t manager)
                 priority = 0;
             }
 
+#if XF_TASK_STATS_IS_ENABLE
+            if (level != 0) {
+                manager_handle->stats.hunger++;
+            }
+#endif // XF_TASK_STATS_IS_ENABLE
+
             // 重置其优先级
             xf_list_del_init(&task->node);
             xf_list_add(&task->node, &manager_handle->ready_list[priority]);
@@ -210,10 +336,13 @@ xf_err_t xf_task_manager_task_ready(xf_task_manager_t manager, xf_task_t task)
 
     xf_task_base_t *task_base = task;
 
-    xf_list_del_init(&task_base->node);
+    xf_task_manager_unlink(manager_handle, task_base);
 
     xf_task_base_set_state(task, XF_TASK_STATE_READY);
-    xf_list_add_tail(&task_base->node, &manager_handle->ready_list[task_base->priority]);
+    xf_task_manager_enqueue(manager_handle, task_base);
+#if XF_TASK_YIELD_CHECK_IS_ENABLE
+    xf_task_manager_check_preempt(manager, task);
+#endif // XF_TASK_YIELD_CHECK_IS_ENABLE
 
     return XF_OK;
 }
@@ -226,7 +355,7 @@ xf_err_t xf_task_manager_task_suspend(xf_task_manager_t manager, xf_task_t task)
 
     xf_task_base_t *task_base = task;
 
-    xf_list_del_init(&task_base->node);
+    xf_task_manager_unlink(manager_handle, task_base);
 
     xf_task_base_set_state(task, XF_TASK_STATE_SUSPEND);
     xf_list_add_tail(&task_base->node, &manager_handle->suspend_list);
@@ -242,7 +371,15 @@ xf_err_t xf_task_manager_task_destory(xf_task_manager_t manager, xf_task_t task)
 
     xf_task_base_t *task_base = task;
 
-    xf_list_del_init(&task_base->node);
+    XF_TASK_PROBE1(task__delete, task_base);
+    xf_task_manager_unlink(manager_handle, task_base);
+#if XF_TASK_DEADLINE_IS_ENABLE
+    // 删除时归还准入的利用率
+    xf_task_deadline_free(manager_handle, task_base);
+#endif // XF_TASK_DEADLINE_IS_ENABLE
+#if XF_TASK_FAIR_IS_ENABLE
+    xf_task_fair_free(manager_handle, task_base);
+#endif // XF_TASK_FAIR_IS_ENABLE
 
     xf_task_base_set_state(task, XF_TASK_STATE_DELETE);
     xf_list_add_tail(&task_base->node, &manager_handle->destroy_list);
@@ -258,7 +395,7 @@ xf_err_t xf_task_manager_task_blocked(xf_task_manager_t manager, xf_task_t task)
 
     xf_task_base_t *task_base = task;
 
-    xf_list_del_init(&task_base->node);
+    xf_task_manager_unlink(manager_handle, task_base);
 
     xf_task_base_set_state(task, XF_TASK_STATE_BLOCKED);
     xf_list_add_tail(&task_base->node, &manager_handle->blocked_list);
@@ -275,6 +412,23 @@ xf_task_context_t *xf_task_manager_get_context(xf_task_manager_t manager)
 }
 #endif // XF_TASK_CONTEXT_IS_ENABLE
 
+#if XF_TASK_TRACE_IS_ENABLE
+xf_task_trace_ring_t *xf_task_manager_get_trace(xf_task_manager_t manager)
+{
+    xf_task_manager_handle_t *manager_handle = (xf_task_manager_handle_t *)manager;
+
+    return &manager_handle->trace;
+}
+#endif // XF_TASK_TRACE_IS_ENABLE
+
+#if XF_TASK_NTASK_FAST_IS_ENABLE
+void xf_task_manager_task_event(xf_task_manager_t manager)
+{
+    xf_task_manager_handle_t *manager_handle = (xf_task_manager_handle_t *)manager;
+
+    manager_handle->event_pending = 1;
+}
+#endif // XF_TASK_NTASK_FAST_IS_ENABLE
 
 xf_err_t xf_task_set_urgent_task_with_manager(xf_task_manager_t manager, xf_task_t task, bool force)
 {
@@ -282,19 +436,435 @@ xf_err_t xf_task_set_urgent_task_with_manager(xf_task_manager_t manager, xf_task
     XF_ASSERT(task, XF_ERR_INVALID_ARG, TAG, "task must not be NULL");
 
     xf_task_manager_handle_t *manager_handle = (xf_task_manager_handle_t *)manager;
+    uint32_t tail = manager_handle->urgent_tail;
+    uint32_t head = XF_TASK_ATOMIC_LOAD(&manager_handle->urgent_head);
 
-    if (manager_handle->urgent_task != NULL && !force) {
+    // force 只为兼容旧接口保留，只要队列未满都会排在已有紧急任务之后
+    UNUSED(force);
+    if (tail - head >= XF_TASK_URGENT_QUEUE_SIZE) {
         return XF_ERR_BUSY;
     }
 
-    manager_handle->urgent_task = task;
-    xf_task_base_set_state(task, XF_TASK_STATE_READY);
+    // 只写入任务指针并发布写位置，任务状态由调度器在取出后修改，避免与调度器同时改写任务
+    manager_handle->urgent_queue[tail & (XF_TASK_URGENT_QUEUE_SIZE - 1)] = task;
+    XF_TASK_ATOMIC_STORE(&manager_handle->urgent_tail, tail + 1);
+
+    return XF_OK;
+}
+
+#if XF_TASK_YIELD_CHECK_IS_ENABLE
+
+bool xf_task_should_yield_with_manager(xf_task_manager_t manager)
+{
+    XF_ASSERT(manager, false, TAG, "manager must not be NULL");
+
+    xf_task_manager_handle_t *manager_handle = (xf_task_manager_handle_t *)manager;
+
+    if (manager_handle->current_task == NULL) {
+        return false;
+    }
+
+    // 有更高优先级的任务就绪，或者有紧急任务在排队
+    if (manager_handle->yield_request
+            || manager_handle->urgent_head != XF_TASK_ATOMIC_LOAD(&manager_handle->urgent_tail)) {
+        return true;
+    }
+
+#if XF_TASK_TIME_SLICE_MS > 0
+    int32_t remain = manager_handle->slice_end - xf_task_get_ticks();
+    return remain <= 0;
+#else
+    return false;
+#endif
+}
+
+void xf_task_manager_check_preempt(xf_task_manager_t manager, xf_task_t task)
+{
+    XF_ASSERT(manager, XF_RETURN_VOID, TAG, "manager must not be NULL");
+    XF_ASSERT(task, XF_RETURN_VOID, TAG, "task must not be NULL");
+
+    xf_task_manager_handle_t *manager_handle = (xf_task_manager_handle_t *)manager;
+    xf_task_base_t *current = (xf_task_base_t *)manager_handle->current_task;
+
+    if (current == NULL || current == task) {
+        return;
+    }
+
+    if (xf_task_rank((xf_task_base_t *)task) < xf_task_rank(current)) {
+        manager_handle->yield_request = 1;
+    }
+}
+
+#endif // XF_TASK_YIELD_CHECK_IS_ENABLE
+
+#if XF_TASK_DEADLINE_IS_ENABLE
+
+xf_err_t xf_task_set_deadline(xf_task_t task, uint32_t wcet_ms, uint32_t period_ms, uint32_t deadline_ms)
+{
+    XF_ASSERT(task, XF_ERR_INVALID_ARG, TAG, "task must not be NULL");
+    XF_ASSERT(wcet_ms, XF_ERR_INVALID_ARG, TAG, "wcet must not be 0");
+    XF_ASSERT(period_ms, XF_ERR_INVALID_ARG, TAG, "period must not be 0");
+
+    xf_task_base_t *task_base = (xf_task_base_t *)task;
+    xf_task_manager_handle_t *manager_handle = (xf_task_manager_handle_t *)task_base->manager;
+
+    if (deadline_ms == 0 || deadline_ms > period_ms) {
+        deadline_ms = period_ms;
+    }
+    XF_ASSERT(wcet_ms <= deadline_ms, XF_ERR_INVALID_ARG, TAG, "wcet must not be greater than deadline");
+
+    if (task_base->state == XF_TASK_STATE_DELETE || XF_TASK_IS_FAIR(task_base)) {
+        return XF_ERR_INVALID_STATE;
+    }
+
+    // 准入控制：按密度 wcet / min(period, deadline) 累加，向上取整
+    uint32_t density = (uint32_t)(((uint64_t)wcet_ms * 1000 + deadline_ms - 1) / deadline_ms);
+    uint32_t utilization = manager_handle->utilization;
+    uint32_t tasks = manager_handle->deadline_tasks;
+    if (XF_TASK_IS_DEADLINE(task_base)) {
+        utilization -= task_base->deadline->density;
+        tasks--;
+    }
+
+    if (tasks >= XF_TASK_DEADLINE_MAX_TASKS || utilization + density > XF_TASK_DEADLINE_UTILIZATION_MAX) {
+        XF_LOGD(TAG, "deadline admission failed: %d/%d", (int)(utilization + density),
+                (int)XF_TASK_DEADLINE_UTILIZATION_MAX);
+        return XF_FAIL;
+    }
+
+    xf_task_deadline_t *deadline = task_base->deadline;
+    if (deadline == NULL) {
+        deadline = (xf_task_deadline_t *)xf_malloc(sizeof(xf_task_deadline_t));
+        if (deadline == NULL) {
+            XF_LOGE(TAG, "memory alloc failed!");
+            return XF_ERR_NO_MEM;
+        }
+        deadline->miss = 0;
+        deadline->missed = false;
+        deadline->heap.index = HEAP_NOT_QUEUED;
+        deadline->heap.task = task_base;
+        deadline->heap.key = xf_task_get_ticks() + xf_task_msec_to_ticks(deadline_ms);
+        // 已经就绪的任务以设置时间作为本次作业的释放时间，否则等下一次唤醒释放
+        deadline->active = (task_base->state == XF_TASK_STATE_READY);
+    }
+
+    deadline->wcet = wcet_ms;
+    deadline->period = period_ms;
+    deadline->relative = deadline_ms;
+    deadline->density = density;
+    manager_handle->utilization = utilization + density;
+    manager_handle->deadline_tasks = tasks + 1;
+
+    // 已经就绪的任务从优先级队列移入截止时间堆
+    if (task_base->deadline == NULL) {
+        task_base->deadline = deadline;
+#if XF_TASK_HUNGER_IS_ENABLE
+        xf_list_del_init(&task_base->hunger_node);
+#endif // XF_TASK_HUNGER_IS_ENABLE
+        if (task_base->state == XF_TASK_STATE_READY) {
+            xf_list_del_init(&task_base->node);
+            xf_task_manager_enqueue(manager_handle, task_base);
+        }
+    }
+
+    return XF_OK;
+}
+
+xf_err_t xf_task_deadline_job_done(xf_task_t task)
+{
+    XF_ASSERT(task, XF_ERR_INVALID_ARG, TAG, "task must not be NULL");
+
+    xf_task_base_t *task_base = (xf_task_base_t *)task;
+
+    if (!XF_TASK_IS_DEADLINE(task_base)) {
+        return XF_ERR_INVALID_STATE;
+    }
+
+    task_base->deadline->active = false;
+
+    return XF_OK;
+}
+
+xf_err_t xf_task_clear_deadline(xf_task_t task)
+{
+    XF_ASSERT(task, XF_ERR_INVALID_ARG, TAG, "task must not be NULL");
+
+    xf_task_base_t *task_base = (xf_task_base_t *)task;
+    xf_task_manager_handle_t *manager_handle = (xf_task_manager_handle_t *)task_base->manager;
+
+    if (!XF_TASK_IS_DEADLINE(task_base)) {
+        return XF_OK;
+    }
+
+    bool queued = (task_base->deadline->heap.index != HEAP_NOT_QUEUED);
+    if (queued) {
+        xf_task_heap_remove(&manager_handle->deadline_heap, &task_base->deadline->heap);
+    }
+    xf_task_deadline_free(manager_handle, task_base);
+
+    // 回到原来的优先级队列
+    if (queued) {
+        xf_task_manager_enqueue(manager_handle, task_base);
+    }
+
+    return XF_OK;
+}
+
+uint32_t xf_task_get_deadline_miss(xf_task_t task)
+{
+    XF_ASSERT(task, 0, TAG, "task must not be NULL");
+
+    xf_task_base_t *task_base = (xf_task_base_t *)task;
+
+    return XF_TASK_IS_DEADLINE(task_base) ? task_base->deadline->miss : 0;
+}
+
+uint32_t xf_task_manager_get_deadline_miss(xf_task_manager_t manager)
+{
+    XF_ASSERT(manager, 0, TAG, "manager must not be NULL");
+
+    xf_task_manager_handle_t *manager_handle = (xf_task_manager_handle_t *)manager;
+
+    return manager_handle->deadline_miss;
+}
+
+uint32_t xf_task_manager_get_utilization(xf_task_manager_t manager)
+{
+    XF_ASSERT(manager, 0, TAG, "manager must not be NULL");
+
+    xf_task_manager_handle_t *manager_handle = (xf_task_manager_handle_t *)manager;
+
+    return manager_handle->utilization;
+}
+
+#endif // XF_TASK_DEADLINE_IS_ENABLE
+
+#if XF_TASK_STATS_IS_ENABLE
+
+xf_err_t xf_task_get_stats(xf_task_t task, xf_task_stats_t *stats)
+{
+    XF_ASSERT(task, XF_ERR_INVALID_ARG, TAG, "task must not be NULL");
+    XF_ASSERT(stats, XF_ERR_INVALID_ARG, TAG, "stats must not be NULL");
+
+    xf_task_base_t *task_base = (xf_task_base_t *)task;
+
+    *stats = task_base->stats;
+
+    return XF_OK;
+}
+
+xf_err_t xf_task_reset_stats(xf_task_t task)
+{
+    XF_ASSERT(task, XF_ERR_INVALID_ARG, TAG, "task must not be NULL");
+
+    xf_task_base_t *task_base = (xf_task_base_t *)task;
+    xf_task_time_t since = task_base->stats.since;
+
+    xf_memset(&task_base->stats, 0, sizeof(xf_task_stats_t));
+    task_base->stats.since = since;
+
+    return XF_OK;
+}
+
+uint32_t xf_task_manager_get_task_stats(xf_task_manager_t manager, xf_task_stats_entry_t *entries, uint32_t max)
+{
+    XF_ASSERT(manager, 0, TAG, "manager must not be NULL");
+    XF_ASSERT(entries || max == 0, 0, TAG, "entries must not be NULL");
+
+    xf_task_manager_handle_t *manager_handle = (xf_task_manager_handle_t *)manager;
+    uint32_t count = 0;
+
+    // 正在执行的任务不在任何队列中
+    if (manager_handle->current_task != NULL) {
+        count = xf_task_stats_collect(manager_handle->current_task, entries, max, count);
+    }
+
+    for (uint32_t i = 0; i < XF_TASK_PRIORITY_LEVELS; i++) {
+        count = xf_task_stats_collect_list(&manager_handle->ready_list[i], entries, max, count);
+    }
+    count = xf_task_stats_collect_list(&manager_handle->blocked_list, entries, max, count);
+#if XF_TASK_NTASK_FAST_IS_ENABLE
+    count = xf_task_stats_collect_list(&manager_handle->event_list, entries, max, count);
+#endif // XF_TASK_NTASK_FAST_IS_ENABLE
+    count = xf_task_stats_collect_list(&manager_handle->suspend_list, entries, max, count);
+
+#if XF_TASK_DEADLINE_IS_ENABLE
+    for (uint32_t i = 0; i < manager_handle->deadline_heap.size; i++) {
+        count = xf_task_stats_collect(manager_handle->deadline_heap.nodes[i]->task, entries, max, count);
+    }
+#endif // XF_TASK_DEADLINE_IS_ENABLE
+#if XF_TASK_FAIR_IS_ENABLE
+    for (uint32_t i = 0; i < manager_handle->fair_heap.size; i++) {
+        count = xf_task_stats_collect(manager_handle->fair_heap.nodes[i]->task, entries, max, count);
+    }
+#endif // XF_TASK_FAIR_IS_ENABLE
+
+    return count;
+}
+
+xf_err_t xf_task_manager_get_stats(xf_task_manager_t manager, xf_task_manager_stats_t *stats)
+{
+    XF_ASSERT(manager, XF_ERR_INVALID_ARG, TAG, "manager must not be NULL");
+    XF_ASSERT(stats, XF_ERR_INVALID_ARG, TAG, "stats must not be NULL");
+
+    xf_task_manager_handle_t *manager_handle = (xf_task_manager_handle_t *)manager;
+
+    *stats = manager_handle->stats;
+    stats->elapsed = xf_task_get_ticks() - manager_handle->stats.elapsed;
+
+    return XF_OK;
+}
+
+xf_err_t xf_task_manager_reset_stats(xf_task_manager_t manager)
+{
+    XF_ASSERT(manager, XF_ERR_INVALID_ARG, TAG, "manager must not be NULL");
+
+    xf_task_manager_handle_t *manager_handle = (xf_task_manager_handle_t *)manager;
+
+    xf_memset(&manager_handle->stats, 0, sizeof(xf_task_manager_stats_t));
+    manager_handle->stats.elapsed = xf_task_get_ticks();
+
+    return XF_OK;
+}
+
+#endif // XF_TASK_STATS_IS_ENABLE
+
+#if XF_TASK_FAIR_IS_ENABLE
+
+xf_err_t xf_task_set_weight(xf_task_t task, uint32_t weight)
+{
+    XF_ASSERT(task, XF_ERR_INVALID_ARG, TAG, "task must not be NULL");
+    XF_ASSERT(weight, XF_ERR_INVALID_ARG, TAG, "weight must not be 0");
+
+    xf_task_base_t *task_base = (xf_task_base_t *)task;
+    xf_task_manager_handle_t *manager_handle = (xf_task_manager_handle_t *)task_base->manager;
+
+    if (task_base->state == XF_TASK_STATE_DELETE || XF_TASK_IS_DEADLINE(task_base)) {
+        return XF_ERR_INVALID_STATE;
+    }
+
+    if (XF_TASK_IS_FAIR(task_base)) {
+        task_base->fair->weight = weight;
+        return XF_OK;
+    }
+
+    if (manager_handle->fair_tasks >= XF_TASK_FAIR_MAX_TASKS) {
+        XF_LOGD(TAG, "fair tasks is full");
+        return XF_FAIL;
+    }
+
+    xf_task_fair_t *fair = (xf_task_fair_t *)xf_malloc(sizeof(xf_task_fair_t));
+    if (fair == NULL) {
+        XF_LOGE(TAG, "memory alloc failed!");
+        return XF_ERR_NO_MEM;
+    }
+
+    fair->weight = weight;
+    fair->heap.index = HEAP_NOT_QUEUED;
+    fair->heap.task = task_base;
+    fair->heap.key = manager_handle->min_vruntime;
+    task_base->fair = fair;
+    manager_handle->fair_tasks++;
+
+    // 已经就绪的任务从优先级队列移入公平调度堆
+#if XF_TASK_HUNGER_IS_ENABLE
+    xf_list_del_init(&task_base->hunger_node);
+#endif // XF_TASK_HUNGER_IS_ENABLE
+    if (task_base->state == XF_TASK_STATE_READY) {
+        xf_list_del_init(&task_base->node);
+        xf_task_manager_enqueue(manager_handle, task_base);
+    }
 
     return XF_OK;
 }
 
+xf_err_t xf_task_clear_weight(xf_task_t task)
+{
+    XF_ASSERT(task, XF_ERR_INVALID_ARG, TAG, "task must not be NULL");
+
+    xf_task_base_t *task_base = (xf_task_base_t *)task;
+    xf_task_manager_handle_t *manager_handle = (xf_task_manager_handle_t *)task_base->manager;
+
+    if (!XF_TASK_IS_FAIR(task_base)) {
+        return XF_OK;
+    }
+
+    bool queued = (task_base->fair->heap.index != HEAP_NOT_QUEUED);
+    if (queued) {
+        xf_task_heap_remove(&manager_handle->fair_heap, &task_base->fair->heap);
+    }
+    xf_task_fair_free(manager_handle, task_base);
+
+    // 回到原来的优先级队列
+    if (queued) {
+        xf_task_manager_enqueue(manager_handle, task_base);
+    }
+
+    return XF_OK;
+}
+
+xf_task_time_t xf_task_get_vruntime(xf_task_t task)
+{
+    XF_ASSERT(task, 0, TAG, "task must not be NULL");
+
+    xf_task_base_t *task_base = (xf_task_base_t *)task;
+
+    return XF_TASK_IS_FAIR(task_base) ? task_base->fair->heap.key : 0;
+}
+
+#endif // XF_TASK_FAIR_IS_ENABLE
+
 /* ==================== [Static Functions] ================================== */
 
+static void xf_task_manager_init(xf_task_manager_handle_t *manager, xf_task_on_idle_t on_idle, bool is_static)
+{
+    manager->current_task = NULL;
+    manager->urgent_head = 0;
+    manager->urgent_tail = 0;
+    manager->on_idle = on_idle;
+    manager->is_static = is_static;
+
+    for (size_t i = 0; i < XF_TASK_PRIORITY_LEVELS; i++) {
+        xf_list_init(&manager->ready_list[i]);
+    }
+    xf_list_init(&manager->blocked_list);
+    xf_list_init(&manager->destroy_list);
+    xf_list_init(&manager->suspend_list);
+#if XF_TASK_NTASK_FAST_IS_ENABLE
+    xf_list_init(&manager->event_list);
+    manager->event_pending = 0;
+#endif // XF_TASK_NTASK_FAST_IS_ENABLE
+#if XF_TASK_HUNGER_IS_ENABLE
+    xf_list_init(&manager->hunger_list);
+#endif // XF_TASK_HUNGER_IS_ENABLE
+#if XF_TASK_DEADLINE_IS_ENABLE
+    manager->deadline_heap.nodes = manager->deadline_nodes;
+    manager->deadline_heap.size = 0;
+    manager->deadline_tasks = 0;
+    manager->utilization = 0;
+    manager->deadline_miss = 0;
+#endif // XF_TASK_DEADLINE_IS_ENABLE
+#if XF_TASK_FAIR_IS_ENABLE
+    manager->fair_heap.nodes = manager->fair_nodes;
+    manager->fair_heap.size = 0;
+    manager->fair_tasks = 0;
+    manager->min_vruntime = 0;
+#endif // XF_TASK_FAIR_IS_ENABLE
+#if XF_TASK_TRACE_IS_ENABLE
+    manager->trace.head = 0;
+    manager->trace.enable = 1;
+#endif // XF_TASK_TRACE_IS_ENABLE
+#if XF_TASK_STATS_IS_ENABLE
+    manager->last_task = NULL;
+    xf_memset(&manager->stats, 0, sizeof(xf_task_manager_stats_t));
+    manager->stats.elapsed = xf_task_get_ticks();
+#endif // XF_TASK_STATS_IS_ENABLE
+#if XF_TASK_YIELD_CHECK_IS_ENABLE
+    manager->yield_request = 0;
+    manager->slice_ticks = xf_task_msec_to_ticks(XF_TASK_TIME_SLICE_MS);
+    manager->slice_end = 0;
+#endif // XF_TASK_YIELD_CHECK_IS_ENABLE
+}
 
 static inline void xf_task_run(xf_task_base_t *task)
 {
@@ -306,11 +876,60 @@ static inline void xf_task_run(xf_task_base_t *task)
     }
 #endif // XF_TASK_HUNGER_IS_ENABLE
 
-    xf_list_del_init(&task->node);                   // 从原有链表中脱离
+    xf_task_manager_unlink(manager, task);              // 从原有链表中脱离
     manager->current_task = task;                       // 放入当前执行的任务
     xf_task_update_timeout(task);
-    task->vfunc->exec(manager);                           // 执行任务
+#if XF_TASK_FAIR_IS_ENABLE || XF_TASK_YIELD_CHECK_IS_ENABLE || XF_TASK_STATS_IS_ENABLE
+    xf_task_time_t exec_ticks = xf_task_get_ticks();
+#endif // XF_TASK_FAIR_IS_ENABLE || XF_TASK_YIELD_CHECK_IS_ENABLE || XF_TASK_STATS_IS_ENABLE
+#if XF_TASK_YIELD_CHECK_IS_ENABLE
+    manager->yield_request = 0;
+    manager->slice_end = exec_ticks + manager->slice_ticks;
+#endif // XF_TASK_YIELD_CHECK_IS_ENABLE
+#if XF_TASK_STATS_IS_ENABLE
+    if (task->state == XF_TASK_STATE_READY) {
+        xf_task_time_t wait = exec_ticks - task->stats.since;
+        task->stats.ready_total += wait;
+        task->stats.ready_max = (wait > task->stats.ready_max) ? wait : task->stats.ready_max;
+    }
+    task->stats.dispatch++;
+    manager->stats.dispatches++;
+    if (manager->last_task != task) {
+        task->stats.switches++;
+        manager->last_task = task;
+    }
+#endif // XF_TASK_STATS_IS_ENABLE
+#if XF_TASK_TRACE_IS_ENABLE
+    xf_task_trace_record(manager, XF_TASK_TRACE_TASK_BEGIN, task, task->priority, 0);
+#endif // XF_TASK_TRACE_IS_ENABLE
+    XF_TASK_PROBE2(dispatch__begin, task, (int)task->priority);
+    XF_TASK_EXEC(task, manager);                            // 执行任务
     manager->current_task = NULL;
+    XF_TASK_PROBE2(dispatch__end, task, (int)task->state);
+#if XF_TASK_TRACE_IS_ENABLE
+    xf_task_trace_record(manager, XF_TASK_TRACE_TASK_END, task, task->state, 0);
+#endif // XF_TASK_TRACE_IS_ENABLE
+#if XF_TASK_STATS_IS_ENABLE
+    xf_task_time_t exec_time = xf_task_get_ticks() - exec_ticks;
+    task->stats.exec_total += exec_time;
+    task->stats.exec_max = (exec_time > task->stats.exec_max) ? exec_time : task->stats.exec_max;
+    manager->stats.busy_ticks += exec_time;
+#endif // XF_TASK_STATS_IS_ENABLE
+
+#if XF_TASK_DEADLINE_IS_ENABLE
+    // 让出 CPU 时已经超过当前作业的截止时间，记为一次错过，同一作业中多次让出只记一次
+    if (XF_TASK_IS_DEADLINE(task) && !task->deadline->missed
+            && xf_task_time_before(task->deadline->heap.key, xf_task_get_ticks())) {
+        task->deadline->missed = true;
+        task->deadline->miss++;
+        manager->deadline_miss++;
+    }
+#endif // XF_TASK_DEADLINE_IS_ENABLE
+#if XF_TASK_FAIR_IS_ENABLE
+    if (XF_TASK_IS_FAIR(task)) {
+        xf_task_fair_charge(manager, task, xf_task_get_ticks() - exec_ticks);
+    }
+#endif // XF_TASK_FAIR_IS_ENABLE
 
     // 如果设置成功，则进入阻塞状态。如果设置不成功（删除或挂起）则不管它
     if (xf_task_base_set_state(task, XF_TASK_STATE_BLOCKED) == XF_OK) {
@@ -323,3 +942,263 @@ static inline void xf_task_update_timeout(xf_task_base_t *task)
     xf_task_time_t timeout = xf_task_get_ticks() - task->weakup;
     task->timeout = xf_task_ticks_to_msec(timeout);
 }
+
+static inline void xf_task_manager_unlink(xf_task_manager_handle_t *manager, xf_task_base_t *task)
+{
+    xf_list_del_init(&task->node);
+#if XF_TASK_DEADLINE_IS_ENABLE
+    if (XF_TASK_IS_DEADLINE(task) && task->deadline->heap.index != HEAP_NOT_QUEUED) {
+        xf_task_heap_remove(&manager->deadline_heap, &task->deadline->heap);
+    }
+#endif // XF_TASK_DEADLINE_IS_ENABLE
+#if XF_TASK_FAIR_IS_ENABLE
+    if (XF_TASK_IS_FAIR(task) && task->fair->heap.index != HEAP_NOT_QUEUED) {
+        xf_task_heap_remove(&manager->fair_heap, &task->fair->heap);
+    }
+#endif // XF_TASK_FAIR_IS_ENABLE
+    UNUSED(manager);
+}
+
+static inline void xf_task_manager_enqueue(xf_task_manager_handle_t *manager, xf_task_base_t *task)
+{
+#if XF_TASK_DEADLINE_IS_ENABLE
+    if (XF_TASK_IS_DEADLINE(task)) {
+        xf_task_heap_push(&manager->deadline_heap, &task->deadline->heap);
+        return;
+    }
+#endif // XF_TASK_DEADLINE_IS_ENABLE
+#if XF_TASK_FAIR_IS_ENABLE
+    if (XF_TASK_IS_FAIR(task)) {
+        xf_task_heap_push(&manager->fair_heap, &task->fair->heap);
+        return;
+    }
+#endif // XF_TASK_FAIR_IS_ENABLE
+    xf_list_add_tail(&task->node, &manager->ready_list[task->priority]);
+}
+
+static inline void xf_task_manager_wakeup(xf_task_manager_handle_t *manager, xf_task_base_t *task)
+{
+    xf_list_del_init(&task->node);
+    xf_task_base_set_state(task, XF_TASK_STATE_READY); // 设置为就绪态
+#if XF_TASK_DEADLINE_IS_ENABLE
+    if (XF_TASK_IS_DEADLINE(task)) {
+        xf_task_deadline_release(task);
+    }
+#endif // XF_TASK_DEADLINE_IS_ENABLE
+#if XF_TASK_FAIR_IS_ENABLE
+    if (XF_TASK_IS_FAIR(task)) {
+        xf_task_fair_place(manager, task);
+    }
+#endif // XF_TASK_FAIR_IS_ENABLE
+    xf_task_manager_enqueue(manager, task);
+    BITS_SET0(task->signal, XF_TASK_SIGNAL_READY);
+#if XF_TASK_HUNGER_IS_ENABLE
+    // 截止时间任务与公平调度任务不在优先级队列中，不需要饥饿爬升
+    if (BITS_CHECK(task->flag, XF_TASK_FALG_FEEL_HUNGERY) && !XF_TASK_IS_DEADLINE(task) && !XF_TASK_IS_FAIR(task)) {
+        xf_list_add_tail(&task->hunger_node, &manager->hunger_list);
+    }
+#endif // XF_TASK_HUNGER_IS_ENABLE
+}
+
+#if XF_TASK_DEADLINE_IS_ENABLE || XF_TASK_FAIR_IS_ENABLE
+
+static inline bool xf_task_time_before(xf_task_time_t a, xf_task_time_t b)
+{
+    // 按差值的符号比较，计数溢出回绕后依然正确
+    return (xf_task_time_t)(a - b) > ((xf_task_time_t) -1 >> 1);
+}
+
+static void xf_task_heap_push(xf_task_heap_t *heap, xf_task_heap_node_t *node)
+{
+    // 堆的容量与任务数上限相同，不会溢出
+    node->index = heap->size++;
+    heap->nodes[node->index] = node;
+    xf_task_heap_sift(heap, node->index);
+}
+
+static void xf_task_heap_remove(xf_task_heap_t *heap, xf_task_heap_node_t *node)
+{
+    uint32_t index = node->index;
+    xf_task_heap_node_t *last = heap->nodes[--heap->size];
+
+    node->index = HEAP_NOT_QUEUED;
+    if (last == node) {
+        return;
+    }
+
+    heap->nodes[index] = last;
+    last->index = index;
+    xf_task_heap_sift(heap, index);
+}
+
+static void xf_task_heap_sift(xf_task_heap_t *heap, uint32_t index)
+{
+    xf_task_heap_node_t **nodes = heap->nodes;
+    xf_task_heap_node_t *node = nodes[index];
+
+    // 上浮
+    while (index > 0) {
+        uint32_t parent = (index - 1) / 2;
+        if (!xf_task_time_before(node->key, nodes[parent]->key)) {
+            break;
+        }
+        nodes[index] = nodes[parent];
+        nodes[index]->index = index;
+        index = parent;
+    }
+
+    // 下沉
+    while (1) {
+        uint32_t child = index * 2 + 1;
+        if (child >= heap->size) {
+            break;
+        }
+        if (child + 1 < heap->size && xf_task_time_before(nodes[child + 1]->key, nodes[child]->key)) {
+            child++;
+        }
+        if (!xf_task_time_before(nodes[child]->key, node->key)) {
+            break;
+        }
+        nodes[index] = nodes[child];
+        nodes[index]->index = index;
+        index = child;
+    }
+
+    nodes[index] = node;
+    node->index = index;
+}
+
+#endif // XF_TASK_DEADLINE_IS_ENABLE || XF_TASK_FAIR_IS_ENABLE
+
+#if XF_TASK_DEADLINE_IS_ENABLE
+
+static void xf_task_deadline_release(xf_task_base_t *task)
+{
+    // 作业还没有完成（ctask 等待队列、让出 CPU，或者无栈协程在作业中途等待），保持原来的截止时间
+    if (task->deadline->active) {
+        return;
+    }
+    task->deadline->active = true;
+    task->deadline->missed = false;
+
+    // 定时唤醒以预定的唤醒时间为释放时间，事件触发则以当前时间为释放时间
+    xf_task_time_t time_ticks = xf_task_get_ticks();
+    xf_task_time_t release = time_ticks;
+    if (task->delay != 0 && !xf_task_time_before(time_ticks, task->weakup)) {
+        release = task->weakup;
+    }
+
+    task->deadline->heap.key = release + xf_task_msec_to_ticks(task->deadline->relative);
+}
+
+static void xf_task_deadline_free(xf_task_manager_handle_t *manager, xf_task_base_t *task)
+{
+    if (!XF_TASK_IS_DEADLINE(task)) {
+        return;
+    }
+
+    manager->utilization -= task->deadline->density;
+    manager->deadline_tasks--;
+    xf_free(task->deadline);
+    task->deadline = NULL;
+}
+
+#endif // XF_TASK_DEADLINE_IS_ENABLE
+
+#if XF_TASK_FAIR_IS_ENABLE
+
+static void xf_task_fair_place(xf_task_manager_handle_t *manager, xf_task_base_t *task)
+{
+    // 睡眠期间不积累额度，否则唤醒后会长时间独占 CPU
+    if (xf_task_time_before(task->fair->heap.key, manager->min_vruntime)) {
+        task->fair->heap.key = manager->min_vruntime;
+    }
+}
+
+static void xf_task_fair_charge(xf_task_manager_handle_t *manager, xf_task_base_t *task, xf_task_time_t ticks)
+{
+    // 不足一个 tick 按一个 tick 计，避免执行很快的任务一直不增加虚拟运行时间
+    ticks = (ticks == 0) ? 1 : ticks;
+    task->fair->heap.key += (xf_task_time_t)((uint64_t)ticks * VRUNTIME_SCALE * XF_TASK_FAIR_WEIGHT_BASE
+                                             / task->fair->weight);
+
+    // 最小虚拟运行时间只增不减
+    xf_task_time_t min_vruntime = task->fair->heap.key;
+    if (manager->fair_heap.size != 0 && xf_task_time_before(manager->fair_heap.nodes[0]->key, min_vruntime)) {
+        min_vruntime = manager->fair_heap.nodes[0]->key;
+    }
+    if (xf_task_time_before(manager->min_vruntime, min_vruntime)) {
+        manager->min_vruntime = min_vruntime;
+    }
+}
+
+static void xf_task_fair_free(xf_task_manager_handle_t *manager, xf_task_base_t *task)
+{
+    if (!XF_TASK_IS_FAIR(task)) {
+        return;
+    }
+
+    manager->fair_tasks--;
+    xf_free(task->fair);
+    task->fair = NULL;
+}
+
+#endif // XF_TASK_FAIR_IS_ENABLE
+
+#if XF_TASK_YIELD_CHECK_IS_ENABLE
+
+static inline int32_t xf_task_rank(xf_task_base_t *task)
+{
+    // 数值越小越优先：截止时间任务在所有优先级之上，公平调度任务在所有优先级之下
+    if (XF_TASK_IS_DEADLINE(task)) {
+        return -1;
+    }
+    if (XF_TASK_IS_FAIR(task)) {
+        return XF_TASK_PRIORITY_LEVELS;
+    }
+    return (int32_t)task->priority;
+}
+
+#endif // XF_TASK_YIELD_CHECK_IS_ENABLE
+
+#if XF_TASK_STATS_IS_ENABLE
+
+static uint32_t xf_task_stats_collect_list(xf_list_t *list, xf_task_stats_entry_t *entries, uint32_t max,
+        uint32_t count)
+{
+    xf_task_base_t *task;
+
+    xf_list_for_each_entry(task, list, xf_task_base_t, node) {
+        count = xf_task_stats_collect(task, entries, max, count);
+    }
+
+    return count;
+}
+
+static inline uint32_t xf_task_stats_collect(xf_task_base_t *task, xf_task_stats_entry_t *entries, uint32_t max,
+        uint32_t count)
+{
+    if (count < max) {
+        entries[count].task = task;
+        entries[count].stats = task->stats;
+    }
+
+    return count + 1;
+}
+
+static void xf_task_stats_ready_depth(xf_task_manager_handle_t *manager)
+{
+    // 链表没有长度，扫描后逐个统计；只在开启统计时执行，就绪队列通常很短
+    for (uint32_t i = 0; i < XF_TASK_PRIORITY_LEVELS; i++) {
+        uint16_t depth = 0;
+        xf_task_base_t *task;
+        xf_list_for_each_entry(task, &manager->ready_list[i], xf_task_base_t, node) {
+            depth++;
+        }
+        if (depth > manager->stats.ready_max[i]) {
+            manager->stats.ready_max[i] = depth;
+        }
+    }
+}
+
+#endif // XF_TASK_STATS_IS_ENABLE
@@ -30,6 +30,23 @@ extern "C" {
 
 /* ==================== [Defines] =========================================== */
 
+/**
+ * @brief 静态创建任务管理器所需的内存大小，见 xf_task_manager_create_static.
+ *
+ * @note 展开时需要任务管理器对象的完整定义，包含 xf_task.h 即可。
+ */
+#define XF_TASK_MANAGER_STORAGE_SIZE (sizeof(xf_task_manager_handle_t))
+
+/**
+ * @brief 定义静态创建任务管理器所需的内存，对齐与对象一致。
+ *
+ * 例如 `static XF_TASK_MANAGER_STORAGE_DEFINE(s_manager);` ，
+ * 之后传入 `&s_manager` 创建。
+ *
+ * @param name 变量名。
+ */
+#define XF_TASK_MANAGER_STORAGE_DEFINE(name) xf_task_manager_handle_t name
+
 /* ==================== [Typedefs] ========================================== */
 
 /**
@@ -49,6 +66,50 @@ typedef void *xf_task_manager_t;
  */
 typedef void (*xf_task_on_idle_t)(unsigned long int max_idle_ms);
 
+#if XF_TASK_STATS_IS_ENABLE
+/**
+ * @brief 任务运行统计，时间单位为 tick，频率见 XF_TASK_TICKS_FREQUENCY.
+ */
+typedef struct _xf_task_stats_t {
+    uint32_t dispatch;              /*!< 被调度执行的次数 */
+    uint32_t switches;              /*!< 切换次数，即上一次执行的不是该任务时被调度执行的次数 */
+    xf_task_time_t exec_total;      /*!< 累计执行时间 */
+    xf_task_time_t exec_max;        /*!< 单次最长执行时间 */
+    xf_task_time_t ready_total;     /*!< 累计就绪等待时间，从就绪到开始执行 */
+    xf_task_time_t ready_max;       /*!< 单次最长就绪等待时间 */
+    xf_task_time_t blocked_total;   /*!< 累计阻塞时间 */
+    xf_task_time_t since;           /*!< 进入就绪或阻塞状态的时间，内部使用 */
+} xf_task_stats_t;
+
+/**
+ * @brief 任务管理器统计快照中的一项。
+ */
+typedef struct _xf_task_stats_entry_t {
+    xf_task_t task;                 /*!< 任务对象 */
+    xf_task_stats_t stats;          /*!< 任务运行统计 */
+} xf_task_stats_entry_t;
+
+/**
+ * @brief 任务管理器调度统计，时间单位为 tick.
+ *
+ * 调度器本身的开销约为 elapsed - busy_ticks - idle_ticks.
+ */
+typedef struct _xf_task_manager_stats_t {
+    uint32_t passes;                /*!< 调度次数，即 xf_task_manager_run 的调用次数 */
+    uint32_t dispatches;            /*!< 执行任务的次数 */
+    uint32_t urgent;                /*!< 执行紧急任务的次数 */
+    uint32_t hunger;                /*!< 饥饿任务优先级爬升的次数 */
+    uint32_t idle_entries;          /*!< 进入空闲回调的次数 */
+    uint32_t scan_max;              /*!< 单次扫描的最多阻塞任务数 */
+    uint32_t scan_total;            /*!< 累计扫描的阻塞任务数 */
+    xf_task_time_t scan_ticks;      /*!< 累计扫描阻塞队列的时间 */
+    xf_task_time_t busy_ticks;      /*!< 累计执行任务的时间 */
+    xf_task_time_t idle_ticks;      /*!< 累计空闲回调的时间 */
+    xf_task_time_t elapsed;         /*!< 从创建或清零到获取时经过的时间 */
+    uint16_t ready_max[XF_TASK_PRIORITY_LEVELS]; /*!< 每个优先级就绪队列的最大长度 */
+} xf_task_manager_stats_t;
+#endif // XF_TASK_STATS_IS_ENABLE
+
 /* ==================== [Global Prototypes] ================================= */
 
 /**
@@ -59,6 +120,18 @@ typedef void (*xf_task_on_idle_t)(unsigned long int max_idle_ms);
  */
 xf_task_manager_t xf_task_manager_create(xf_task_on_idle_t on_idle);
 
+/**
+ * @brief 在用户提供的内存上创建任务管理器，不申请堆内存。
+ *
+ * @note 删除时不会释放 storage ，storage 需要在任务管理器删除前一直有效。
+ *
+ * @param on_idle 空闲回调函数。
+ * @param storage 任务管理器内存，至少 @ref XF_TASK_MANAGER_STORAGE_SIZE 字节，
+ *                通常由 XF_TASK_MANAGER_STORAGE_DEFINE 定义。
+ * @return xf_task_manager_t 任务管理器对象，返回为 NULL 则表示参数错误
+ */
+xf_task_manager_t xf_task_manager_create_static(xf_task_on_idle_t on_idle, void *storage);
+
 /**
  * @brief 设置 manager 的空闲回调函数
  * 
@@ -70,6 +143,16 @@ xf_task_manager_t xf_task_manager_create(xf_task_on_idle_t on_idle);
  */
 xf_err_t xf_task_manager_set_idle(xf_task_manager_t manager, xf_task_on_idle_t on_idle);
 
+/**
+ * @brief 删除任务管理器。
+ *
+ * @note 只释放任务管理器本身，其中的任务需要先删除并在空闲时回收。
+ *       静态创建的任务管理器不释放内存。
+ *
+ * @param manager 任务管理器对象。
+ */
+void xf_task_manager_delete(xf_task_manager_t manager);
+
 /**
  * @brief 开始启动任务管理器调度任务。
  *
@@ -80,13 +163,22 @@ void xf_task_manager_run(xf_task_manager_t manager);
 /**
  * @brief 将任务设置为紧急任务，下次调度立即执行。
  *
+ * 紧急任务按先后顺序放入长度为 @ref XF_TASK_URGENT_QUEUE_SIZE 的队列，只有队列满时才会失败，
+ * 每次调度在处理阻塞队列之前取出一个执行，延迟与任务总数无关。
+ *
+ * @attention 队列为单生产者单消费者，同一个任务管理器只能有一个设置方：
+ *            可以在一个中断中设置紧急任务，但两个中断、或者中断与任务不能同时调用本函数，
+ *            否则需要用户自行互斥。
+ *
+ * @note 这里只把任务放入队列，不修改任务；调度器取出时任务已被删除或挂起，则丢弃。
+ *
  * @param manager 任务管理器对象。
  * @param task 设置为紧急任务的任务。
- * @param force 如果设置为 true，则覆盖任务。设置为 false，当前有紧急任务则设置失败。
+ * @param force 不再使用，只为兼容旧接口保留。紧急任务总是排在已有紧急任务之后。
  * @return xf_err_t
  *      - XF_OK 设置成功
  *      - XF_ERR_INVALID_ARG 无效参数
- *      - XF_ERR_BUSY 设置失败，`force == false` 且当前已存在紧急任务
+ *      - XF_ERR_BUSY 设置失败，紧急任务队列已满
  */
 xf_err_t xf_task_set_urgent_task_with_manager(xf_task_manager_t manager, xf_task_t task, bool force);
 
@@ -142,6 +234,223 @@ xf_err_t xf_task_manager_task_destory(xf_task_manager_t manager, xf_task_t task)
  */
 xf_err_t xf_task_manager_task_blocked(xf_task_manager_t manager, xf_task_t task);
 
+#if XF_TASK_NTASK_FAST_IS_ENABLE
+/**
+ * @brief 有任务被触发时通知任务管理器，下一次调度扫描事件队列。
+ *
+ * @param manager 任务管理器对象。
+ */
+void xf_task_manager_task_event(xf_task_manager_t manager);
+#endif // XF_TASK_NTASK_FAST_IS_ENABLE
+
+#if XF_TASK_YIELD_CHECK_IS_ENABLE
+
+/**
+ * @brief 当前任务是否应该让出 CPU.
+ *
+ * 长时间运行的任务可以在循环中调用它，只在需要时才让出，避免每次无条件让出都要走一遍调度。
+ * 以下情况返回 true：
+ *  - 有优先级更高的任务被触发、恢复或者设置为就绪；
+ *  - 有紧急任务在排队；
+ *  - 当前任务单次连续执行超过 @ref XF_TASK_TIME_SLICE_MS.
+ *
+ * @note 阻塞任务的定时唤醒只在调度时检查，由时间片兜底。
+ *
+ * @param manager 任务管理器对象。
+ * @return true 应该让出
+ * @return false 可以继续执行，或者不是在任务中调用
+ */
+bool xf_task_should_yield_with_manager(xf_task_manager_t manager);
+
+/**
+ * @brief 任务即将就绪时通知任务管理器，如果它比当前任务优先，则请求当前任务让出。
+ *
+ * @param manager 任务管理器对象。
+ * @param task 即将就绪的任务。
+ */
+void xf_task_manager_check_preempt(xf_task_manager_t manager, xf_task_t task);
+
+#endif // XF_TASK_YIELD_CHECK_IS_ENABLE
+
+#if XF_TASK_DEADLINE_IS_ENABLE
+
+/**
+ * @brief 设置任务按截止时间调度。
+ *
+ * 截止时间任务处于所有优先级之上，每个作业释放时以唤醒时间加上相对截止时间作为绝对截止时间，
+ * 绝对截止时间最早的任务优先执行（EDF）。作业在绝对截止时间之后才让出 CPU 记为一次错过，每个作业最多记一次。
+ *
+ * 作业从完成后的第一次唤醒开始，到 @ref xf_task_deadline_job_done 为止，期间的等待与让出不会重新计算截止时间。
+ * ntask 每次执行完且无栈协程回到起点时自动完成作业；ctask 需要在每个作业结束时调用 @ref xf_task_deadline_job_done.
+ *
+ * 准入控制：同一任务管理器中所有截止时间任务的 wcet / min(period, deadline) 之和
+ * 不能超过 @ref XF_TASK_DEADLINE_UTILIZATION_MAX ，任务数不能超过 @ref XF_TASK_DEADLINE_MAX_TASKS.
+ * 已经是截止时间任务时重新准入。
+ *
+ * @note 调度器为协作式，wcet 是任务单次执行到让出 CPU 的最长时间，需要由用户保证。
+ *
+ * @param task 任务对象。
+ * @param wcet_ms 最坏执行时间，单位为 ms.
+ * @param period_ms 周期（或最小触发间隔），单位为 ms.
+ * @param deadline_ms 相对截止时间，单位为 ms，为 0 或大于周期时等于周期。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_INVALID_STATE 任务已被删除或者是公平调度任务
+ *      - XF_ERR_NO_MEM 内存不足
+ *      - XF_FAIL 准入失败
+ *      - XF_OK 设置成功
+ */
+xf_err_t xf_task_set_deadline(xf_task_t task, uint32_t wcet_ms, uint32_t period_ms, uint32_t deadline_ms);
+
+/**
+ * @brief 标记截止时间任务的当前作业完成，下一次唤醒视为新作业释放。
+ *
+ * @note ntask 由调度器自动调用，一般只在 ctask 中每个作业结束、等待下一个周期前调用。
+ *
+ * @param task 任务对象。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_INVALID_STATE 不是截止时间任务
+ *      - XF_OK 成功
+ */
+xf_err_t xf_task_deadline_job_done(xf_task_t task);
+
+/**
+ * @brief 取消任务的截止时间调度，回到原来的优先级。
+ *
+ * @param task 任务对象。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_OK 取消成功
+ */
+xf_err_t xf_task_clear_deadline(xf_task_t task);
+
+/**
+ * @brief 获取任务错过截止时间的次数。
+ *
+ * @param task 任务对象。
+ * @return uint32_t 错过次数，不是截止时间任务时返回 0
+ */
+uint32_t xf_task_get_deadline_miss(xf_task_t task);
+
+/**
+ * @brief 获取任务管理器中所有任务错过截止时间的总次数。
+ *
+ * @param manager 任务管理器对象。
+ * @return uint32_t 错过次数
+ */
+uint32_t xf_task_manager_get_deadline_miss(xf_task_manager_t manager);
+
+/**
+ * @brief 获取任务管理器已准入的截止时间任务利用率。
+ *
+ * @param manager 任务管理器对象。
+ * @return uint32_t 利用率，单位为千分之一
+ */
+uint32_t xf_task_manager_get_utilization(xf_task_manager_t manager);
+
+#endif // XF_TASK_DEADLINE_IS_ENABLE
+
+#if XF_TASK_STATS_IS_ENABLE
+
+/**
+ * @brief 获取任务运行统计。
+ *
+ * @param task 任务对象。
+ * @param[out] stats 任务运行统计。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_OK 获取成功
+ */
+xf_err_t xf_task_get_stats(xf_task_t task, xf_task_stats_t *stats);
+
+/**
+ * @brief 清零任务运行统计。
+ *
+ * @param task 任务对象。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_OK 清零成功
+ */
+xf_err_t xf_task_reset_stats(xf_task_t task);
+
+/**
+ * @brief 获取任务管理器中所有任务的运行统计快照（类似 top）。
+ *
+ * @note 已删除等待回收的任务不在快照中。
+ *
+ * @param manager 任务管理器对象。
+ * @param[out] entries 快照数组。
+ * @param max 快照数组的长度。
+ * @return uint32_t 任务总数，大于 max 时只填写前 max 项
+ */
+uint32_t xf_task_manager_get_task_stats(xf_task_manager_t manager, xf_task_stats_entry_t *entries, uint32_t max);
+
+/**
+ * @brief 获取任务管理器的调度统计。
+ *
+ * @param manager 任务管理器对象。
+ * @param[out] stats 调度统计。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_OK 获取成功
+ */
+xf_err_t xf_task_manager_get_stats(xf_task_manager_t manager, xf_task_manager_stats_t *stats);
+
+/**
+ * @brief 清零任务管理器的调度统计，并从现在开始重新计时。
+ *
+ * @param manager 任务管理器对象。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_OK 清零成功
+ */
+xf_err_t xf_task_manager_reset_stats(xf_task_manager_t manager);
+
+#endif // XF_TASK_STATS_IS_ENABLE
+
+#if XF_TASK_FAIR_IS_ENABLE
+
+/**
+ * @brief 设置任务按权重公平调度。
+ *
+ * 公平调度任务处于所有优先级之下，只在没有优先级任务就绪时执行。
+ * 每次执行后按实际执行时间累加虚拟运行时间（执行时间 * @ref XF_TASK_FAIR_WEIGHT_BASE / weight），
+ * 虚拟运行时间最小的任务优先执行，长期来看各任务占用的 CPU 时间与权重成正比。
+ *
+ * @note 执行时间的精度为一个 tick，不足一个 tick 按一个 tick 计。
+ *
+ * @param task 任务对象。
+ * @param weight 权重，@ref XF_TASK_FAIR_WEIGHT_BASE 为基准。已经是公平调度任务时只修改权重。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_INVALID_STATE 任务已被删除或者是截止时间任务
+ *      - XF_ERR_NO_MEM 内存不足
+ *      - XF_FAIL 公平调度任务数已满，见 @ref XF_TASK_FAIR_MAX_TASKS
+ *      - XF_OK 设置成功
+ */
+xf_err_t xf_task_set_weight(xf_task_t task, uint32_t weight);
+
+/**
+ * @brief 取消任务的公平调度，回到原来的优先级。
+ *
+ * @param task 任务对象。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_OK 取消成功
+ */
+xf_err_t xf_task_clear_weight(xf_task_t task);
+
+/**
+ * @brief 获取任务的虚拟运行时间。
+ *
+ * @param task 任务对象。
+ * @return xf_task_time_t 虚拟运行时间，单位为 1/1024 tick，不是公平调度任务时返回 0
+ */
+xf_task_time_t xf_task_get_vruntime(xf_task_t task);
+
+#endif // XF_TASK_FAIR_IS_ENABLE
+
 /* ==================== [Macros] ============================================ */
 
 #ifdef __cplusplus
@@ -0,0 +1,110 @@
+/**
+ * @file xf_task_manager_internal.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 任务管理器对象的定义。
+ *        外部只通过 xf_task_manager_t 访问，这里公开定义是为了静态分配时计算大小。
+ * @version 0.1
+ * @date 2024-09-18
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_TASK_MANAGER_INTERNAL_H__
+#define __XF_TASK_MANAGER_INTERNAL_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "../port/xf_task_port_internal.h"
+#include "xf_task_base.h"
+
+/**
+ * @ingroup group_xf_task_internal
+ * @defgroup group_xf_task_internal_manager manager
+ * @brief 任务管理器对象。
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+#if XF_TASK_DEADLINE_IS_ENABLE || XF_TASK_FAIR_IS_ENABLE
+/**
+ * @brief 调度堆，节点数组由 manager 内的定长数组提供。
+ */
+typedef struct _xf_task_heap_t {
+    xf_task_heap_node_t **nodes;                    /*!< 按 key 排列的最小堆 */
+    uint32_t size;                                  /*!< 堆中的节点数 */
+} xf_task_heap_t;
+#endif // XF_TASK_DEADLINE_IS_ENABLE || XF_TASK_FAIR_IS_ENABLE
+
+/**
+ * @brief 任务管理器对象，xf_task_manager_t 指向它。
+ */
+typedef struct _xf_task_manager_handle_t {
+    xf_task_t current_task;                         /*!< 当前执行任务 */
+    xf_task_t urgent_queue[XF_TASK_URGENT_QUEUE_SIZE]; /*!< 紧急任务队列，单生产者单消费者 */
+    volatile uint32_t urgent_head;                  /*!< 紧急任务队列读位置，只由调度器修改 */
+    volatile uint32_t urgent_tail;                  /*!< 紧急任务队列写位置，只由设置紧急任务的一方修改 */
+    xf_list_t ready_list[XF_TASK_PRIORITY_LEVELS];  /*!< 任务就绪队列 */
+    xf_list_t blocked_list;                         /*!< 任务阻塞队列 */
+    xf_list_t suspend_list;                         /*!< 任务挂起队列，挂起任务不参与调度，需要手动恢复 */
+    xf_list_t destroy_list;                         /*!< 任务销毁队列，进行异步销毁 */
+    xf_task_on_idle_t on_idle;                      /*!< 空闲任务回调 */
+    bool is_static;                                 /*!< 内存由用户提供，删除时不释放 */
+#if XF_TASK_NTASK_FAST_IS_ENABLE
+    xf_list_t event_list;                           /*!< 周期为 0 的 ntask 队列，只在有任务被触发时扫描 */
+    volatile uint8_t event_pending;                 /*!< 有任务被触发，下一次调度需要扫描事件队列 */
+#endif // XF_TASK_NTASK_FAST_IS_ENABLE
+#if XF_TASK_HUNGER_IS_ENABLE
+    xf_list_t hunger_list;                          /*!< 任务饥饿队列，达到其指定值进行跳跃 */
+#endif // XF_TASK_HUNGER_IS_ENABLE
+#if XF_TASK_CONTEXT_IS_ENABLE
+    xf_task_context_t context;                      /*!< 调度器上下文 */
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+#if XF_TASK_DEADLINE_IS_ENABLE
+    xf_task_heap_node_t *deadline_nodes[XF_TASK_DEADLINE_MAX_TASKS];
+    xf_task_heap_t deadline_heap;                   /*!< 就绪的截止时间任务，按绝对截止时间排列 */
+    uint32_t deadline_tasks;                        /*!< 已准入的截止时间任务数 */
+    uint32_t utilization;                           /*!< 已准入的利用率，单位为千分之一 */
+    uint32_t deadline_miss;                         /*!< 所有任务错过截止时间的总次数 */
+#endif // XF_TASK_DEADLINE_IS_ENABLE
+#if XF_TASK_FAIR_IS_ENABLE
+    xf_task_heap_node_t *fair_nodes[XF_TASK_FAIR_MAX_TASKS];
+    xf_task_heap_t fair_heap;                       /*!< 就绪的公平调度任务，按虚拟运行时间排列 */
+    uint32_t fair_tasks;                            /*!< 公平调度任务数 */
+    xf_task_time_t min_vruntime;                    /*!< 单调递增的最小虚拟运行时间，新就绪的任务从这里开始 */
+#endif // XF_TASK_FAIR_IS_ENABLE
+#if XF_TASK_TRACE_IS_ENABLE
+    xf_task_trace_ring_t trace;                     /*!< 调度跟踪缓冲区 */
+#endif // XF_TASK_TRACE_IS_ENABLE
+#if XF_TASK_STATS_IS_ENABLE
+    xf_task_t last_task;                            /*!< 上一次执行的任务，用于统计切换次数 */
+    xf_task_manager_stats_t stats;                  /*!< 调度统计，elapsed 在这里保存开始计时的时间 */
+#endif // XF_TASK_STATS_IS_ENABLE
+#if XF_TASK_YIELD_CHECK_IS_ENABLE
+    volatile uint8_t yield_request;                 /*!< 有更高优先级的任务就绪，请求当前任务让出 */
+    xf_task_time_t slice_ticks;                     /*!< 时间片长度 */
+    xf_task_time_t slice_end;                       /*!< 当前任务时间片结束的时间 */
+#endif // XF_TASK_YIELD_CHECK_IS_ENABLE
+} xf_task_manager_handle_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of group_xf_task_internal_manager
+ * @}
+ */
+
+#endif // __XF_TASK_MANAGER_INTERNAL_H__
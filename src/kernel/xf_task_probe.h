@@ -0,0 +1,83 @@
+/**
+ * @file xf_task_probe.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief USDT 静态探针。
+ * @version 0.1
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_TASK_PROBE_H__
+#define __XF_TASK_PROBE_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_task_kernel_config.h"
+
+/**
+ * @ingroup group_xf_task_internal
+ * @defgroup group_xf_task_internal_probe probe
+ * @brief USDT 静态探针（xf_task 内部使用）。
+ *
+ * 开启后在调度的关键路径上放置 sys/sdt.h 风格的静态探针，provider 为 xf_task.
+ * 探针只是一条 nop 指令加上 ELF note，没有运行时依赖，未挂载跟踪器时几乎没有开销；
+ * 挂载后可以用 perf 或 bpftrace 在不重新编译的情况下观察线上程序，例如：
+ *
+ * @code
+ * perf probe -x ./app sdt_xf_task:dispatch__begin
+ * bpftrace -e 'usdt:./app:xf_task:dispatch__begin { @[arg0] = count(); }'
+ * @endcode
+ *
+ * | 探针 | 参数 |
+ * | --- | --- |
+ * | task__create | 任务，任务类型，优先级 |
+ * | task__delete | 任务 |
+ * | task__state | 任务，原状态，新状态 |
+ * | dispatch__begin | 任务，优先级 |
+ * | dispatch__end | 任务，让出后的状态 |
+ * | ctask__swap__in | 任务 |
+ * | ctask__swap__out | 任务 |
+ * | queue__block | 队列，任务，0 发送 / 1 接收 |
+ * | queue__wake | 队列，被唤醒的任务 |
+ * | mbus__publish | 总线，topic id，0 异步 / 1 同步 |
+ * @{
+ */
+
+#if XF_TASK_USDT_IS_ENABLE
+#include <sys/sdt.h>
+#endif // XF_TASK_USDT_IS_ENABLE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/* ==================== [Macros] ============================================ */
+
+#if XF_TASK_USDT_IS_ENABLE
+#define XF_TASK_PROBE1(name, a)             DTRACE_PROBE1(xf_task, name, a)
+#define XF_TASK_PROBE2(name, a, b)          DTRACE_PROBE2(xf_task, name, a, b)
+#define XF_TASK_PROBE3(name, a, b, c)       DTRACE_PROBE3(xf_task, name, a, b, c)
+#else
+#define XF_TASK_PROBE1(name, a)             do {} while (0)
+#define XF_TASK_PROBE2(name, a, b)          do {} while (0)
+#define XF_TASK_PROBE3(name, a, b, c)       do {} while (0)
+#endif // XF_TASK_USDT_IS_ENABLE
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of group_xf_task_internal_probe
+ * @}
+ */
+
+#endif // __XF_TASK_PROBE_H__
@@ -9,8 +9,8 @@
  * @copyright Copyright (c) 2024, CorAL. All rights reserved.
  *
  * @details 用法：
- * 在包含本文件前定义 `XF_HAL_TABLE_TYPE` 或 `XF_HAL_TABLE_STR` 可以
- * 生成枚举值或生成字符串。
+ * 在包含本文件前定义 `XF_TASK_REG_ENUM` 、 `XF_TASK_REG_EXTERN` 等可以
+ * 生成枚举值、注册函数，或者直接分派时的 switch 分支。
  */
 
 /* ==================== [Includes] ========================================== */
@@ -35,9 +35,25 @@
 #define XF_TASK_REG(name)        xf_##name##_vfunc_register();
 #endif
 
+#ifdef XF_TASK_REG_DISPATCH_EXTERN
+#define XF_TASK_REG(name)        extern xf_task_time_t xf_##name##_update(xf_task_t task); \
+                                 extern void xf_##name##_exec(xf_task_manager_t manager);
+#endif
+
+#ifdef XF_TASK_REG_UPDATE_CASE
+#define XF_TASK_REG(name)        case XF_TASK_TYPE_##name: return xf_##name##_update(task);
+#endif
+
+#ifdef XF_TASK_REG_EXEC_CASE
+#define XF_TASK_REG(name)        case XF_TASK_TYPE_##name: xf_##name##_exec(manager); return;
+#endif
+
 #undef XF_TASK_REG_ENUM
 #undef XF_TASK_REG_EXTERN
 #undef XF_TASK_REG_FUNCTION
+#undef XF_TASK_REG_DISPATCH_EXTERN
+#undef XF_TASK_REG_UPDATE_CASE
+#undef XF_TASK_REG_EXEC_CASE
 
 /* ==================== [Typedefs] ========================================== */
 
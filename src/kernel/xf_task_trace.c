@@ -0,0 +1,265 @@
+/**
+ * @file xf_task_trace.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 调度跟踪。
+ * @version 0.1
+ * @date 2024-09-05
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_task_trace.h"
+
+#if XF_TASK_TRACE_IS_ENABLE
+
+#include "xf_task_atomic.h"
+#include "../port/xf_task_port_internal.h"
+#include "../port/xf_task_port_config.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "task_trace"
+
+#define LINE_SIZE (256)             // 单个事件转换后的最大长度
+
+#define CHROME_HEAD "{\"traceEvents\":[\n"
+#define CHROME_TAIL "],\"displayTimeUnit\":\"ms\"}\n"
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 一行 JSON 的拼接缓冲区。
+ */
+typedef struct _xf_task_trace_line_t {
+    char buf[LINE_SIZE];
+    size_t len;
+} xf_task_trace_line_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void xf_task_trace_chrome_event(xf_task_trace_line_t *line, const xf_task_trace_event_t *event,
+                                       uint64_t ts);
+static void xf_task_trace_chrome_head(xf_task_trace_line_t *line, const char *name, const char *ph, uint64_t ts,
+                                      const void *tid);
+static void xf_task_trace_put_str(xf_task_trace_line_t *line, const char *str);
+static void xf_task_trace_put_u64(xf_task_trace_line_t *line, uint64_t value);
+
+/* ==================== [Static Variables] ================================== */
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_task_trace_enable(xf_task_manager_t manager, bool enable)
+{
+    XF_ASSERT(manager, XF_ERR_INVALID_ARG, TAG, "manager must not be NULL");
+
+    xf_task_trace_ring_t *ring = xf_task_manager_get_trace(manager);
+    ring->enable = enable ? 1 : 0;
+
+    return XF_OK;
+}
+
+xf_err_t xf_task_trace_clear(xf_task_manager_t manager)
+{
+    XF_ASSERT(manager, XF_ERR_INVALID_ARG, TAG, "manager must not be NULL");
+
+    xf_task_trace_ring_t *ring = xf_task_manager_get_trace(manager);
+    XF_TASK_ATOMIC_STORE(&ring->head, 0);
+
+    return XF_OK;
+}
+
+uint32_t xf_task_trace_read(xf_task_manager_t manager, xf_task_trace_event_t *events, uint32_t max)
+{
+    XF_ASSERT(manager, 0, TAG, "manager must not be NULL");
+    XF_ASSERT(events || max == 0, 0, TAG, "events must not be NULL");
+
+    xf_task_trace_ring_t *ring = xf_task_manager_get_trace(manager);
+    uint32_t head = XF_TASK_ATOMIC_LOAD(&ring->head);
+    uint32_t count = (head > XF_TASK_TRACE_BUFFER_SIZE) ? XF_TASK_TRACE_BUFFER_SIZE : head;
+    count = (count > max) ? max : count;
+
+    for (uint32_t i = 0; i < count; i++) {
+        events[i] = ring->events[(head - count + i) & (XF_TASK_TRACE_BUFFER_SIZE - 1)];
+    }
+
+    return count;
+}
+
+xf_err_t xf_task_trace_dump_chrome(xf_task_manager_t manager, xf_task_trace_write_t write, void *arg)
+{
+    XF_ASSERT(manager, XF_ERR_INVALID_ARG, TAG, "manager must not be NULL");
+    XF_ASSERT(write, XF_ERR_INVALID_ARG, TAG, "write must not be NULL");
+
+    xf_task_trace_ring_t *ring = xf_task_manager_get_trace(manager);
+    uint8_t enable = ring->enable;
+    ring->enable = 0;
+
+    uint32_t head = XF_TASK_ATOMIC_LOAD(&ring->head);
+    uint32_t count = (head > XF_TASK_TRACE_BUFFER_SIZE) ? XF_TASK_TRACE_BUFFER_SIZE : head;
+    uint32_t base = 0;
+    xf_task_trace_line_t line;
+
+    write(CHROME_HEAD, sizeof(CHROME_HEAD) - 1, arg);
+
+    for (uint32_t i = 0; i < count; i++) {
+        const xf_task_trace_event_t *event = &ring->events[(head - count + i) & (XF_TASK_TRACE_BUFFER_SIZE - 1)];
+        if (i == 0) {
+            base = event->ticks;
+        }
+
+        // 时间戳只保存了低 32 位，以第一个事件为起点按差值换算为微秒
+        uint64_t ts = (uint64_t)(uint32_t)(event->ticks - base) * 1000000ULL / XF_TASK_TICKS_FREQUENCY;
+
+        line.len = 0;
+        xf_task_trace_chrome_event(&line, event, ts);
+        if (line.len != 0) {
+            xf_task_trace_put_str(&line, (i + 1 < count) ? ",\n" : "\n");
+            write(line.buf, line.len, arg);
+        }
+    }
+
+    write(CHROME_TAIL, sizeof(CHROME_TAIL) - 1, arg);
+
+    ring->enable = enable;
+
+    return XF_OK;
+}
+
+void xf_task_trace_record(xf_task_manager_t manager, xf_task_trace_type_t type, const void *obj, uint32_t arg,
+                          uint16_t aux)
+{
+    xf_task_trace_ring_t *ring = xf_task_manager_get_trace(manager);
+
+    if (!ring->enable) {
+        return;
+    }
+
+    // 连续的空闲合并为一段：撤销上一次的空闲结束，不再记录新的空闲开始
+    if (type == XF_TASK_TRACE_IDLE_BEGIN) {
+        uint32_t head = XF_TASK_ATOMIC_LOAD(&ring->head);
+        xf_task_trace_event_t *last = &ring->events[(head - 1) & (XF_TASK_TRACE_BUFFER_SIZE - 1)];
+        if (head != 0 && last->type == XF_TASK_TRACE_IDLE_END && last->obj == obj
+                && XF_TASK_ATOMIC_CAS(&ring->head, &head, head - 1)) {
+            return;
+        }
+    }
+
+    uint32_t index = XF_TASK_ATOMIC_FETCH_ADD(&ring->head, 1);
+    xf_task_trace_event_t *event = &ring->events[index & (XF_TASK_TRACE_BUFFER_SIZE - 1)];
+
+    event->ticks = (uint32_t)xf_task_get_ticks();
+    event->type = (uint16_t)type;
+    event->aux = aux;
+    event->arg = arg;
+    event->obj = obj;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void xf_task_trace_chrome_event(xf_task_trace_line_t *line, const xf_task_trace_event_t *event,
+                                       uint64_t ts)
+{
+    switch (event->type) {
+    case XF_TASK_TRACE_TASK_BEGIN:
+        xf_task_trace_chrome_head(line, "run", "B", ts, event->obj);
+        xf_task_trace_put_str(line, ",\"args\":{\"prio\":");
+        xf_task_trace_put_u64(line, event->arg);
+        xf_task_trace_put_str(line, "}},\n");
+        // 与上一次触发连成箭头
+        xf_task_trace_chrome_head(line, "trigger", "f", ts, event->obj);
+        xf_task_trace_put_str(line, ",\"cat\":\"flow\",\"bp\":\"e\",\"id\":");
+        xf_task_trace_put_u64(line, (uintptr_t)event->obj);
+        xf_task_trace_put_str(line, "}");
+        break;
+    case XF_TASK_TRACE_TASK_END:
+        xf_task_trace_chrome_head(line, "run", "E", ts, event->obj);
+        xf_task_trace_put_str(line, ",\"args\":{\"state\":");
+        xf_task_trace_put_u64(line, event->arg);
+        xf_task_trace_put_str(line, "}}");
+        break;
+    case XF_TASK_TRACE_CTASK_YIELD:
+        xf_task_trace_chrome_head(line, "yield", "i", ts, event->obj);
+        xf_task_trace_put_str(line, ",\"s\":\"t\"}");
+        break;
+    case XF_TASK_TRACE_TRIGGER:
+        xf_task_trace_chrome_head(line, "trigger", "i", ts, event->obj);
+        xf_task_trace_put_str(line, ",\"s\":\"t\"},\n");
+        xf_task_trace_chrome_head(line, "trigger", "s", ts, event->obj);
+        xf_task_trace_put_str(line, ",\"cat\":\"flow\",\"id\":");
+        xf_task_trace_put_u64(line, (uintptr_t)event->obj);
+        xf_task_trace_put_str(line, "}");
+        break;
+    case XF_TASK_TRACE_IDLE_BEGIN:
+        xf_task_trace_chrome_head(line, "idle", "B", ts, NULL);
+        xf_task_trace_put_str(line, ",\"args\":{\"max_ms\":");
+        xf_task_trace_put_u64(line, event->arg);
+        xf_task_trace_put_str(line, "}}");
+        break;
+    case XF_TASK_TRACE_IDLE_END:
+        xf_task_trace_chrome_head(line, "idle", "E", ts, NULL);
+        xf_task_trace_put_str(line, "}");
+        break;
+    case XF_TASK_TRACE_MBUS_PUBLISH:
+        xf_task_trace_chrome_head(line, event->aux ? "pub_sync" : "pub_async", "i", ts, event->obj);
+        xf_task_trace_put_str(line, ",\"s\":\"t\",\"args\":{\"topic\":");
+        xf_task_trace_put_u64(line, event->arg);
+        xf_task_trace_put_str(line, "}}");
+        break;
+    case XF_TASK_TRACE_MBUS_DISPATCH_BEGIN:
+        xf_task_trace_chrome_head(line, "dispatch", "B", ts, event->obj);
+        xf_task_trace_put_str(line, ",\"args\":{\"topic\":");
+        xf_task_trace_put_u64(line, event->arg);
+        xf_task_trace_put_str(line, ",\"subs\":");
+        xf_task_trace_put_u64(line, event->aux);
+        xf_task_trace_put_str(line, "}}");
+        break;
+    case XF_TASK_TRACE_MBUS_DISPATCH_END:
+        xf_task_trace_chrome_head(line, "dispatch", "E", ts, event->obj);
+        xf_task_trace_put_str(line, "}");
+        break;
+    default:
+        break;
+    }
+}
+
+static void xf_task_trace_chrome_head(xf_task_trace_line_t *line, const char *name, const char *ph, uint64_t ts,
+                                      const void *tid)
+{
+    xf_task_trace_put_str(line, "{\"name\":\"");
+    xf_task_trace_put_str(line, name);
+    xf_task_trace_put_str(line, "\",\"ph\":\"");
+    xf_task_trace_put_str(line, ph);
+    xf_task_trace_put_str(line, "\",\"ts\":");
+    xf_task_trace_put_u64(line, ts);
+    xf_task_trace_put_str(line, ",\"pid\":1,\"tid\":");
+    xf_task_trace_put_u64(line, (uintptr_t)tid);
+}
+
+static void xf_task_trace_put_str(xf_task_trace_line_t *line, const char *str)
+{
+    while (*str != '\0' && line->len < LINE_SIZE) {
+        line->buf[line->len++] = *str++;
+    }
+}
+
+static void xf_task_trace_put_u64(xf_task_trace_line_t *line, uint64_t value)
+{
+    char digits[20];
+    size_t count = 0;
+
+    do {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    while (count != 0 && line->len < LINE_SIZE) {
+        line->buf[line->len++] = digits[--count];
+    }
+}
+
+#endif // XF_TASK_TRACE_IS_ENABLE
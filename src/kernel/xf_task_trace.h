@@ -0,0 +1,174 @@
+/**
+ * @file xf_task_trace.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 调度跟踪。
+ * @version 0.1
+ * @date 2024-09-05
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_TASK_TRACE_H__
+#define __XF_TASK_TRACE_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_task_kernel_config.h"
+#include "xf_task_manager.h"
+
+#if XF_TASK_TRACE_IS_ENABLE
+
+/**
+ * @ingroup group_xf_task_user
+ * @defgroup group_xf_task_user_trace trace
+ * @brief 调度跟踪。
+ *
+ * 调度器在任务执行、空闲、触发、ctask 让出以及 mbus 发布与分发时写入定长的二进制事件，
+ * 每个任务管理器一个环形缓冲区，写满后覆盖最早的事件。
+ * 需要时通过 xf_task_trace_dump_chrome 转换为 Chrome trace JSON，
+ * 可以直接用 chrome://tracing 或者 Perfetto UI 打开。
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 调度跟踪事件类型。
+ */
+typedef enum _xf_task_trace_type_t {
+    XF_TASK_TRACE_TASK_BEGIN = 0,       /*!< 开始执行任务，obj 为任务，arg 为优先级 */
+    XF_TASK_TRACE_TASK_END,             /*!< 任务让出，obj 为任务，arg 为任务状态 */
+    XF_TASK_TRACE_CTASK_YIELD,          /*!< ctask 切回调度器，obj 为任务 */
+    XF_TASK_TRACE_TRIGGER,              /*!< 任务被触发，obj 为被触发的任务 */
+    XF_TASK_TRACE_IDLE_BEGIN,           /*!< 进入空闲，obj 为任务管理器，arg 为最大空闲时间（ms） */
+    XF_TASK_TRACE_IDLE_END,             /*!< 退出空闲，obj 为任务管理器 */
+    XF_TASK_TRACE_MBUS_PUBLISH,         /*!< mbus 发布，obj 为总线，arg 为 topic id，aux 为 1 表示同步发布 */
+    XF_TASK_TRACE_MBUS_DISPATCH_BEGIN,  /*!< mbus 开始分发，obj 为总线，arg 为 topic id，aux 为订阅数 */
+    XF_TASK_TRACE_MBUS_DISPATCH_END,    /*!< mbus 分发结束，obj 为总线，arg 为 topic id */
+    _XF_TASK_TRACE_MAX,
+} xf_task_trace_type_t;
+
+/**
+ * @brief 调度跟踪事件。
+ */
+typedef struct _xf_task_trace_event_t {
+    uint32_t ticks;                     /*!< 时间戳的低 32 位 */
+    uint16_t type;                      /*!< 事件类型，见 @ref xf_task_trace_type_t */
+    uint16_t aux;                       /*!< 附加参数 */
+    uint32_t arg;                       /*!< 事件参数 */
+    const void *obj;                    /*!< 事件对象 */
+} xf_task_trace_event_t;
+
+/**
+ * @brief 调度跟踪环形缓冲区，内嵌在任务管理器中。
+ */
+typedef struct _xf_task_trace_ring_t {
+    volatile uint32_t head;             /*!< 已写入的事件总数，取模后为下一个写入位置 */
+    volatile uint8_t enable;            /*!< 是否记录 */
+    xf_task_trace_event_t events[XF_TASK_TRACE_BUFFER_SIZE];
+} xf_task_trace_ring_t;
+
+/**
+ * @brief 导出文本的输出函数。
+ *
+ * @param str 文本，不以 '\0' 结尾。
+ * @param len 文本长度。
+ * @param arg 用户参数。
+ */
+typedef void (*xf_task_trace_write_t)(const char *str, size_t len, void *arg);
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 打开或关闭调度跟踪，任务管理器创建后默认打开。
+ *
+ * @param manager 任务管理器对象。
+ * @param enable 是否记录。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_OK 设置成功
+ */
+xf_err_t xf_task_trace_enable(xf_task_manager_t manager, bool enable);
+
+/**
+ * @brief 清空调度跟踪缓冲区。
+ *
+ * @param manager 任务管理器对象。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_OK 清空成功
+ */
+xf_err_t xf_task_trace_clear(xf_task_manager_t manager);
+
+/**
+ * @brief 按时间顺序读取缓冲区中的事件（二进制导出）。
+ *
+ * @note 读取时最好先关闭跟踪，否则其他线程或中断中写入的事件可能不完整。
+ *
+ * @param manager 任务管理器对象。
+ * @param[out] events 事件数组。
+ * @param max 事件数组的长度。
+ * @return uint32_t 读取的事件数，超过 max 时只保留最新的 max 个
+ */
+uint32_t xf_task_trace_read(xf_task_manager_t manager, xf_task_trace_event_t *events, uint32_t max);
+
+/**
+ * @brief 将缓冲区中的事件转换为 Chrome trace JSON 输出。
+ *
+ * 任务执行与空闲显示为区间，任务以地址作为线程号，空闲的线程号为 0，mbus 以总线地址作为线程号；
+ * 触发显示为瞬时事件，并用箭头连到该任务下一次开始执行，便于观察触发到执行的延迟。
+ *
+ * @note 不需要额外内存，按行调用 write 输出。输出期间暂停记录，结束后恢复原来的状态。
+ *
+ * @param manager 任务管理器对象。
+ * @param write 输出函数。
+ * @param arg 输出函数的用户参数。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_OK 输出完成
+ */
+xf_err_t xf_task_trace_dump_chrome(xf_task_manager_t manager, xf_task_trace_write_t write, void *arg);
+
+/**
+ * @brief 记录一个调度跟踪事件（xf_task 内部使用）。
+ *
+ * @note 可以在中断或其他线程中调用，写入位置通过原子操作分配。
+ *
+ * @param manager 任务管理器对象。
+ * @param type 事件类型。
+ * @param obj 事件对象。
+ * @param arg 事件参数。
+ * @param aux 附加参数。
+ */
+void xf_task_trace_record(xf_task_manager_t manager, xf_task_trace_type_t type, const void *obj, uint32_t arg,
+                          uint16_t aux);
+
+/**
+ * @brief 获取任务管理器的调度跟踪缓冲区（xf_task 内部使用）。
+ *
+ * @param manager 任务管理器对象。
+ * @return xf_task_trace_ring_t* 调度跟踪缓冲区
+ */
+xf_task_trace_ring_t *xf_task_manager_get_trace(xf_task_manager_t manager);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of group_xf_task_user_trace
+ * @}
+ */
+
+#endif // XF_TASK_TRACE_IS_ENABLE
+
+#endif // __XF_TASK_TRACE_H__
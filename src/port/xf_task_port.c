@@ -32,6 +32,9 @@ static xf_task_create_context_t s_create_context = NULL;
 static xf_task_swap_context_t s_swap_context = NULL;
 #endif
 
+static uint32_t s_parallel_workers = 1;
+static xf_task_parallel_run_t s_parallel_run = NULL;
+
 /* ==================== [Macros] ============================================ */
 
 /* ==================== [Global Functions] ================================== */
@@ -77,6 +80,26 @@ void xf_task_context_swap(xf_task_manager_t manager, void *old_context, void *ne
 
 #endif // XF_TASK_CONTEXT_IS_ENABLE
 
+xf_err_t xf_task_parallel_init(uint32_t workers, xf_task_parallel_run_t run)
+{
+    XF_ASSERT(workers, XF_ERR_INVALID_ARG, TAG, "workers must not be 0");
+    XF_ASSERT(run || workers == 1, XF_ERR_INVALID_ARG, TAG, "run function must not be NULL");
+
+    s_parallel_workers = workers;
+    s_parallel_run = run;
+
+    return XF_OK;
+}
+
+uint32_t xf_task_parallel_get_workers(void)
+{
+    return (s_parallel_run == NULL) ? 1 : s_parallel_workers;
+}
+
+void xf_task_parallel_run(xf_task_parallel_entry_t entry, void *arg)
+{
+    s_parallel_run(s_parallel_workers, entry, arg);
+}
 
 int32_t xf_task_msec_to_ticks(int32_t msec)
 {
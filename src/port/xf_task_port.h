@@ -74,6 +74,24 @@ typedef void (*xf_task_swap_context_t)(xf_task_manager_t manager, void *old_cont
 
 #endif // XF_TASK_CONTEXT_IS_ENABLE
 
+/**
+ * @brief 并行执行的入口函数。
+ *
+ * @param index 线程序号，0 ~ workers - 1.
+ * @param arg 参数。
+ */
+typedef void (*xf_task_parallel_entry_t)(uint32_t index, void *arg);
+
+/**
+ * @brief 并行执行函数指针。在 workers 个线程上同时执行 entry(index, arg)，
+ *        调用线程自身执行 index 为 0 的部分，所有线程返回后才返回。
+ *
+ * @param workers 线程数。
+ * @param entry 入口函数。
+ * @param arg 参数。
+ */
+typedef void (*xf_task_parallel_run_t)(uint32_t workers, xf_task_parallel_entry_t entry, void *arg);
+
 /* ==================== [Global Prototypes] ================================= */
 
 /**
@@ -100,6 +118,17 @@ xf_err_t xf_task_tick_init(xf_task_clock_t clock);
 xf_err_t xf_task_context_init(xf_task_create_context_t create_context, xf_task_swap_context_t swap_context);
 #endif // XF_TASK_CONTEXT_IS_ENABLE
 
+/**
+ * @brief 对接多线程并行执行函数（可选）。不对接时并行接口在当前任务中分块协作执行。
+ *
+ * @param workers 并行线程数（包括调用线程），为 1 时等同于不对接。
+ * @param run 并行执行函数。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_OK 参数设置成功
+ */
+xf_err_t xf_task_parallel_init(uint32_t workers, xf_task_parallel_run_t run);
+
 /* ==================== [Macros] ============================================ */
 
 #ifdef __cplusplus
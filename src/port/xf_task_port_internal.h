@@ -35,6 +35,9 @@ void xf_task_context_swap(xf_task_manager_t manager, void *old_context, void *ne
 xf_task_context_t *xf_task_manager_get_context(xf_task_manager_t manager);
 #endif // XF_TASK_CONTEXT_IS_ENABLE
 
+uint32_t xf_task_parallel_get_workers(void);
+void xf_task_parallel_run(xf_task_parallel_entry_t entry, void *arg);
+
 int32_t xf_task_msec_to_ticks(int32_t msec);
 int32_t xf_task_ticks_to_msec(int32_t ticks);
 
@@ -11,9 +11,11 @@
 /* ==================== [Includes] ========================================== */
 
 #include "xf_ctask.h"
+#include "xf_ctask_internal.h"
 #include "../utils/xf_task_queue.h"
 #include "../port/xf_task_port_internal.h"
 #include "../kernel/xf_task_base.h"
+#include "../kernel/xf_task_probe.h"
 
 
 #if XF_TASK_CONTEXT_IS_ENABLE
@@ -24,31 +26,18 @@
 
 /* ==================== [Typedefs] ========================================== */
 
-typedef struct _xf_ctask_handle_t {
-    xf_task_base_t base;        /*!< 继承 task_base 父对象 */
-    size_t stack_size;          /*!< 任务上下文堆栈大小 */
-    xf_task_context_t context;  /*!< 任务上下文对象 */
-    void *stack;                /*!< 任务上下文堆栈地址 */
-    xf_list_t queue_node;       /*!< 队列等待 */
-} xf_ctask_handle_t;
-
-typedef struct _xf_ctask_queue_handle_t {
-    xf_task_queue_t queue;
-    xf_task_manager_t manager;
-    xf_list_t  send_waiting;
-    xf_list_t  receive_waiting;
-} xf_ctask_queue_handle_t;
-
 /* ==================== [Static Prototypes] ================================= */
 
 static void xf_task_context_entry(void *args);
 static void xf_ctask_reset(xf_task_t task);
 static void xf_ctask_yield(xf_task_manager_t manager);
 static void xf_ctask_resume(xf_task_manager_t manager);
-static xf_task_time_t xf_ctask_update(xf_task_t task);
-static void xf_ctask_exec(xf_task_manager_t manager);
 static xf_task_t xf_ctask_constructor(xf_task_manager_t manager, xf_task_func_t func, void *func_arg, uint16_t priority,
                                       void *config);
+static void xf_ctask_init(xf_ctask_handle_t *task, xf_task_manager_t manager, xf_task_func_t func, void *func_arg,
+                          uint16_t priority, size_t stack_size);
+static void xf_ctask_queue_init(xf_ctask_queue_handle_t *ctask_queue, xf_task_manager_t manager, size_t size,
+                                size_t count, bool is_static);
 
 /* ==================== [Static Variables] ================================== */
 
@@ -88,6 +77,40 @@ void xf_ctask_delay_with_manager(xf_task_manager_t manager, uint32_t delay_ms)
 
 }
 
+xf_task_t xf_ctask_create_static_with_manager(xf_task_manager_t manager, xf_task_func_t func, void *func_arg,
+        uint16_t priority, size_t stack_size, void *storage)
+{
+    XF_ASSERT(manager, NULL, TAG, "manager must not be NULL");
+    XF_ASSERT(func, NULL, TAG, "func must not be NULL");
+    XF_ASSERT(priority < XF_TASK_PRIORITY_LEVELS, NULL, TAG, "priority must less than %d", XF_TASK_PRIORITY_LEVELS);
+    XF_ASSERT(stack_size > 0, NULL, TAG, "stack_size must more than 0");
+    XF_ASSERT(storage, NULL, TAG, "storage must not be NULL");
+
+    xf_ctask_handle_t *task = (xf_ctask_handle_t *)storage;
+
+    xf_ctask_init(task, manager, func, func_arg, priority, stack_size);
+    // 删除后只从调度器中移除，不释放用户提供的内存
+    xf_task_base_set_delete(&task->base, xf_task_static_destructor);
+
+    return (xf_task_t)task;
+}
+
+#if XF_TASK_YIELD_CHECK_IS_ENABLE
+bool xf_ctask_yield_if_needed_with_manager(xf_task_manager_t manager)
+{
+    XF_ASSERT(manager, false, TAG, "manager must not be NULL");
+
+    if (!xf_task_should_yield_with_manager(manager)) {
+        return false;
+    }
+
+    // 立即超时，下次调度与同优先级的任务排队
+    xf_ctask_delay_with_manager(manager, 0);
+
+    return true;
+}
+#endif // XF_TASK_YIELD_CHECK_IS_ENABLE
+
 xf_ctask_queue_t xf_ctask_queue_create_with_manager(xf_task_manager_t  manager, const size_t size, const size_t count)
 {
     XF_ASSERT(manager, NULL, TAG, "manager must not be NULL");
@@ -102,15 +125,22 @@ xf_ctask_queue_t xf_ctask_queue_create_with_manager(xf_task_manager_t  manager,
         return NULL;
     }
 
-    xf_bzero(ctask_queue, sizeof(xf_ctask_queue_handle_t) + size * count);
+    xf_ctask_queue_init(ctask_queue, manager, size, count, false);
 
-    void *data = (uint8_t *)ctask_queue + sizeof(xf_ctask_queue_handle_t);
+    return (xf_ctask_queue_t)ctask_queue;
+}
 
-    ctask_queue->manager = manager;
+xf_ctask_queue_t xf_ctask_queue_create_static_with_manager(xf_task_manager_t manager, const size_t size,
+        const size_t count, void *storage)
+{
+    XF_ASSERT(manager, NULL, TAG, "manager must not be NULL");
+    XF_ASSERT(size, NULL, TAG, "size must not be 0");
+    XF_ASSERT(count, NULL, TAG, "count must not be 0");
+    XF_ASSERT(storage, NULL, TAG, "storage must not be NULL");
 
-    xf_task_queue_init(&ctask_queue->queue, data, size, count);
-    xf_list_init(&ctask_queue->receive_waiting);
-    xf_list_init(&ctask_queue->send_waiting);
+    xf_ctask_queue_handle_t *ctask_queue = (xf_ctask_queue_handle_t *)storage;
+
+    xf_ctask_queue_init(ctask_queue, manager, size, count, true);
 
     return (xf_ctask_queue_t)ctask_queue;
 }
@@ -119,6 +149,10 @@ void xf_ctask_queue_delete(xf_ctask_queue_t queue)
 {
     XF_ASSERT(queue, XF_RETURN_VOID, TAG, "queue must not be NULL");
 
+    if (((xf_ctask_queue_handle_t *)queue)->is_static) {
+        return;
+    }
+
     xf_free(queue);
 }
 
@@ -149,8 +183,11 @@ xf_err_t xf_ctask_queue_send(xf_ctask_queue_t queue, void *buffer, uint32_t time
     while (1) {
         if (xf_task_queue_is_full(_queue)) {
             xf_list_add_tail(queue_node, send_waiting);
+            XF_TASK_PROBE3(queue__block, queue, task, 0);
             // 这里有可能会被接收方唤醒，从而延时未达到timeout
             xf_ctask_delay_with_manager(manager, timeout);
+            // 超时返回时还在等待队列中，需要移出，否则下次等待会重复加入
+            xf_list_del_init(queue_node);
             // 达到超时返回发送失败
             if (task->timeout >= 0) {
                 XF_LOGD(TAG, "queue timeout");
@@ -164,6 +201,7 @@ xf_err_t xf_ctask_queue_send(xf_ctask_queue_t queue, void *buffer, uint32_t time
             // 将 receive_waiting 全部加入就绪，等待调度器选择最合适的任务
             xf_list_for_each_entry_safe(receive_task, _receive_task, receive_waiting, xf_ctask_handle_t, queue_node) {
                 xf_list_del_init(&receive_task->queue_node);
+                XF_TASK_PROBE2(queue__wake, queue, receive_task);
                 xf_task_trigger(receive_task);
             }
 
@@ -199,8 +237,11 @@ xf_err_t xf_ctask_queue_receive(xf_ctask_queue_t queue, void *buffer, uint32_t t
     while (1) {
         if (xf_task_queue_is_empty(_queue)) {
             xf_list_add_tail(queue_node, receive_waiting);
+            XF_TASK_PROBE3(queue__block, queue, task, 1);
             // 这里有可能会被发送方唤醒，从而延时未达到timeout
             xf_ctask_delay_with_manager(manager, timeout);
+            // 超时返回时还在等待队列中，需要移出，否则下次等待会重复加入
+            xf_list_del_init(queue_node);
             // 达到超时返回发送失败
             if (task->timeout >= 0) {
                 XF_LOGD(TAG, "queue timeout");
@@ -214,6 +255,7 @@ xf_err_t xf_ctask_queue_receive(xf_ctask_queue_t queue, void *buffer, uint32_t t
             // 将send_waiting全部加入就绪，等待调度器选择最合适的任务
             xf_list_for_each_entry_safe(send_task, _send_task, send_waiting, xf_ctask_handle_t, queue_node) {
                 xf_list_del_init(&send_task->queue_node);
+                XF_TASK_PROBE2(queue__wake, queue, send_task);
                 xf_task_trigger(send_task);
             }
 
@@ -222,6 +264,41 @@ xf_err_t xf_ctask_queue_receive(xf_ctask_queue_t queue, void *buffer, uint32_t t
     }
 }
 
+xf_task_time_t xf_ctask_update(xf_task_t task)
+{
+    xf_ctask_handle_t *handle = (xf_ctask_handle_t *)task;
+
+    xf_task_time_t time_ticks = xf_task_get_ticks();
+
+    int32_t timeout = time_ticks - handle->base.weakup;
+
+    // 转换超时时间，如果大于零则触发超时
+    handle->base.timeout = xf_task_ticks_to_msec(timeout);
+
+    if (timeout >= 0) {
+        BITS_SET1(handle->base.signal, XF_TASK_SIGNAL_TIMEOUT);
+    }
+
+    // 对超时信号响应
+    if (BITS_CHECK(handle->base.signal, XF_TASK_SIGNAL_TIMEOUT)) {
+        BITS_SET0(handle->base.signal, XF_TASK_SIGNAL_TIMEOUT);
+        BITS_SET1(handle->base.signal, XF_TASK_SIGNAL_READY);
+    }
+
+    // 对事件信号响应
+    if (BITS_CHECK(handle->base.signal, XF_TASK_SIGNAL_EVENT)) {
+        BITS_SET0(handle->base.signal, XF_TASK_SIGNAL_EVENT);
+        BITS_SET1(handle->base.signal, XF_TASK_SIGNAL_READY);
+    }
+
+    return time_ticks;
+}
+
+void xf_ctask_exec(xf_task_manager_t manager)
+{
+    xf_ctask_resume(manager);
+}
+
 /* ==================== [Static Functions] ================================== */
 
 static xf_task_t xf_ctask_constructor(xf_task_manager_t manager, xf_task_func_t func, void *func_arg, uint16_t priority,
@@ -238,48 +315,41 @@ static xf_task_t xf_ctask_constructor(xf_task_manager_t manager, xf_task_func_t
         return NULL;
     }
 
+    xf_ctask_init(task, manager, func, func_arg, priority, stack_size);
+
+    return (xf_task_t)task;
+}
+
+static void xf_ctask_init(xf_ctask_handle_t *task, xf_task_manager_t manager, xf_task_func_t func, void *func_arg,
+                          uint16_t priority, size_t stack_size)
+{
+    // 堆栈紧跟在任务对象之后
     task->stack = (void *)((uint8_t *)task + sizeof(xf_ctask_handle_t));
 
     xf_task_base_init(&task->base, manager, XF_TASK_TYPE_CTASK, priority, func, func_arg);
 
-    task->stack_size = ((xf_ctask_config_t *)config)->stack_size;
+    task->stack_size = stack_size;
     xf_task_context_create(manager, xf_task_context_entry, &task->context, task->stack, task->stack_size);
 
     xf_list_init(&task->queue_node);
 
-
-    return (xf_task_t)task;
+    // 从创建时刻开始计时，weakup 为 0 时与当前时间的差值超过 int32 范围会被当成未到期，要等到回绕才执行
+    task->base.weakup = xf_task_get_ticks();
 }
 
-
-static xf_task_time_t xf_ctask_update(xf_task_t task)
+static void xf_ctask_queue_init(xf_ctask_queue_handle_t *ctask_queue, xf_task_manager_t manager, size_t size,
+                                size_t count, bool is_static)
 {
-    xf_ctask_handle_t *handle = (xf_ctask_handle_t *)task;
-
-    xf_task_time_t time_ticks = xf_task_get_ticks();
-
-    int32_t timeout = time_ticks - handle->base.weakup;
-
-    // 转换超时时间，如果大于零则触发超时
-    handle->base.timeout = xf_task_ticks_to_msec(timeout);
-
-    if (timeout >= 0) {
-        BITS_SET1(handle->base.signal, XF_TASK_SIGNAL_TIMEOUT);
-    }
+    xf_bzero(ctask_queue, sizeof(xf_ctask_queue_handle_t) + size * count);
 
-    // 对超时信号响应
-    if (BITS_CHECK(handle->base.signal, XF_TASK_SIGNAL_TIMEOUT)) {
-        BITS_SET0(handle->base.signal, XF_TASK_SIGNAL_TIMEOUT);
-        BITS_SET1(handle->base.signal, XF_TASK_SIGNAL_READY);
-    }
+    void *data = (uint8_t *)ctask_queue + sizeof(xf_ctask_queue_handle_t);
 
-    // 对事件信号响应
-    if (BITS_CHECK(handle->base.signal, XF_TASK_SIGNAL_EVENT)) {
-        BITS_SET0(handle->base.signal, XF_TASK_SIGNAL_EVENT);
-        BITS_SET1(handle->base.signal, XF_TASK_SIGNAL_READY);
-    }
+    ctask_queue->manager = manager;
+    ctask_queue->is_static = is_static;
 
-    return time_ticks;
+    xf_task_queue_init(&ctask_queue->queue, data, size, count);
+    xf_list_init(&ctask_queue->receive_waiting);
+    xf_list_init(&ctask_queue->send_waiting);
 }
 
 static void xf_ctask_reset(xf_task_t task)
@@ -289,6 +359,7 @@ static void xf_ctask_reset(xf_task_t task)
     handle->base.delay = 0;
 
     xf_task_base_reset(&handle->base);
+    handle->base.weakup = xf_task_get_ticks();
 
     xf_list_del_init(&handle->queue_node);
 
@@ -308,6 +379,7 @@ static void xf_task_context_entry(void *args)
     // 函数运行到结尾，设置结尾标志位
     xf_task_delete(task);
     // 函数运行完毕，回到调度器
+    XF_TASK_PROBE1(ctask__swap__out, task);
     xf_task_context_swap(manager, &task->context, xf_task_manager_get_context(manager));
 }
 
@@ -321,7 +393,12 @@ static void xf_ctask_yield(xf_task_manager_t manager)
         return ;
     }
 
+#if XF_TASK_TRACE_IS_ENABLE
+    xf_task_trace_record(manager, XF_TASK_TRACE_CTASK_YIELD, task, 0, 0);
+#endif // XF_TASK_TRACE_IS_ENABLE
+
     // 跳出函数，进入调度器
+    XF_TASK_PROBE1(ctask__swap__out, task);
     xf_task_context_swap(manager, &task->context, xf_task_manager_get_context(manager));
 }
 
@@ -337,12 +414,8 @@ static void xf_ctask_resume(xf_task_manager_t manager)
 
     // 跳出调度器，进入函数
     xf_task_base_set_state(task, XF_TASK_STATE_RUNNING);
+    XF_TASK_PROBE1(ctask__swap__in, task);
     xf_task_context_swap(manager, xf_task_manager_get_context(manager), &task->context);
 }
 
-static void xf_ctask_exec(xf_task_manager_t manager)
-{
-    xf_ctask_resume(manager);
-}
-
 #endif // XF_TASK_CONTEXT_IS_ENABLE
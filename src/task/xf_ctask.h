@@ -37,6 +37,46 @@ extern "C" {
  */
 #define XF_TASK_TYPE_CTASK XF_TASK_TYPE_ctask
 
+/**
+ * @brief 静态创建 ctask 所需的内存大小（含堆栈），见 xf_ctask_create_static_with_manager.
+ *
+ * @note 展开时需要 ctask 对象的完整定义，包含 xf_task.h 即可。
+ *
+ * @param stack_size 任务上下文堆栈大小。
+ */
+#define XF_CTASK_STORAGE_SIZE(stack_size) (sizeof(xf_ctask_handle_t) + (stack_size))
+
+/**
+ * @brief 定义静态创建 ctask 所需的内存（含堆栈），对齐与对象一致。
+ *
+ * 例如 `static XF_CTASK_STORAGE_DEFINE(s_worker, 4096);` ，之后传入 `&s_worker` 创建，
+ * 创建时的 stack_size 不能超过这里定义的大小。
+ *
+ * @param name 变量名。
+ * @param stack_size 任务上下文堆栈大小。
+ */
+#define XF_CTASK_STORAGE_DEFINE(name, stack_size) \
+    union { xf_ctask_handle_t handle; uint8_t bytes[XF_CTASK_STORAGE_SIZE(stack_size)]; } name
+
+/**
+ * @brief 静态创建 ctask 消息队列所需的内存大小（含队列数据），
+ *        见 xf_ctask_queue_create_static_with_manager.
+ *
+ * @param size 消息队列的大小。
+ * @param count 消息队列的数量。
+ */
+#define XF_CTASK_QUEUE_STORAGE_SIZE(size, count) (sizeof(xf_ctask_queue_handle_t) + (size) * (count))
+
+/**
+ * @brief 定义静态创建 ctask 消息队列所需的内存（含队列数据），对齐与对象一致。
+ *
+ * @param name 变量名。
+ * @param size 消息队列的大小。
+ * @param count 消息队列的数量。
+ */
+#define XF_CTASK_QUEUE_STORAGE_DEFINE(name, size, count) \
+    union { xf_ctask_queue_handle_t handle; uint8_t bytes[XF_CTASK_QUEUE_STORAGE_SIZE(size, count)]; } name
+
 /* ==================== [Typedefs] ========================================== */
 
 /**
@@ -72,6 +112,25 @@ xf_task_t xf_ctask_create_with_manager(
     return xf_task_create_with_manager(manager, XF_TASK_TYPE_CTASK, func, func_arg, priority, &config);
 }
 
+/**
+ * @brief 在用户提供的内存上创建 ctask，不申请堆内存。
+ *
+ * 堆栈紧跟在任务对象之后，与 xf_ctask_create_with_manager 的内存布局相同。
+ *
+ * @note 任务删除后只从任务管理器中移除，不释放 storage ，
+ *       空闲回收之后 storage 可以再次用于创建任务。
+ *
+ * @param manager 指定的任务管理器。
+ * @param func 任务执行的函数。
+ * @param func_arg 用户自定义执行函数参数。
+ * @param priority 任务优先级。
+ * @param stack_size 任务上下文堆栈大小。
+ * @param storage 任务内存，至少 XF_CTASK_STORAGE_SIZE(stack_size) 字节，通常由 XF_CTASK_STORAGE_DEFINE 定义。
+ * @return xf_task_t 任务对象，返回为 NULL 则表示参数错误
+ */
+xf_task_t xf_ctask_create_static_with_manager(xf_task_manager_t manager, xf_task_func_t func, void *func_arg,
+        uint16_t priority, size_t stack_size, void *storage);
+
 /**
  * @brief ctask 专用 delay 函数，在 ctask 中才能使用。不会影响调度器。
  *
@@ -80,6 +139,19 @@ xf_task_t xf_ctask_create_with_manager(
  */
 void xf_ctask_delay_with_manager(xf_task_manager_t manager, uint32_t delay_ms);
 
+#if XF_TASK_YIELD_CHECK_IS_ENABLE
+/**
+ * @brief ctask 在需要时让出 CPU，见 xf_task_should_yield_with_manager.
+ *
+ * @note 不需要让出时直接返回，开销只有一次检查，适合放在长循环中。
+ *
+ * @param manager 任务管理器对象。
+ * @return true 已经让出并重新被调度
+ * @return false 不需要让出
+ */
+bool xf_ctask_yield_if_needed_with_manager(xf_task_manager_t manager);
+#endif // XF_TASK_YIELD_CHECK_IS_ENABLE
+
 /**
  * @brief 创建 ctask 的消息队列。此消息队列仅供 ctask 使用。
  *
@@ -91,6 +163,30 @@ void xf_ctask_delay_with_manager(xf_task_manager_t manager, uint32_t delay_ms);
 xf_ctask_queue_t xf_ctask_queue_create_with_manager(
     xf_task_manager_t manager, const size_t size, const size_t count);
 
+/**
+ * @brief 在用户提供的内存上创建 ctask 的消息队列，不申请堆内存。
+ *
+ * @note 删除时不释放 storage 。
+ *
+ * @param manager 任务管理器对象。
+ * @param size 消息队列的大小。
+ * @param count 消息队列的数量。
+ * @param storage 队列内存，至少 XF_CTASK_QUEUE_STORAGE_SIZE(size, count) 字节，
+ *                通常由 XF_CTASK_QUEUE_STORAGE_DEFINE 定义。
+ * @return xf_ctask_queue_t 消息队列的对象，返回为 NULL 则表示参数错误
+ */
+xf_ctask_queue_t xf_ctask_queue_create_static_with_manager(
+    xf_task_manager_t manager, const size_t size, const size_t count, void *storage);
+
+/**
+ * @brief 删除 ctask 的消息队列。
+ *
+ * @note 删除前需要确保没有任务在等待该队列。
+ *
+ * @param queue 消息队列对象。
+ */
+void xf_ctask_queue_delete(xf_ctask_queue_t queue);
+
 /**
  * @brief 消息队列发送。
  *
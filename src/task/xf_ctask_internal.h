@@ -0,0 +1,77 @@
+/**
+ * @file xf_ctask_internal.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief ctask 与 ctask 消息队列对象的定义。
+ *        外部只通过句柄访问，这里公开定义是为了静态分配时计算大小。
+ * @version 0.1
+ * @date 2024-09-18
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_CTASK_INTERNAL_H__
+#define __XF_CTASK_INTERNAL_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_ctask.h"
+#include "../port/xf_task_port_internal.h"
+#include "../kernel/xf_task_base.h"
+#include "../utils/xf_task_queue.h"
+
+/**
+ * @ingroup group_xf_task_internal
+ * @defgroup group_xf_task_internal_ctask ctask
+ * @brief ctask 对象。
+ * @{
+ */
+
+#if XF_TASK_CONTEXT_IS_ENABLE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief ctask 对象，继承 xf_task_base_t ，堆栈紧跟在对象之后。
+ */
+typedef struct _xf_ctask_handle_t {
+    xf_task_base_t base;        /*!< 继承 task_base 父对象 */
+    size_t stack_size;          /*!< 任务上下文堆栈大小 */
+    xf_task_context_t context;  /*!< 任务上下文对象 */
+    void *stack;                /*!< 任务上下文堆栈地址 */
+    xf_list_t queue_node;       /*!< 队列等待 */
+} xf_ctask_handle_t;
+
+/**
+ * @brief ctask 消息队列对象，队列数据紧跟在对象之后。
+ */
+typedef struct _xf_ctask_queue_handle_t {
+    xf_task_queue_t queue;      /*!< 队列 */
+    xf_task_manager_t manager;  /*!< 队列所属的任务管理器 */
+    xf_list_t  send_waiting;    /*!< 等待发送的任务 */
+    xf_list_t  receive_waiting; /*!< 等待接收的任务 */
+    bool is_static;             /*!< 内存由用户提供，删除时不释放 */
+} xf_ctask_queue_handle_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+
+/**
+ * End of group_xf_task_internal_ctask
+ * @}
+ */
+
+#endif // __XF_CTASK_INTERNAL_H__
@@ -12,6 +12,7 @@
 /* ==================== [Includes] ========================================== */
 
 #include "xf_ntask.h"
+#include "xf_ntask_internal.h"
 
 #include "../kernel/xf_task_base.h"
 #include "../port/xf_task_port_internal.h"
@@ -22,21 +23,14 @@
 
 /* ==================== [Typedefs] ========================================== */
 
-typedef struct _xf_ntask_handle_t {
-    xf_task_base_t base;    /*!< 继承父对象 */
-    uint32_t count;         /*!< 记录 ntask 剩余循环次数 */
-    uint32_t count_max;     /*!< 记录 ntask 循环次数上限 */
-    uint32_t lc;            /*!< 无栈协程保存上下文位置 */
-    void    *ptr_hook;      /*!< 无栈协程保存变量的钩子指针 */
-} xf_ntask_handle_t;
-
 /* ==================== [Static Prototypes] ================================= */
 
 static void xf_ntask_reset(xf_task_t task);
-static xf_task_time_t xf_ntask_update(xf_task_t task);
-static void xf_ntask_exec(xf_task_manager_t manager);
+static void xf_ntask_rate_advance(xf_ntask_handle_t *task);
 static xf_task_t xf_ntask_constructor(xf_task_manager_t manager, xf_task_func_t func, void *func_arg, uint16_t priority,
                                       void *config);
+static void xf_ntask_init(xf_ntask_handle_t *task, xf_task_manager_t manager, xf_task_func_t func, void *func_arg,
+                          uint16_t priority, xf_ntask_config_t *config);
 
 /* ==================== [Static Variables] ================================== */
 
@@ -56,6 +50,24 @@ void xf_ntask_vfunc_register(void)
     xf_task_vfunc_register(XF_TASK_TYPE_NTASK, &_ntask_vfunc);
 }
 
+xf_task_t xf_ntask_create_static_with_manager(xf_task_manager_t manager, xf_task_func_t func, void *func_arg,
+        uint16_t priority, uint32_t delay_ms, uint32_t count, void *storage)
+{
+    XF_ASSERT(manager, NULL, TAG, "manager must not be NULL");
+    XF_ASSERT(func, NULL, TAG, "func must not be NULL");
+    XF_ASSERT(priority < XF_TASK_PRIORITY_LEVELS, NULL, TAG, "priority must less than %d", XF_TASK_PRIORITY_LEVELS);
+    XF_ASSERT(storage, NULL, TAG, "storage must not be NULL");
+
+    xf_ntask_handle_t *task = (xf_ntask_handle_t *)storage;
+    xf_ntask_config_t config = {.count = count, .delay_ms = delay_ms};
+
+    xf_ntask_init(task, manager, func, func_arg, priority, &config);
+    // 删除后只从调度器中移除，不释放用户提供的内存
+    xf_task_base_set_delete(&task->base, xf_task_static_destructor);
+
+    return (xf_task_t)task;
+}
+
 xf_err_t xf_ntask_set_count(xf_task_t task, uint32_t count)
 {
     XF_ASSERT(task, XF_ERR_INVALID_ARG, TAG, "task must not be NULL");
@@ -152,6 +164,66 @@ void *xf_ntask_get_hook_ptr(xf_task_t task)
     return handle->ptr_hook;
 }
 
+xf_err_t xf_ntask_set_rate(xf_task_t task, xf_ntask_rate_t rate)
+{
+    XF_ASSERT(task, XF_ERR_INVALID_ARG, TAG, "task must not be NULL");
+    XF_ASSERT(rate <= XF_NTASK_RATE_COALESCE, XF_ERR_INVALID_ARG, TAG, "rate is invalid");
+
+    xf_ntask_handle_t *handle = (xf_ntask_handle_t *)task;
+
+    if (handle->base.type != XF_TASK_TYPE_NTASK) {
+        XF_LOGE(TAG, "task must be ntask");
+        return XF_ERR_INVALID_ARG;
+    }
+
+    handle->rate = rate;
+
+    return XF_OK;
+}
+
+uint32_t xf_ntask_get_overrun(xf_task_t task)
+{
+    XF_ASSERT(task, 0, TAG, "task must not be NULL");
+
+    xf_ntask_handle_t *handle = (xf_ntask_handle_t *)task;
+
+    return handle->overrun;
+}
+
+xf_task_time_t xf_ntask_update(xf_task_t task)
+{
+    xf_task_time_t time_ticks = xf_task_get_ticks();
+
+    xf_ntask_update_at((xf_ntask_handle_t *)task, time_ticks);
+
+    return time_ticks;
+}
+
+void xf_ntask_exec(xf_task_manager_t manager)
+{
+    xf_ntask_handle_t *task = (xf_ntask_handle_t *)xf_task_manager_get_current_task(manager);
+
+    xf_task_base_set_state(task, XF_TASK_STATE_RUNNING);
+    task->base.func(task);
+
+#if XF_TASK_DEADLINE_IS_ENABLE
+    // 无栈协程回到起点才算完成一个作业，作业中途等待或让出时保持截止时间
+    if (task->lc == 0 && task->base.deadline != NULL) {
+        xf_task_deadline_job_done(task);
+    }
+#endif // XF_TASK_DEADLINE_IS_ENABLE
+
+    if (task->base.delay == 0) {
+        return;
+    }
+
+    if (task->rate == XF_NTASK_RATE_NONE) {
+        task->base.weakup = xf_task_get_ticks() + task->base.delay;
+    } else {
+        xf_ntask_rate_advance(task);
+    }
+}
+
 /* ==================== [Static Functions] ================================== */
 
 static xf_task_t xf_ntask_constructor(xf_task_manager_t manager, xf_task_func_t func, void *func_arg, uint16_t priority,
@@ -164,22 +236,27 @@ static xf_task_t xf_ntask_constructor(xf_task_manager_t manager, xf_task_func_t
         return NULL;
     }
 
+    xf_ntask_init(task, manager, func, func_arg, priority, config);
 
-    xf_ntask_config_t *ntask_config = config;
+    return (xf_task_t)task;
+}
 
-    uint32_t ticks = xf_task_msec_to_ticks(ntask_config->delay_ms);
+static void xf_ntask_init(xf_ntask_handle_t *task, xf_task_manager_t manager, xf_task_func_t func, void *func_arg,
+                          uint16_t priority, xf_ntask_config_t *config)
+{
+    uint32_t ticks = xf_task_msec_to_ticks(config->delay_ms);
 
     xf_task_base_init(&task->base, manager, XF_TASK_TYPE_NTASK, priority, func, func_arg);
 
     task->base.delay = ticks;
-    task->count = ntask_config->count;
+    task->count = config->count;
     task->lc = 0;
-    task->count_max = ntask_config->count;
+    task->count_max = config->count;
     task->ptr_hook = NULL;
+    task->rate = XF_NTASK_RATE_NONE;
+    task->overrun = 0;
 
     task->base.weakup = xf_task_get_ticks() + ticks;
-
-    return (xf_task_t)task;
 }
 
 static void xf_ntask_reset(xf_task_t task)
@@ -190,62 +267,46 @@ static void xf_ntask_reset(xf_task_t task)
 
     handle->count = handle->count_max;  // 重置计数器
     handle ->lc = 0;                    // 重置协程
+    handle->overrun = 0;
     handle->base.weakup = xf_task_get_ticks() + handle->base.delay; // 重置唤醒时间
 }
 
-static void xf_ntask_time_handle(xf_task_t task, uint32_t time_ticks)
+static void xf_ntask_rate_advance(xf_ntask_handle_t *task)
 {
-    xf_ntask_handle_t *handle = (xf_ntask_handle_t *)task;
-
-    int32_t timeout = time_ticks - handle->base.weakup;
+    xf_task_time_t now = xf_task_get_ticks();
+    int32_t late = now - task->base.weakup;
 
-    // 计数器到0，停止更新，进入删除状态
-    if (handle->count == 0) {
-        xf_task_delete(task);
+    // 被触发提前执行，周期点还没到，不推进
+    if (late < 0) {
         return;
     }
 
-    // 转换超时时间，如果大于零则触发超时
-    handle->base.timeout = xf_task_ticks_to_msec(timeout);
-    if (timeout >= 0) {
-        BITS_SET1(handle->base.signal, XF_TASK_SIGNAL_TIMEOUT);
-        // 根据循环次数重置循环结束点
-        handle->count = (handle->count != XF_NTASK_INFINITE_LOOP) ? (handle->count - 1) : (handle->count);
-    }
-
-}
-
-static xf_task_time_t xf_ntask_update(xf_task_t task)
-{
-    xf_ntask_handle_t *handle = (xf_ntask_handle_t *)task;
-    xf_task_time_t time_ticks = xf_task_get_ticks();
-
-    if (handle->base.delay != 0) {
-        xf_ntask_time_handle(task, time_ticks);
-    }
-
-    if (BITS_CHECK(handle->base.signal, XF_TASK_SIGNAL_TIMEOUT)) {
-        BITS_SET0(handle->base.signal, XF_TASK_SIGNAL_TIMEOUT);
-        BITS_SET1(handle->base.signal, XF_TASK_SIGNAL_READY);
-    }
-
-    if (BITS_CHECK(handle->base.signal, XF_TASK_SIGNAL_EVENT)) {
-        BITS_SET0(handle->base.signal, XF_TASK_SIGNAL_EVENT);
-        BITS_SET1(handle->base.signal, XF_TASK_SIGNAL_READY);
+    task->base.weakup += task->base.delay;
+    late -= task->base.delay;
+    if (late < 0) {
+        return;
     }
 
-    return time_ticks;
-}
-
-static void xf_ntask_exec(xf_task_manager_t manager)
-{
-    xf_ntask_handle_t *task = (xf_ntask_handle_t *)xf_task_manager_get_current_task(manager);
-
-    xf_task_base_set_state(task, XF_TASK_STATE_RUNNING);
-    task->base.func(task);
-
-    if (task->base.delay != 0) {
-        task->base.weakup = xf_task_get_ticks() + task->base.delay;
+    // 下一个周期点也已经过去，missed 为已经到期的周期点数
+    uint32_t missed = (uint32_t)late / task->base.delay + 1;
+
+    switch (task->rate) {
+    case XF_NTASK_RATE_SKIP:
+        // 跳到当前时间之后的第一个周期点
+        task->base.weakup += (xf_task_time_t)missed * task->base.delay;
+        task->overrun += missed;
+        break;
+    case XF_NTASK_RATE_BURST:
+        // 保持周期点不变，逐个补执行
+        task->overrun++;
+        break;
+    case XF_NTASK_RATE_COALESCE:
+        // 合并到最近一个已经到期的周期点，只执行一次
+        task->base.weakup += (xf_task_time_t)(missed - 1) * task->base.delay;
+        task->overrun += missed - 1;
+        break;
+    default:
+        break;
     }
 }
 
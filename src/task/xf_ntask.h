@@ -37,6 +37,22 @@ extern "C"
 #define XF_TASK_TYPE_NTASK XF_TASK_TYPE_ntask
 #define XF_NTASK_INFINITE_LOOP ((uint32_t) - 1) /*!< ntask 无限循环 */
 
+/**
+ * @brief 静态创建 ntask 所需的内存大小，见 xf_ntask_create_static_with_manager.
+ *
+ * @note 展开时需要 ntask 对象的完整定义，包含 xf_task.h 即可。
+ */
+#define XF_NTASK_STORAGE_SIZE (sizeof(xf_ntask_handle_t))
+
+/**
+ * @brief 定义静态创建 ntask 所需的内存，对齐与对象一致。
+ *
+ * 例如 `static XF_NTASK_STORAGE_DEFINE(s_led);` ，之后传入 `&s_led` 创建。
+ *
+ * @param name 变量名。
+ */
+#define XF_NTASK_STORAGE_DEFINE(name) xf_ntask_handle_t name
+
 /* ==================== [Typedefs] ========================================== */
 
 /**
@@ -47,6 +63,16 @@ typedef struct _xf_ntask_config_t {
     uint32_t delay_ms; /*!< ntask 循环间隔时间 */
 } xf_ntask_config_t;
 
+/**
+ * @brief ntask 周期模式。
+ */
+typedef enum _xf_ntask_rate_t {
+    XF_NTASK_RATE_NONE = 0,         /*!< 固定间隔（默认），执行完成后再等待一个周期，周期会随执行时间漂移 */
+    XF_NTASK_RATE_SKIP,             /*!< 固定速率，错过的周期直接跳过，在下一个周期点执行 */
+    XF_NTASK_RATE_BURST,            /*!< 固定速率，错过的周期逐个连续补执行 */
+    XF_NTASK_RATE_COALESCE,         /*!< 固定速率，错过的周期合并为一次立即执行 */
+} xf_ntask_rate_t;
+
 /**
  * @brief ntask 信号量结构体。
  */
@@ -93,6 +119,24 @@ static inline xf_task_t xf_ntask_create_loop_with_manager(
     return xf_task_create_with_manager(manager, XF_TASK_TYPE_NTASK, func, func_arg, priority, &config);
 }
 
+/**
+ * @brief 在用户提供的内存上创建 ntask，不申请堆内存。
+ *
+ * @note 任务删除后只从任务管理器中移除，不释放 storage ，
+ *       空闲回收之后 storage 可以再次用于创建任务。
+ *
+ * @param manager 任务管理器对象。
+ * @param func 任务执行的函数。
+ * @param func_arg 用户自定义执行函数参数。
+ * @param priority 任务优先级。
+ * @param delay_ms 任务延时周期。
+ * @param count 任务循环的次数上限。
+ * @param storage 任务内存，至少 @ref XF_NTASK_STORAGE_SIZE 字节，通常由 XF_NTASK_STORAGE_DEFINE 定义。
+ * @return xf_task_t task 对象。返回为 NULL 则表示参数错误
+ */
+xf_task_t xf_ntask_create_static_with_manager(xf_task_manager_t manager, xf_task_func_t func, void *func_arg,
+        uint16_t priority, uint32_t delay_ms, uint32_t count, void *storage);
+
 /**
  * @brief 设置 ntask 循环次数。其不能超过循环次数的上限。
  *
@@ -134,6 +178,31 @@ xf_err_t xf_ntask_count_add_once(xf_task_t task);
  */
 xf_err_t xf_ntask_set_count_max(xf_task_t task, uint32_t count_max);
 
+/**
+ * @brief 设置 ntask 的周期模式。
+ *
+ * 固定速率模式下，唤醒时间按 weakup += delay 推进，执行时间与调度延迟不会累积到周期上，
+ * 周期点相对创建（或设置）时刻保持固定相位。执行完成时下一个周期点已经过去则记为超限，
+ * 并按模式处理错过的周期。
+ *
+ * @note 被 xf_task_trigger 提前唤醒的执行不会推进周期点。
+ *
+ * @param task 任务对象。
+ * @param rate 周期模式。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_OK 设置成功
+ */
+xf_err_t xf_ntask_set_rate(xf_task_t task, xf_ntask_rate_t rate);
+
+/**
+ * @brief 获取 ntask 错过的周期数。
+ *
+ * @param task 任务对象。
+ * @return uint32_t 错过的周期数，SKIP 为跳过的周期数，BURST 为补执行的周期数，COALESCE 为合并掉的周期数
+ */
+uint32_t xf_ntask_get_overrun(xf_task_t task);
+
 /**
  * @brief 设置 ntask 的上下文位置（无栈协程专属）。
  *
@@ -310,6 +379,35 @@ void *xf_ntask_get_hook_ptr(xf_task_t task);
         }                                           \
     } while (0)
 
+/**
+ * @brief 无栈协程在需要时让出 CPU 执行权，见 xf_task_should_yield_with_manager.
+ *
+ * 让出前触发自己，下次调度与同优先级的任务排队后从这里继续执行，不推进周期，也不消耗循环次数。
+ * 不需要让出时开销只有一次检查，适合放在长循环中。
+ *
+ * @attention 与其他 XF_NTASK_* 宏一样，让出后局部变量不会保留，循环变量需要放在静态变量或钩子指针中。
+ */
+#if XF_TASK_YIELD_CHECK_IS_ENABLE
+#define XF_NTASK_YIELD_IF_NEEDED()                                                          \
+    do                                                                                      \
+    {                                                                                       \
+        if (xf_task_should_yield_with_manager(xf_task_get_manager(__xf_now_task)))          \
+        {                                                                                   \
+            __xf_task_yield_flag = 0;                                                       \
+            xf_ntask_set_lc(__xf_now_task, __LINE__);                                       \
+            xf_task_trigger(__xf_now_task);                                                 \
+        /* FALLTHRU */                                                                      \
+        case __LINE__:                                                                      \
+            if (__xf_task_yield_flag == 0)                                                  \
+            {                                                                               \
+                return;                                                                     \
+            }                                                                               \
+        }                                                                                   \
+    } while (0)
+#else
+#define XF_NTASK_YIELD_IF_NEEDED() do {} while (0)
+#endif // XF_TASK_YIELD_CHECK_IS_ENABLE
+
 /**
  * @brief 无栈协程计数信号量初始化。
  *
@@ -0,0 +1,105 @@
+/**
+ * @file xf_ntask_internal.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief ntask 对象的定义。
+ *        外部只通过 xf_task_t 访问，这里公开定义是为了静态分配时计算大小。
+ * @version 0.1
+ * @date 2024-09-18
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_NTASK_INTERNAL_H__
+#define __XF_NTASK_INTERNAL_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_ntask.h"
+#include "../kernel/xf_task_base.h"
+#include "../port/xf_task_port_internal.h"
+
+/**
+ * @ingroup group_xf_task_internal
+ * @defgroup group_xf_task_internal_ntask ntask
+ * @brief ntask 对象。
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief ntask 对象，继承 xf_task_base_t.
+ */
+typedef struct _xf_ntask_handle_t {
+    xf_task_base_t base;    /*!< 继承父对象 */
+    uint32_t count;         /*!< 记录 ntask 剩余循环次数 */
+    uint32_t count_max;     /*!< 记录 ntask 循环次数上限 */
+    uint32_t lc;            /*!< 无栈协程保存上下文位置 */
+#if XF_TASK_COMPACT_IS_ENABLE
+    uint32_t rate:    2;    /*!< 周期模式，见 @ref xf_ntask_rate_t */
+    uint32_t overrun: 30;   /*!< 固定速率模式下错过的周期数 */
+#else
+    uint32_t rate;          /*!< 周期模式，见 @ref xf_ntask_rate_t */
+    uint32_t overrun;       /*!< 固定速率模式下错过的周期数 */
+#endif // XF_TASK_COMPACT_IS_ENABLE
+    void    *ptr_hook;      /*!< 无栈协程保存变量的钩子指针 */
+} xf_ntask_handle_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 按给定的时间更新 ntask 的信号，超时或者被触发时设置就绪信号。
+ *        xf_ntask_update 与 ntask 专用的快速扫描共用，快速扫描一次调度只读取一次时钟。
+ *
+ * @param task ntask 对象。
+ * @param time_ticks 当前时间。
+ */
+static inline void xf_ntask_update_at(xf_ntask_handle_t *task, xf_task_time_t time_ticks)
+{
+    if (task->base.delay != 0) {
+        int32_t timeout = time_ticks - task->base.weakup;
+
+        if (task->count == 0) {
+            // 计数器到0，停止更新，进入删除状态
+            xf_task_delete(task);
+        } else {
+            // 转换超时时间，如果大于零则触发超时
+            task->base.timeout = xf_task_ticks_to_msec(timeout);
+            if (timeout >= 0) {
+                BITS_SET1(task->base.signal, XF_TASK_SIGNAL_TIMEOUT);
+                // 根据循环次数重置循环结束点
+                task->count = (task->count != XF_NTASK_INFINITE_LOOP) ? (task->count - 1) : (task->count);
+            }
+        }
+    }
+
+    if (BITS_CHECK(task->base.signal, XF_TASK_SIGNAL_TIMEOUT)) {
+        BITS_SET0(task->base.signal, XF_TASK_SIGNAL_TIMEOUT);
+        BITS_SET1(task->base.signal, XF_TASK_SIGNAL_READY);
+    }
+
+    if (BITS_CHECK(task->base.signal, XF_TASK_SIGNAL_EVENT)) {
+        BITS_SET0(task->base.signal, XF_TASK_SIGNAL_EVENT);
+        BITS_SET1(task->base.signal, XF_TASK_SIGNAL_READY);
+    }
+}
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of group_xf_task_internal_ntask
+ * @}
+ */
+
+#endif // __XF_NTASK_INTERNAL_H__
@@ -38,6 +38,15 @@ xf_err_t xf_task_manager_default_init(xf_task_on_idle_t on_idle)
     return XF_OK;
 }
 
+xf_err_t xf_task_manager_default_init_static(xf_task_on_idle_t on_idle, void *storage)
+{
+    default_manager = xf_task_manager_create_static(on_idle, storage);
+    if (default_manager == NULL) {
+        return XF_FAIL;
+    }
+    return XF_OK;
+}
+
 xf_err_t xf_task_manager_set_default_idle(xf_task_on_idle_t on_idle)
 {
     return xf_task_manager_set_idle(default_manager, on_idle); 
@@ -58,6 +67,13 @@ xf_err_t xf_task_set_urgent_task(xf_task_t task, bool force)
     return xf_task_set_urgent_task_with_manager(default_manager, task, force);
 }
 
+#if XF_TASK_YIELD_CHECK_IS_ENABLE
+bool xf_task_should_yield(void)
+{
+    return xf_task_should_yield_with_manager(default_manager);
+}
+#endif // XF_TASK_YIELD_CHECK_IS_ENABLE
+
 xf_task_t xf_task_create(xf_task_type_t type, xf_task_func_t func, void *func_arg, uint16_t priority, void *config)
 {
     return xf_task_create_with_manager(default_manager, type, func, func_arg, priority, config);
@@ -43,6 +43,17 @@ extern "C" {
  */
 xf_err_t xf_task_manager_default_init(xf_task_on_idle_t on_idle);
 
+/**
+ * @brief 在用户提供的内存上创建默认的任务管理器，见 xf_task_manager_create_static.
+ *
+ * @param on_idle 空闲回调函数。
+ * @param storage 任务管理器内存，至少 @ref XF_TASK_MANAGER_STORAGE_SIZE 字节。
+ * @return xf_err_t
+ *      - XF_FAIL 参数错误
+ *      - XF_OK 创建成功
+ */
+xf_err_t xf_task_manager_default_init_static(xf_task_on_idle_t on_idle, void *storage);
+
 /**
  * @brief 设置默认任务管理器的空闲回调函数
  * 
@@ -66,17 +77,29 @@ xf_task_manager_t xf_task_get_default_manager(void);
 void xf_task_manager_run_default(void);
 
 /**
- * @brief 基于默认 manager，将任务设置为紧急任务，下次调度立即执行。
+ * @brief 基于默认 manager，将任务设置为紧急任务，见 @ref xf_task_set_urgent_task_with_manager.
  *
  * @param task 设置为紧急任务的任务。
- * @param force 如果设置为 true，则覆盖任务。设置为 false，当前有紧急任务则设置失败。
+ * @param force 不再使用，只为兼容旧接口保留。紧急任务总是排在已有紧急任务之后。
  * @return xf_err_t
  *      - XF_OK 设置成功
  *      - XF_ERR_INVALID_ARG 无效参数
- *      - XF_ERR_BUSY 设置失败，`force == false` 且当前已存在紧急任务
+ *      - XF_ERR_BUSY 设置失败，紧急任务队列已满
  */
 xf_err_t xf_task_set_urgent_task(xf_task_t task, bool force);
 
+#if XF_TASK_YIELD_CHECK_IS_ENABLE
+
+/**
+ * @brief 基于默认 manager，判断当前任务是否应该让出 CPU.
+ *
+ * @return true 应该让出
+ * @return false 可以继续执行，或者不是在任务中调用
+ */
+bool xf_task_should_yield(void);
+
+#endif // XF_TASK_YIELD_CHECK_IS_ENABLE
+
 /**
  * @brief 基于默认 manager，创建任务。
  *
@@ -0,0 +1,133 @@
+/**
+ * @file xf_task_static_table.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 静态任务表。在编译时声明一组固定的任务，生成它们的内存与创建函数。
+ * @version 0.1
+ * @date 2024-09-20
+ * @note 一个源文件只能展开一个任务表。
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 用法：
+ * 1. 编写任务表文件（例如 app_tasks.inc ），每行声明一个任务，至少一个：
+ *    - `XF_TASK_TABLE_NTASK(name, func, arg, priority, delay_ms, count)`
+ *    - `XF_TASK_TABLE_CTASK(name, func, arg, priority, stack_size)`
+ * 2. 在声明了任务函数的源文件中定义 `XF_TASK_TABLE_FILE` 后包含本文件：
+ *    @code
+ *    #define XF_TASK_TABLE_FILE "app_tasks.inc"
+ *    #include "task/xf_task_static_table.h"
+ *    @endcode
+ * 3. 调用 xf_task_table_init 创建默认任务管理器与表中全部任务，之后照常调用 xf_task_manager_run_default.
+ *
+ * 任务管理器与任务的内存都在编译时分配，运行时不申请堆内存；优先级等参数在编译时检查。
+ * 任务 id 为 `XF_TASK_TABLE_ID_<name>` ，通过 xf_task_table_get 获取任务对象。
+ * 配合 XF_TASK_DIRECT_DISPATCH_ENABLE ，调度器的更新与执行也不再经过虚函数表。
+ */
+
+#ifndef __XF_TASK_STATIC_TABLE_H__
+#define __XF_TASK_STATIC_TABLE_H__
+
+#ifndef XF_TASK_TABLE_FILE
+#error "XF_TASK_TABLE_FILE must be defined before including xf_task_static_table.h"
+#endif
+
+/* ==================== [Includes] ========================================== */
+
+#include "../xf_task.h"
+
+/**
+ * @ingroup group_xf_task_user
+ * @defgroup group_xf_task_user_static_table static table
+ * @brief 静态任务表。
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief 任务 id ，按任务表中的顺序排列，XF_TASK_TABLE_COUNT 为任务数。
+ */
+enum {
+#define XF_TASK_TABLE_ENUM
+#include "xf_task_static_table_rule.h"
+#include XF_TASK_TABLE_FILE
+    XF_TASK_TABLE_COUNT,
+};
+
+#define XF_TASK_TABLE_CHECK
+#include "xf_task_static_table_rule.h"
+#include XF_TASK_TABLE_FILE
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Variables] ================================== */
+
+static XF_TASK_MANAGER_STORAGE_DEFINE(_xf_task_table_manager);
+
+#define XF_TASK_TABLE_STORAGE
+#include "xf_task_static_table_rule.h"
+#include XF_TASK_TABLE_FILE
+
+static xf_task_t _xf_task_table_tasks[XF_TASK_TABLE_COUNT];
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 创建默认任务管理器，并按任务表的顺序创建全部任务。
+ *
+ * @param on_idle 空闲回调函数。
+ * @return xf_err_t
+ *      - XF_FAIL 创建失败
+ *      - XF_OK 创建成功
+ */
+static inline xf_err_t xf_task_table_init(xf_task_on_idle_t on_idle)
+{
+    if (xf_task_manager_default_init_static(on_idle, &_xf_task_table_manager) != XF_OK) {
+        return XF_FAIL;
+    }
+
+    xf_task_manager_t manager = xf_task_get_default_manager();
+
+#define XF_TASK_TABLE_CREATE
+#include "xf_task_static_table_rule.h"
+#include XF_TASK_TABLE_FILE
+
+    for (uint32_t i = 0; i < XF_TASK_TABLE_COUNT; i++) {
+        if (_xf_task_table_tasks[i] == NULL) {
+            return XF_FAIL;
+        }
+    }
+
+    return XF_OK;
+}
+
+/**
+ * @brief 获取任务表中的任务对象。
+ *
+ * @param id 任务 id ，即 XF_TASK_TABLE_ID_<name> 。
+ * @return xf_task_t 任务对象，id 超出范围或者还没有创建时返回 NULL
+ */
+static inline xf_task_t xf_task_table_get(uint32_t id)
+{
+    return (id < XF_TASK_TABLE_COUNT) ? _xf_task_table_tasks[id] : NULL;
+}
+
+/* ==================== [Macros] ============================================ */
+
+#undef XF_TASK_TABLE_NTASK
+#undef XF_TASK_TABLE_CTASK
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of group_xf_task_user_static_table
+ * @}
+ */
+
+#endif // __XF_TASK_STATIC_TABLE_H__
@@ -0,0 +1,70 @@
+/**
+ * @file xf_task_static_table_rule.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 静态任务表的展开规则。
+ * @version 0.1
+ * @date 2024-09-20
+ * @note 此文件不需要防止重复包含。
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 用法：
+ * 在包含本文件前定义 `XF_TASK_TABLE_ENUM` 、 `XF_TASK_TABLE_CHECK` 、
+ * `XF_TASK_TABLE_STORAGE` 或 `XF_TASK_TABLE_CREATE` ，之后包含的任务表
+ * 分别展开为任务 id 、编译时检查、任务内存或创建任务的语句。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "../xf_task_config_internal.h"
+
+/* ==================== [Defines] =========================================== */
+
+#ifdef XF_TASK_TABLE_NTASK
+#undef XF_TASK_TABLE_NTASK
+#endif
+
+#ifdef XF_TASK_TABLE_CTASK
+#undef XF_TASK_TABLE_CTASK
+#endif
+
+#ifdef XF_TASK_TABLE_ENUM
+#define XF_TASK_TABLE_NTASK(name, func, arg, priority, delay_ms, count)     XF_TASK_TABLE_ID_##name,
+#define XF_TASK_TABLE_CTASK(name, func, arg, priority, stack_size)          XF_TASK_TABLE_ID_##name,
+#endif
+
+#ifdef XF_TASK_TABLE_CHECK
+// 优先级超出范围、ctask 未启用或者堆栈大小为 0 时这里编译报错
+#define XF_TASK_TABLE_NTASK(name, func, arg, priority, delay_ms, count) \
+    typedef char _xf_task_table_check_##name[((priority) < XF_TASK_PRIORITY_LEVELS) ? 1 : -1];
+#define XF_TASK_TABLE_CTASK(name, func, arg, priority, stack_size) \
+    typedef char _xf_task_table_check_##name[((priority) < XF_TASK_PRIORITY_LEVELS \
+            && XF_TASK_CONTEXT_IS_ENABLE && (stack_size) > 0) ? 1 : -1];
+#endif
+
+#ifdef XF_TASK_TABLE_STORAGE
+#define XF_TASK_TABLE_NTASK(name, func, arg, priority, delay_ms, count) \
+    static XF_NTASK_STORAGE_DEFINE(_xf_task_table_##name);
+#define XF_TASK_TABLE_CTASK(name, func, arg, priority, stack_size) \
+    static XF_CTASK_STORAGE_DEFINE(_xf_task_table_##name, stack_size);
+#endif
+
+#ifdef XF_TASK_TABLE_CREATE
+#define XF_TASK_TABLE_NTASK(name, func, arg, priority, delay_ms, count) \
+    _xf_task_table_tasks[XF_TASK_TABLE_ID_##name] = xf_ntask_create_static_with_manager(manager, func, arg, \
+            priority, delay_ms, count, &_xf_task_table_##name);
+#define XF_TASK_TABLE_CTASK(name, func, arg, priority, stack_size) \
+    _xf_task_table_tasks[XF_TASK_TABLE_ID_##name] = xf_ctask_create_static_with_manager(manager, func, arg, \
+            priority, stack_size, &_xf_task_table_##name);
+#endif
+
+#undef XF_TASK_TABLE_ENUM
+#undef XF_TASK_TABLE_CHECK
+#undef XF_TASK_TABLE_STORAGE
+#undef XF_TASK_TABLE_CREATE
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/* ==================== [Macros] ============================================ */
@@ -0,0 +1,460 @@
+/**
+ * @file xf_task_future.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 任务结果（future）。
+ * @version 0.1
+ * @date 2024-08-26
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_task_utils_config.h"
+
+#if XF_TASK_FUTURE_IS_ENABLE
+
+#include "xf_task_future.h"
+#include "../kernel/xf_task_base.h"
+#include "../task/xf_ntask.h"
+#include "../task/xf_ctask.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "task_future"
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct _xf_task_future_then_t {
+    xf_list_t node;
+    xf_task_future_func_t func;
+    void *arg;
+    bool embedded;                  // 内嵌在组合 future 中，不需要单独释放
+} xf_task_future_then_t;
+
+typedef struct _xf_task_future_waiter_t {
+    xf_list_t node;
+    xf_task_t task;
+} xf_task_future_waiter_t;
+
+typedef struct _xf_task_future_handle_t {
+    xf_task_manager_t manager;
+    xf_task_t task;                 // 产生结果的任务，没有或者已经销毁则为 NULL
+    xf_task_func_t func;            // 任务原本的执行函数
+    void *value;
+    xf_err_t err;
+    bool done;
+    bool busy;                      // 正在执行续体，期间的删除延后处理
+    bool released;                  // 用户已经删除
+    xf_list_t wait_list;            // 阻塞等待的 ctask
+    xf_list_t then_list;            // 续体
+    uint32_t remain;                // 组合 future 还需要等待的个数
+    uint32_t combo_count;
+    xf_task_future_then_t *combo;   // 组合 future 挂在被组合 future 上的续体
+} xf_task_future_handle_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static xf_task_future_handle_t *xf_task_future_alloc(xf_task_manager_t manager, uint32_t combo_count);
+static void xf_task_future_try_free(xf_task_future_handle_t *future);
+static void xf_task_future_entry(xf_task_t task);
+static void xf_task_future_task_delete(xf_task_t task);
+static void xf_task_future_trigger_cb(xf_task_future_t future, void *arg);
+static void xf_task_future_all_cb(xf_task_future_t future, void *arg);
+static void xf_task_future_any_cb(xf_task_future_t future, void *arg);
+static xf_task_future_t xf_task_future_combine(const xf_task_future_t *futures, uint32_t count,
+        xf_task_future_func_t func);
+
+/* ==================== [Static Variables] ================================== */
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_task_future_t xf_task_future_create_with_manager(xf_task_manager_t manager)
+{
+    XF_ASSERT(manager, NULL, TAG, "manager must not be NULL");
+
+    return xf_task_future_alloc(manager, 0);
+}
+
+xf_task_future_t xf_task_spawn_future_with_manager(xf_task_manager_t manager, xf_task_type_t type,
+        xf_task_func_t func, void *func_arg, uint16_t priority, void *config)
+{
+    XF_ASSERT(manager, NULL, TAG, "manager must not be NULL");
+    XF_ASSERT(func, NULL, TAG, "func must not be NULL");
+
+    xf_task_future_handle_t *future = xf_task_future_alloc(manager, 0);
+    if (future == NULL) {
+        return NULL;
+    }
+
+    xf_task_t task = xf_task_create_with_manager(manager, type, xf_task_future_entry, func_arg, priority, config);
+    if (task == NULL) {
+        xf_free(future);
+        return NULL;
+    }
+
+    // 与任务池一样，通过替换 delete 得知任务在完成前被删除
+    xf_task_base_t *task_base = (xf_task_base_t *)task;
+    if (xf_task_base_set_delete(task_base, xf_task_future_task_delete) != XF_OK) {
+        xf_task_delete(task);
+        xf_free(future);
+        return NULL;
+    }
+    task_base->user_data = future;
+    future->task = task;
+    future->func = func;
+
+    return future;
+}
+
+xf_err_t xf_task_future_delete(xf_task_future_t future)
+{
+    XF_ASSERT(future, XF_ERR_INVALID_ARG, TAG, "future must not be NULL");
+    xf_task_future_handle_t *handle = (xf_task_future_handle_t *)future;
+
+    if (!xf_list_empty(&handle->wait_list)) {
+        XF_LOGE(TAG, "future has waiting tasks");
+        return XF_ERR_BUSY;
+    }
+
+    handle->released = true;
+    xf_task_future_try_free(handle);
+
+    return XF_OK;
+}
+
+xf_task_future_t xf_task_future_of(xf_task_t task)
+{
+    XF_ASSERT(task, NULL, TAG, "task must not be NULL");
+    xf_task_base_t *task_base = (xf_task_base_t *)task;
+
+    if (XF_TASK_DELETE(task_base) != xf_task_future_task_delete) {
+        return NULL;
+    }
+
+    return task_base->user_data;
+}
+
+xf_err_t xf_task_future_resolve(xf_task_future_t future, xf_err_t err, void *value)
+{
+    XF_ASSERT(future, XF_ERR_INVALID_ARG, TAG, "future must not be NULL");
+    xf_task_future_handle_t *handle = (xf_task_future_handle_t *)future;
+
+    if (handle->done) {
+        return XF_ERR_INVALID_STATE;
+    }
+
+    handle->done = true;
+    handle->err = err;
+    handle->value = value;
+
+    // 唤醒所有阻塞等待的 ctask，由调度器按优先级执行
+    xf_task_future_waiter_t *waiter, *_waiter;
+    xf_list_for_each_entry_safe(waiter, _waiter, &handle->wait_list, xf_task_future_waiter_t, node) {
+        xf_list_del_init(&waiter->node);
+        xf_task_trigger(waiter->task);
+    }
+
+    // 续体中可能删除当前 future 或者其他 future，每次都从头取
+    handle->busy = true;
+    while (!xf_list_empty(&handle->then_list)) {
+        xf_task_future_then_t *then = xf_list_first_entry(&handle->then_list, xf_task_future_then_t, node);
+        bool embedded = then->embedded;
+        xf_list_del_init(&then->node);
+        then->func(future, then->arg);
+        if (!embedded) {
+            xf_free(then);
+        }
+    }
+    handle->busy = false;
+
+    xf_task_future_try_free(handle);
+
+    return XF_OK;
+}
+
+bool xf_task_future_is_done(xf_task_future_t future)
+{
+    XF_ASSERT(future, false, TAG, "future must not be NULL");
+    xf_task_future_handle_t *handle = (xf_task_future_handle_t *)future;
+
+    return handle->done;
+}
+
+xf_err_t xf_task_future_get(xf_task_future_t future, void **value)
+{
+    XF_ASSERT(future, XF_ERR_INVALID_ARG, TAG, "future must not be NULL");
+    xf_task_future_handle_t *handle = (xf_task_future_handle_t *)future;
+
+    if (!handle->done) {
+        return XF_ERR_BUSY;
+    }
+
+    if (value != NULL) {
+        *value = handle->value;
+    }
+
+    return handle->err;
+}
+
+xf_err_t xf_task_future_wait(xf_task_future_t future, uint32_t timeout, void **value)
+{
+    XF_ASSERT(future, XF_ERR_INVALID_ARG, TAG, "future must not be NULL");
+    xf_task_future_handle_t *handle = (xf_task_future_handle_t *)future;
+
+    if (handle->done) {
+        return xf_task_future_get(future, value);
+    }
+
+#if XF_TASK_CONTEXT_IS_ENABLE
+    xf_task_t current = xf_task_manager_get_current_task(handle->manager);
+    xf_task_future_waiter_t waiter;
+
+    // 只有ctask才能阻塞等待
+    if (current == NULL || XF_TASK_TYPE_CTASK != xf_task_get_type(current)) {
+        XF_LOGE(TAG, "task must ctask");
+        return XF_ERR_NOT_SUPPORTED;
+    }
+
+    waiter.task = current;
+    xf_list_init(&waiter.node);
+
+    while (!handle->done) {
+        xf_list_add_tail(&waiter.node, &handle->wait_list);
+        // 这里有可能会被 future 完成时唤醒，从而延时未达到timeout
+        xf_ctask_delay_with_manager(handle->manager, timeout);
+        xf_list_del_init(&waiter.node);
+
+        if (!handle->done && xf_task_get_timeout(current) >= 0) {
+            XF_LOGD(TAG, "future timeout");
+            return XF_ERR_TIMEOUT;
+        }
+        // 没达到超时进入循环继续进行接下来的超时
+        timeout = -xf_task_get_timeout(current);
+    }
+
+    return xf_task_future_get(future, value);
+#else
+    UNUSED(timeout);
+    UNUSED(value);
+    XF_LOGE(TAG, "ctask is disabled");
+    return XF_ERR_NOT_SUPPORTED;
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+}
+
+xf_err_t xf_task_future_then(xf_task_future_t future, xf_task_future_func_t func, void *arg)
+{
+    XF_ASSERT(future, XF_ERR_INVALID_ARG, TAG, "future must not be NULL");
+    XF_ASSERT(func, XF_ERR_INVALID_ARG, TAG, "func must not be NULL");
+    xf_task_future_handle_t *handle = (xf_task_future_handle_t *)future;
+
+    if (handle->done) {
+        func(future, arg);
+        return XF_OK;
+    }
+
+    xf_task_future_then_t *then = (xf_task_future_then_t *)xf_malloc(sizeof(xf_task_future_then_t));
+    if (then == NULL) {
+        XF_LOGE(TAG, "memory alloc failed!");
+        return XF_ERR_NO_MEM;
+    }
+
+    then->func = func;
+    then->arg = arg;
+    then->embedded = false;
+    xf_list_init(&then->node);
+    xf_list_add_tail(&then->node, &handle->then_list);
+
+    return XF_OK;
+}
+
+xf_err_t xf_task_future_watch(xf_task_future_t future, xf_task_t task)
+{
+    XF_ASSERT(future, XF_ERR_INVALID_ARG, TAG, "future must not be NULL");
+    XF_ASSERT(task, XF_ERR_INVALID_ARG, TAG, "task must not be NULL");
+
+    // 已经完成时不需要再触发
+    if (xf_task_future_is_done(future)) {
+        return XF_OK;
+    }
+
+    return xf_task_future_then(future, xf_task_future_trigger_cb, task);
+}
+
+xf_task_future_t xf_task_future_when_all(const xf_task_future_t *futures, uint32_t count)
+{
+    return xf_task_future_combine(futures, count, xf_task_future_all_cb);
+}
+
+xf_task_future_t xf_task_future_when_any(const xf_task_future_t *futures, uint32_t count)
+{
+    return xf_task_future_combine(futures, count, xf_task_future_any_cb);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static xf_task_future_handle_t *xf_task_future_alloc(xf_task_manager_t manager, uint32_t combo_count)
+{
+    xf_task_future_handle_t *future = (xf_task_future_handle_t *)xf_malloc(sizeof(xf_task_future_handle_t) +
+                                      sizeof(xf_task_future_then_t) * combo_count);
+    if (future == NULL) {
+        XF_LOGE(TAG, "memory alloc failed!");
+        return NULL;
+    }
+
+    future->manager = manager;
+    future->task = NULL;
+    future->func = NULL;
+    future->value = NULL;
+    future->err = XF_OK;
+    future->done = false;
+    future->busy = false;
+    future->released = false;
+    xf_list_init(&future->wait_list);
+    xf_list_init(&future->then_list);
+    future->remain = combo_count;
+    future->combo_count = combo_count;
+    future->combo = (xf_task_future_then_t *)((uint8_t *)future + sizeof(xf_task_future_handle_t));
+    for (uint32_t i = 0; i < combo_count; i++) {
+        xf_list_init(&future->combo[i].node);
+    }
+
+    return future;
+}
+
+static void xf_task_future_try_free(xf_task_future_handle_t *future)
+{
+    // 用户已删除、任务已销毁且不在执行续体时才真正释放
+    if (!future->released || future->task != NULL || future->busy) {
+        return;
+    }
+
+    xf_task_future_then_t *then, *_then;
+    xf_list_for_each_entry_safe(then, _then, &future->then_list, xf_task_future_then_t, node) {
+        xf_list_del_init(&then->node);
+        if (!then->embedded) {
+            xf_free(then);
+        }
+    }
+
+    // 从还未完成的被组合 future 上摘下续体
+    for (uint32_t i = 0; i < future->combo_count; i++) {
+        xf_list_del_init(&future->combo[i].node);
+    }
+
+    xf_free(future);
+}
+
+static void xf_task_future_entry(xf_task_t task)
+{
+    xf_task_base_t *task_base = (xf_task_base_t *)task;
+    xf_task_future_handle_t *future = (xf_task_future_handle_t *)task_base->user_data;
+
+    future->func(task);
+
+    if (future->done) {
+        return;
+    }
+
+#if XF_TASK_CONTEXT_IS_ENABLE
+    // ctask 执行函数返回即完成
+    if (XF_TASK_TYPE_CTASK == xf_task_get_type(task)) {
+        xf_task_future_resolve(future, XF_OK, NULL);
+        return;
+    }
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+
+    // ntask 在被删除或者循环次数用完时完成
+    if (XF_TASK_STATE_DELETE == xf_task_get_state(task) || 0 == xf_ntask_get_count(task)) {
+        xf_task_future_resolve(future, XF_OK, NULL);
+    }
+}
+
+static void xf_task_future_task_delete(xf_task_t task)
+{
+    xf_task_base_t *task_base = (xf_task_base_t *)task;
+    xf_task_future_handle_t *future = (xf_task_future_handle_t *)task_base->user_data;
+
+    future->task = NULL;
+    xf_task_destructor(task);
+
+    if (!future->done) {
+        xf_task_future_resolve(future, XF_ERR_INVALID_STATE, NULL);
+    } else {
+        xf_task_future_try_free(future);
+    }
+}
+
+static void xf_task_future_trigger_cb(xf_task_future_t future, void *arg)
+{
+    UNUSED(future);
+    xf_task_trigger((xf_task_t)arg);
+}
+
+static void xf_task_future_all_cb(xf_task_future_t future, void *arg)
+{
+    xf_task_future_handle_t *combo = (xf_task_future_handle_t *)arg;
+    xf_task_future_handle_t *handle = (xf_task_future_handle_t *)future;
+
+    if (combo->done) {
+        return;
+    }
+
+    if (handle->err != XF_OK) {
+        xf_task_future_resolve(combo, handle->err, NULL);
+        return;
+    }
+
+    if (--combo->remain == 0) {
+        xf_task_future_resolve(combo, XF_OK, NULL);
+    }
+}
+
+static void xf_task_future_any_cb(xf_task_future_t future, void *arg)
+{
+    xf_task_future_handle_t *combo = (xf_task_future_handle_t *)arg;
+    xf_task_future_handle_t *handle = (xf_task_future_handle_t *)future;
+
+    if (combo->done) {
+        return;
+    }
+
+    xf_task_future_resolve(combo, handle->err, future);
+}
+
+static xf_task_future_t xf_task_future_combine(const xf_task_future_t *futures, uint32_t count,
+        xf_task_future_func_t func)
+{
+    XF_ASSERT(futures, NULL, TAG, "futures must not be NULL");
+    XF_ASSERT(count, NULL, TAG, "count must not be 0");
+
+    for (uint32_t i = 0; i < count; i++) {
+        XF_ASSERT(futures[i], NULL, TAG, "futures[%d] must not be NULL", (int)i);
+    }
+
+    xf_task_future_handle_t *first = (xf_task_future_handle_t *)futures[0];
+    xf_task_future_handle_t *combo = xf_task_future_alloc(first->manager, count);
+    if (combo == NULL) {
+        return NULL;
+    }
+
+    // 续体内嵌在组合 future 中，注册不会失败
+    for (uint32_t i = 0; i < count && !combo->done; i++) {
+        xf_task_future_handle_t *handle = (xf_task_future_handle_t *)futures[i];
+        if (handle->done) {
+            func(handle, combo);
+            continue;
+        }
+        combo->combo[i].func = func;
+        combo->combo[i].arg = combo;
+        combo->combo[i].embedded = true;
+        xf_list_add_tail(&combo->combo[i].node, &handle->then_list);
+    }
+
+    return combo;
+}
+
+#endif // XF_TASK_FUTURE_IS_ENABLE
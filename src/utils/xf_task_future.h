@@ -0,0 +1,231 @@
+/**
+ * @file xf_task_future.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 任务结果（future）。
+ * @version 0.1
+ * @date 2024-08-26
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_TASK_FUTURE_H__
+#define __XF_TASK_FUTURE_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_task_utils_config.h"
+
+#if XF_TASK_FUTURE_IS_ENABLE
+
+#include "../kernel/xf_task_kernel.h"
+
+/**
+ * @ingroup group_xf_task_user
+ * @defgroup group_xf_task_user_future future
+ * @brief 任务结果。任务完成时直接唤醒等待者并执行续体，不需要轮询任务状态。
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief future 句柄。
+ */
+typedef void *xf_task_future_t;
+
+/**
+ * @brief future 完成时执行的续体。
+ *
+ * @param future 完成的 future.
+ * @param arg 注册续体时传入的参数。
+ */
+typedef void (*xf_task_future_func_t)(xf_task_future_t future, void *arg);
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 创建一个 future，由用户调用 @ref xf_task_future_resolve 完成它。
+ *
+ * @param manager 任务管理器，阻塞等待的 ctask 需要属于该任务管理器。
+ * @return xf_task_future_t future 对象，返回 NULL 则表示创建失败
+ */
+xf_task_future_t xf_task_future_create_with_manager(xf_task_manager_t manager);
+
+/**
+ * @brief 创建任务，并返回表示该任务完成的 future.
+ *
+ * 以下情况视为任务完成：
+ *  - ctask 执行函数返回；
+ *  - ntask 循环次数用完，或者执行了 XF_NTASK_END / XF_NTASK_EXIT；
+ *  - 任务中调用了 @ref xf_task_future_resolve.
+ *
+ * 任务在完成前被删除时，future 以 XF_ERR_INVALID_STATE 完成。
+ *
+ * @note 该任务的 user_data 由 future 占用，不能再调用 xf_task_set_user_data.
+ *
+ * @param manager 任务管理器。
+ * @param type 任务类型。
+ * @param func 任务执行的函数。
+ * @param func_arg 用户自定义执行函数参数。
+ * @param priority 任务优先级。
+ * @param config 任务配置。
+ * @return xf_task_future_t future 对象，返回 NULL 则表示创建失败
+ */
+xf_task_future_t xf_task_spawn_future_with_manager(xf_task_manager_t manager, xf_task_type_t type,
+        xf_task_func_t func, void *func_arg, uint16_t priority, void *config);
+
+/**
+ * @brief 删除 future。
+ *
+ * 产生结果的任务还没有被销毁时，future 会在任务销毁后释放。
+ * 未执行的续体直接丢弃。
+ *
+ * @param future future 对象。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_BUSY 还有 ctask 阻塞等待该 future
+ *      - XF_OK 删除成功
+ */
+xf_err_t xf_task_future_delete(xf_task_future_t future);
+
+/**
+ * @brief 获取由 @ref xf_task_spawn_future_with_manager 创建的任务对应的 future.
+ *
+ * @param task 任务对象。
+ * @return xf_task_future_t future 对象，任务不是由 future 创建时返回 NULL
+ */
+xf_task_future_t xf_task_future_of(xf_task_t task);
+
+/**
+ * @brief 完成 future，唤醒所有等待者并执行续体。已经完成的 future 不会被改变。
+ *
+ * @param future future 对象。
+ * @param err 结果错误码。
+ * @param value 结果。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_INVALID_STATE future 已经完成
+ *      - XF_OK 成功
+ */
+xf_err_t xf_task_future_resolve(xf_task_future_t future, xf_err_t err, void *value);
+
+/**
+ * @brief future 是否已经完成。
+ *
+ * @param future future 对象。
+ * @return true 已经完成
+ * @return false 未完成
+ */
+bool xf_task_future_is_done(xf_task_future_t future);
+
+/**
+ * @brief 获取 future 的结果，不等待。
+ *
+ * @param future future 对象。
+ * @param[out] value 结果，可以为 NULL。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_BUSY future 未完成
+ *      - 其他 future 完成时的错误码
+ */
+xf_err_t xf_task_future_get(xf_task_future_t future, void **value);
+
+/**
+ * @brief ctask 阻塞等待 future 完成。
+ *
+ * @note ntask 请使用 @ref XF_NTASK_FUTURE_WAIT.
+ *
+ * @param future future 对象。
+ * @param timeout 超时时间，单位为毫秒。
+ * @param[out] value 结果，可以为 NULL。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_NOT_SUPPORTED future 未完成且不是在 ctask 中调用
+ *      - XF_ERR_TIMEOUT 等待超时
+ *      - 其他 future 完成时的错误码
+ */
+xf_err_t xf_task_future_wait(xf_task_future_t future, uint32_t timeout, void **value);
+
+/**
+ * @brief 注册续体，future 完成时执行。已经完成时立即执行。
+ *
+ * @param future future 对象。
+ * @param func 续体函数。
+ * @param arg 续体参数。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_NO_MEM 内存不足
+ *      - XF_OK 成功
+ */
+xf_err_t xf_task_future_then(xf_task_future_t future, xf_task_future_func_t func, void *arg);
+
+/**
+ * @brief future 完成时触发任务。用于事件触发的 ntask 等待 future.
+ *
+ * @param future future 对象。
+ * @param task 需要触发的任务，future 完成前不能被删除。
+ * @return xf_err_t 同 @ref xf_task_future_then.
+ */
+xf_err_t xf_task_future_watch(xf_task_future_t future, xf_task_t task);
+
+/**
+ * @brief 创建一个在所有 future 完成后完成的 future.
+ *
+ * 结果为 NULL，错误码为第一个失败的 future 的错误码，全部成功则为 XF_OK.
+ *
+ * @note 被组合的 future 在完成前不能被删除。
+ *
+ * @param futures future 数组，不能为空。
+ * @param count future 个数。
+ * @return xf_task_future_t future 对象，返回 NULL 则表示创建失败
+ */
+xf_task_future_t xf_task_future_when_all(const xf_task_future_t *futures, uint32_t count);
+
+/**
+ * @brief 创建一个在任意一个 future 完成后完成的 future.
+ *
+ * 结果为最先完成的 future，错误码与它相同。
+ *
+ * @note 被组合的 future 在完成前不能被删除。
+ *
+ * @param futures future 数组，不能为空。
+ * @param count future 个数。
+ * @return xf_task_future_t future 对象，返回 NULL 则表示创建失败
+ */
+xf_task_future_t xf_task_future_when_any(const xf_task_future_t *futures, uint32_t count);
+
+/* ==================== [Macros] ============================================ */
+
+/**
+ * @brief ntask 等待 future 完成，future 完成时 ntask 会被触发。
+ *
+ * @attention 只能在 XF_NTASK_BEGIN 与 XF_NTASK_END 之间使用。
+ *
+ * @param future future 对象。
+ */
+#define XF_NTASK_FUTURE_WAIT(future)                                \
+    do                                                              \
+    {                                                               \
+        xf_task_future_watch(future, __xf_now_task);                \
+        XF_NTASK_WAIT_UNTIL(xf_task_future_is_done(future));        \
+    } while (0)
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of group_xf_task_user_future
+ * @}
+ */
+
+#endif // XF_TASK_FUTURE_IS_ENABLE
+
+#endif // __XF_TASK_FUTURE_H__
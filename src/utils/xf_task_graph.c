@@ -0,0 +1,484 @@
+/**
+ * @file xf_task_graph.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 任务依赖图（DAG）。
+ * @version 0.1
+ * @date 2024-08-30
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_task_utils_config.h"
+
+#if XF_TASK_GRAPH_IS_ENABLE
+
+#include "xf_task_graph.h"
+#include "../kernel/xf_task_base.h"
+#include "../task/xf_ntask.h"
+#include "../task/xf_ctask.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "task_graph"
+
+#define NODE_IDLE_MS (60U * 1000U)  // ctask 节点空闲时的等待周期，被触发时会提前唤醒
+
+/* ==================== [Typedefs] ========================================== */
+
+struct _xf_task_graph_handle_t;
+
+typedef struct _xf_task_graph_node_t {
+    xf_task_t task;
+    xf_task_func_t func;            // 节点原本的执行函数
+    struct _xf_task_graph_handle_t *graph;
+    uint32_t cost;
+    uint32_t indegree;
+    uint32_t pending;               // 本次启动还未完成的前驱数
+    uint32_t succ_begin;            // 后继在 succ 中的起始位置
+    uint32_t succ_count;
+    uint32_t level;                 // 到终点的最长路径（包括自身）
+    bool run;                       // ctask 节点已被触发
+} xf_task_graph_node_t;
+
+typedef struct _xf_task_graph_edge_t {
+    uint32_t from;
+    uint32_t to;
+} xf_task_graph_edge_t;
+
+typedef struct _xf_task_graph_waiter_t {
+    xf_list_t node;
+    xf_task_t task;
+} xf_task_graph_waiter_t;
+
+typedef struct _xf_task_graph_handle_t {
+    xf_task_manager_t manager;
+    uint16_t priority;
+    bool dirty;                     // 节点或边有变化，启动前需要重新整理
+    bool acyclic;
+    bool running;
+    uint32_t max_nodes;
+    uint32_t max_edges;
+    uint32_t node_count;
+    uint32_t edge_count;
+    uint32_t remaining;             // 本次启动还未完成的节点数
+    uint32_t round;                 // 已完成的启动次数
+    xf_task_graph_node_t *nodes;
+    xf_task_graph_edge_t *edges;
+    uint32_t *succ;                 // 按前驱整理后的后继节点
+    uint32_t *order;                // 拓扑序
+    xf_task_graph_done_t done;
+    void *done_arg;
+    xf_list_t wait_list;
+} xf_task_graph_handle_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void xf_task_graph_build(xf_task_graph_handle_t *graph);
+static void xf_task_graph_node_ready(xf_task_graph_node_t *node);
+static void xf_task_graph_node_done(xf_task_graph_node_t *node);
+static void xf_task_graph_ntask_entry(xf_task_t task);
+#if XF_TASK_CONTEXT_IS_ENABLE
+static void xf_task_graph_ctask_entry(xf_task_t task);
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+
+/* ==================== [Static Variables] ================================== */
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_task_graph_t xf_task_graph_create_with_manager(xf_task_manager_t manager, uint32_t max_nodes, uint32_t max_edges,
+        uint16_t priority)
+{
+    XF_ASSERT(manager, NULL, TAG, "manager must not be NULL");
+    XF_ASSERT(max_nodes, NULL, TAG, "max_nodes must not be 0");
+    XF_ASSERT(priority < XF_TASK_PRIORITY_LEVELS, NULL, TAG, "priority must less than %d", XF_TASK_PRIORITY_LEVELS);
+
+    xf_task_graph_handle_t *graph = (xf_task_graph_handle_t *)xf_malloc(sizeof(xf_task_graph_handle_t) +
+                                    sizeof(xf_task_graph_node_t) * max_nodes +
+                                    sizeof(xf_task_graph_edge_t) * max_edges +
+                                    sizeof(uint32_t) * (max_edges + max_nodes));
+    if (graph == NULL) {
+        XF_LOGE(TAG, "memory alloc failed!");
+        return NULL;
+    }
+
+    graph->manager = manager;
+    graph->priority = priority;
+    graph->dirty = false;
+    graph->acyclic = true;
+    graph->running = false;
+    graph->max_nodes = max_nodes;
+    graph->max_edges = max_edges;
+    graph->node_count = 0;
+    graph->edge_count = 0;
+    graph->remaining = 0;
+    graph->round = 0;
+    graph->nodes = (xf_task_graph_node_t *)((uint8_t *)graph + sizeof(xf_task_graph_handle_t));
+    graph->edges = (xf_task_graph_edge_t *)&graph->nodes[max_nodes];
+    graph->succ = (uint32_t *)&graph->edges[max_edges];
+    graph->order = &graph->succ[max_edges];
+    graph->done = NULL;
+    graph->done_arg = NULL;
+    xf_list_init(&graph->wait_list);
+
+    return graph;
+}
+
+xf_err_t xf_task_graph_delete(xf_task_graph_t graph)
+{
+    XF_ASSERT(graph, XF_ERR_INVALID_ARG, TAG, "graph must not be NULL");
+    xf_task_graph_handle_t *handle = (xf_task_graph_handle_t *)graph;
+
+    if (handle->running) {
+        XF_LOGE(TAG, "graph is running");
+        return XF_ERR_BUSY;
+    }
+
+    for (uint32_t i = 0; i < handle->node_count; i++) {
+        xf_task_delete(handle->nodes[i].task);
+    }
+
+    xf_free(graph);
+
+    return XF_OK;
+}
+
+xf_err_t xf_task_graph_add_node(xf_task_graph_t graph, xf_task_type_t type, xf_task_func_t func, void *func_arg,
+                                void *config, uint32_t *node)
+{
+    XF_ASSERT(graph, XF_ERR_INVALID_ARG, TAG, "graph must not be NULL");
+    XF_ASSERT(func, XF_ERR_INVALID_ARG, TAG, "func must not be NULL");
+    XF_ASSERT(config, XF_ERR_INVALID_ARG, TAG, "config must not be NULL");
+    xf_task_graph_handle_t *handle = (xf_task_graph_handle_t *)graph;
+
+    if (handle->running) {
+        return XF_ERR_BUSY;
+    }
+
+    if (handle->node_count >= handle->max_nodes) {
+        XF_LOGE(TAG, "graph nodes is full");
+        return XF_ERR_NO_MEM;
+    }
+
+    xf_task_graph_node_t *graph_node = &handle->nodes[handle->node_count];
+    xf_task_t task = NULL;
+
+#if XF_TASK_CONTEXT_IS_ENABLE
+    if (type == XF_TASK_TYPE_CTASK) {
+        task = xf_task_create_with_manager(handle->manager, type, xf_task_graph_ctask_entry, func_arg,
+                                           handle->priority, config);
+    } else
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+    {
+        // 周期为 0 的 ntask 只在被触发时执行
+        xf_ntask_config_t ntask_config = {.count = XF_NTASK_INFINITE_LOOP, .delay_ms = 0};
+        task = xf_task_create_with_manager(handle->manager, type, xf_task_graph_ntask_entry, func_arg,
+                                           handle->priority, &ntask_config);
+    }
+
+    if (task == NULL) {
+        return XF_ERR_NO_MEM;
+    }
+
+    xf_task_base_t *task_base = (xf_task_base_t *)task;
+    task_base->user_data = graph_node;
+
+    graph_node->task = task;
+    graph_node->func = func;
+    graph_node->graph = handle;
+    graph_node->cost = 1;
+    graph_node->run = false;
+
+    if (node != NULL) {
+        *node = handle->node_count;
+    }
+    handle->node_count++;
+    handle->dirty = true;
+
+    return XF_OK;
+}
+
+xf_err_t xf_task_graph_add_edge(xf_task_graph_t graph, uint32_t from, uint32_t to)
+{
+    XF_ASSERT(graph, XF_ERR_INVALID_ARG, TAG, "graph must not be NULL");
+    xf_task_graph_handle_t *handle = (xf_task_graph_handle_t *)graph;
+    XF_ASSERT(from < handle->node_count && to < handle->node_count, XF_ERR_INVALID_ARG, TAG, "node is not exist");
+    XF_ASSERT(from != to, XF_ERR_INVALID_ARG, TAG, "node can not depend on itself");
+
+    if (handle->running) {
+        return XF_ERR_BUSY;
+    }
+
+    if (handle->edge_count >= handle->max_edges) {
+        XF_LOGE(TAG, "graph edges is full");
+        return XF_ERR_NO_MEM;
+    }
+
+    handle->edges[handle->edge_count].from = from;
+    handle->edges[handle->edge_count].to = to;
+    handle->edge_count++;
+    handle->dirty = true;
+
+    return XF_OK;
+}
+
+xf_err_t xf_task_graph_set_cost(xf_task_graph_t graph, uint32_t node, uint32_t cost)
+{
+    XF_ASSERT(graph, XF_ERR_INVALID_ARG, TAG, "graph must not be NULL");
+    xf_task_graph_handle_t *handle = (xf_task_graph_handle_t *)graph;
+    XF_ASSERT(node < handle->node_count, XF_ERR_INVALID_ARG, TAG, "node is not exist");
+
+    handle->nodes[node].cost = cost;
+    handle->dirty = true;
+
+    return XF_OK;
+}
+
+xf_err_t xf_task_graph_set_done_cb(xf_task_graph_t graph, xf_task_graph_done_t done, void *arg)
+{
+    XF_ASSERT(graph, XF_ERR_INVALID_ARG, TAG, "graph must not be NULL");
+    xf_task_graph_handle_t *handle = (xf_task_graph_handle_t *)graph;
+
+    handle->done = done;
+    handle->done_arg = arg;
+
+    return XF_OK;
+}
+
+xf_err_t xf_task_graph_launch(xf_task_graph_t graph)
+{
+    XF_ASSERT(graph, XF_ERR_INVALID_ARG, TAG, "graph must not be NULL");
+    xf_task_graph_handle_t *handle = (xf_task_graph_handle_t *)graph;
+
+    if (handle->running) {
+        return XF_ERR_BUSY;
+    }
+
+    if (handle->dirty) {
+        xf_task_graph_build(handle);
+    }
+
+    if (!handle->acyclic) {
+        XF_LOGE(TAG, "graph has cycle");
+        return XF_ERR_INVALID_STATE;
+    }
+
+    if (handle->node_count == 0) {
+        return XF_OK;
+    }
+
+    handle->running = true;
+    handle->remaining = handle->node_count;
+    for (uint32_t i = 0; i < handle->node_count; i++) {
+        handle->nodes[i].pending = handle->nodes[i].indegree;
+    }
+
+    for (uint32_t i = 0; i < handle->node_count; i++) {
+        if (handle->nodes[i].indegree == 0) {
+            xf_task_graph_node_ready(&handle->nodes[i]);
+        }
+    }
+
+    return XF_OK;
+}
+
+bool xf_task_graph_is_running(xf_task_graph_t graph)
+{
+    XF_ASSERT(graph, false, TAG, "graph must not be NULL");
+    xf_task_graph_handle_t *handle = (xf_task_graph_handle_t *)graph;
+
+    return handle->running;
+}
+
+xf_err_t xf_task_graph_wait(xf_task_graph_t graph, uint32_t timeout)
+{
+    XF_ASSERT(graph, XF_ERR_INVALID_ARG, TAG, "graph must not be NULL");
+    xf_task_graph_handle_t *handle = (xf_task_graph_handle_t *)graph;
+
+    if (!handle->running) {
+        return XF_OK;
+    }
+
+#if XF_TASK_CONTEXT_IS_ENABLE
+    xf_task_t current = xf_task_manager_get_current_task(handle->manager);
+    xf_task_graph_waiter_t waiter;
+
+    // 只有ctask才能阻塞等待
+    if (current == NULL || XF_TASK_TYPE_CTASK != xf_task_get_type(current)) {
+        XF_LOGE(TAG, "task must ctask");
+        return XF_ERR_NOT_SUPPORTED;
+    }
+
+    waiter.task = current;
+    xf_list_init(&waiter.node);
+
+    // 完成回调中可能再次启动，以完成次数判断本次启动是否已经完成
+    uint32_t round = handle->round;
+    while (round == handle->round) {
+        xf_list_add_tail(&waiter.node, &handle->wait_list);
+        // 这里有可能会被执行完成时唤醒，从而延时未达到timeout
+        xf_ctask_delay_with_manager(handle->manager, timeout);
+        xf_list_del_init(&waiter.node);
+
+        if (round == handle->round && xf_task_get_timeout(current) >= 0) {
+            XF_LOGD(TAG, "graph timeout");
+            return XF_ERR_TIMEOUT;
+        }
+        // 没达到超时进入循环继续进行接下来的超时
+        timeout = -xf_task_get_timeout(current);
+    }
+
+    return XF_OK;
+#else
+    UNUSED(timeout);
+    XF_LOGE(TAG, "ctask is disabled");
+    return XF_ERR_NOT_SUPPORTED;
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void xf_task_graph_build(xf_task_graph_handle_t *graph)
+{
+    xf_task_graph_node_t *nodes = graph->nodes;
+    uint32_t count = graph->node_count;
+
+    // 按前驱整理后继（计数排序）
+    for (uint32_t i = 0; i < count; i++) {
+        nodes[i].indegree = 0;
+        nodes[i].succ_count = 0;
+    }
+    for (uint32_t i = 0; i < graph->edge_count; i++) {
+        nodes[graph->edges[i].from].succ_count++;
+        nodes[graph->edges[i].to].indegree++;
+    }
+    for (uint32_t i = 0, begin = 0; i < count; i++) {
+        nodes[i].succ_begin = begin;
+        nodes[i].pending = 0;       // 临时作为填充位置
+        begin += nodes[i].succ_count;
+    }
+    for (uint32_t i = 0; i < graph->edge_count; i++) {
+        xf_task_graph_node_t *from = &nodes[graph->edges[i].from];
+        graph->succ[from->succ_begin + from->pending++] = graph->edges[i].to;
+    }
+
+    // 拓扑排序，排不完说明有环
+    uint32_t head = 0, tail = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        nodes[i].pending = nodes[i].indegree;
+        if (nodes[i].pending == 0) {
+            graph->order[tail++] = i;
+        }
+    }
+    while (head < tail) {
+        xf_task_graph_node_t *node = &nodes[graph->order[head++]];
+        for (uint32_t i = 0; i < node->succ_count; i++) {
+            uint32_t succ = graph->succ[node->succ_begin + i];
+            if (--nodes[succ].pending == 0) {
+                graph->order[tail++] = succ;
+            }
+        }
+    }
+
+    graph->dirty = false;
+    graph->acyclic = (tail == count);
+    if (!graph->acyclic) {
+        return;
+    }
+
+    // 逆拓扑序计算到终点的最长路径
+    uint32_t max_level = 0;
+    for (uint32_t i = count; i-- > 0;) {
+        xf_task_graph_node_t *node = &nodes[graph->order[i]];
+        uint32_t level = 0;
+        for (uint32_t j = 0; j < node->succ_count; j++) {
+            uint32_t succ_level = nodes[graph->succ[node->succ_begin + j]].level;
+            level = (succ_level > level) ? succ_level : level;
+        }
+        node->level = level + node->cost;
+        max_level = (node->level > max_level) ? node->level : max_level;
+    }
+
+    // 最长路径越长优先级越高，其余节点按比例分配到剩余的优先级
+    uint32_t span = XF_TASK_PRIORITY_LEVELS - 1 - graph->priority;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t priority = graph->priority;
+        if (max_level != 0) {
+            priority += (uint32_t)((uint64_t)(max_level - nodes[i].level) * span / max_level);
+        }
+        xf_task_set_priority(nodes[i].task, (uint16_t)priority);
+    }
+}
+
+static void xf_task_graph_node_ready(xf_task_graph_node_t *node)
+{
+    node->run = true;
+    xf_task_trigger(node->task);
+}
+
+static void xf_task_graph_node_done(xf_task_graph_node_t *node)
+{
+    xf_task_graph_handle_t *graph = node->graph;
+
+    for (uint32_t i = 0; i < node->succ_count; i++) {
+        xf_task_graph_node_t *succ = &graph->nodes[graph->succ[node->succ_begin + i]];
+        if (--succ->pending == 0) {
+            xf_task_graph_node_ready(succ);
+        }
+    }
+
+    if (--graph->remaining != 0) {
+        return;
+    }
+
+    graph->running = false;
+    graph->round++;
+
+    xf_task_graph_waiter_t *waiter, *_waiter;
+    xf_list_for_each_entry_safe(waiter, _waiter, &graph->wait_list, xf_task_graph_waiter_t, node) {
+        xf_list_del_init(&waiter->node);
+        xf_task_trigger(waiter->task);
+    }
+
+    // 回调中可以再次启动
+    if (graph->done != NULL) {
+        graph->done(graph, graph->done_arg);
+    }
+}
+
+static void xf_task_graph_ntask_entry(xf_task_t task)
+{
+    xf_task_base_t *task_base = (xf_task_base_t *)task;
+    xf_task_graph_node_t *node = (xf_task_graph_node_t *)task_base->user_data;
+
+    if (!node->run) {
+        return;
+    }
+
+    node->run = false;
+    node->func(task);
+    xf_task_graph_node_done(node);
+}
+
+#if XF_TASK_CONTEXT_IS_ENABLE
+static void xf_task_graph_ctask_entry(xf_task_t task)
+{
+    xf_task_base_t *task_base = (xf_task_base_t *)task;
+    xf_task_graph_node_t *node = (xf_task_graph_node_t *)task_base->user_data;
+
+    while (1) {
+        while (!node->run) {
+            xf_ctask_delay_with_manager(task_base->manager, NODE_IDLE_MS);
+        }
+        node->run = false;
+        node->func(task);
+        xf_task_graph_node_done(node);
+    }
+}
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+
+#endif // XF_TASK_GRAPH_IS_ENABLE
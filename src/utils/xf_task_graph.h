@@ -0,0 +1,188 @@
+/**
+ * @file xf_task_graph.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 任务依赖图（DAG）。
+ * @version 0.1
+ * @date 2024-08-30
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_TASK_GRAPH_H__
+#define __XF_TASK_GRAPH_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_task_utils_config.h"
+
+#if XF_TASK_GRAPH_IS_ENABLE
+
+#include "../kernel/xf_task_kernel.h"
+
+/**
+ * @ingroup group_xf_task_user
+ * @defgroup group_xf_task_user_graph graph
+ * @brief 任务依赖图。
+ *
+ * 每个节点是一个常驻任务，节点的所有前驱执行完后通过 xf_task_trigger 触发它执行一次。
+ * 节点的优先级按关键路径（到终点的最长路径）分配，关键路径上的节点优先执行。
+ * 图的内存在创建时一次分配，可以反复启动。
+ *
+ * @note ntask 节点每次启动只调用一次执行函数，不能使用 XF_NTASK_BEGIN 等宏；
+ *       需要阻塞等待的节点请使用 ctask.
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 任务依赖图句柄。
+ */
+typedef void *xf_task_graph_t;
+
+/**
+ * @brief 任务依赖图执行完成回调。
+ *
+ * @param graph 任务依赖图。
+ * @param arg 用户参数。
+ */
+typedef void (*xf_task_graph_done_t)(xf_task_graph_t graph, void *arg);
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 创建任务依赖图。
+ *
+ * @param manager 任务管理器。
+ * @param max_nodes 最大节点数。
+ * @param max_edges 最大边数。
+ * @param priority 关键路径上节点的优先级，其余节点按松弛程度分配到 priority ~ XF_TASK_PRIORITY_LEVELS - 1.
+ * @return xf_task_graph_t 任务依赖图，返回 NULL 则表示创建失败
+ */
+xf_task_graph_t xf_task_graph_create_with_manager(xf_task_manager_t manager, uint32_t max_nodes, uint32_t max_edges,
+        uint16_t priority);
+
+/**
+ * @brief 删除任务依赖图及其所有节点任务。
+ *
+ * @param graph 任务依赖图。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_BUSY 任务依赖图正在执行
+ *      - XF_OK 删除成功
+ */
+xf_err_t xf_task_graph_delete(xf_task_graph_t graph);
+
+/**
+ * @brief 添加节点。
+ *
+ * @note 节点任务的 user_data 由任务依赖图占用。
+ *
+ * @param graph 任务依赖图。
+ * @param type 任务类型。
+ * @param func 节点执行的函数。
+ * @param func_arg 用户自定义执行函数参数。
+ * @param config 任务配置，ntask 的周期与循环次数不生效。
+ * @param[out] node 节点序号。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_BUSY 任务依赖图正在执行
+ *      - XF_ERR_NO_MEM 节点数已满或者创建任务失败
+ *      - XF_OK 成功
+ */
+xf_err_t xf_task_graph_add_node(xf_task_graph_t graph, xf_task_type_t type, xf_task_func_t func, void *func_arg,
+                                void *config, uint32_t *node);
+
+/**
+ * @brief 添加一条依赖边，from 执行完后才能执行 to.
+ *
+ * @param graph 任务依赖图。
+ * @param from 前驱节点。
+ * @param to 后继节点。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_BUSY 任务依赖图正在执行
+ *      - XF_ERR_NO_MEM 边数已满
+ *      - XF_OK 成功
+ */
+xf_err_t xf_task_graph_add_edge(xf_task_graph_t graph, uint32_t from, uint32_t to);
+
+/**
+ * @brief 设置节点的相对耗时，用于计算关键路径。默认为 1.
+ *
+ * @param graph 任务依赖图。
+ * @param node 节点序号。
+ * @param cost 相对耗时。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_OK 成功
+ */
+xf_err_t xf_task_graph_set_cost(xf_task_graph_t graph, uint32_t node, uint32_t cost);
+
+/**
+ * @brief 设置执行完成回调。
+ *
+ * @param graph 任务依赖图。
+ * @param done 完成回调，可以为 NULL.
+ * @param arg 用户参数。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_OK 成功
+ */
+xf_err_t xf_task_graph_set_done_cb(xf_task_graph_t graph, xf_task_graph_done_t done, void *arg);
+
+/**
+ * @brief 启动一次任务依赖图，触发所有没有前驱的节点。
+ *
+ * @param graph 任务依赖图。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_BUSY 上一次启动还没有执行完
+ *      - XF_ERR_INVALID_STATE 图中存在环
+ *      - XF_OK 成功
+ */
+xf_err_t xf_task_graph_launch(xf_task_graph_t graph);
+
+/**
+ * @brief 任务依赖图是否正在执行。
+ *
+ * @param graph 任务依赖图。
+ * @return true 正在执行
+ * @return false 没有执行
+ */
+bool xf_task_graph_is_running(xf_task_graph_t graph);
+
+/**
+ * @brief ctask 阻塞等待任务依赖图执行完成。
+ *
+ * @param graph 任务依赖图。
+ * @param timeout 超时时间，单位为毫秒。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_NOT_SUPPORTED 正在执行且不是在 ctask 中调用
+ *      - XF_ERR_TIMEOUT 等待超时
+ *      - XF_OK 执行完成
+ */
+xf_err_t xf_task_graph_wait(xf_task_graph_t graph, uint32_t timeout);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of group_xf_task_user_graph
+ * @}
+ */
+
+#endif // XF_TASK_GRAPH_IS_ENABLE
+
+#endif // __XF_TASK_GRAPH_H__
@@ -12,176 +12,393 @@
 /* ==================== [Includes] ========================================== */
 
 #include "xf_task_mbus.h"
+#include "xf_task_mbus_internal.h"
 #include "xf_task_queue.h"
+#include "../kernel/xf_task_atomic.h"
+#include "../kernel/xf_task_probe.h"
+#include "../task/xf_task_default.h"
+#include "../task/xf_ctask.h"
+#include "../port/xf_task_port_internal.h"
 
 /* ==================== [Defines] =========================================== */
 
 #if XF_TASK_MBUS_IS_ENABLE
 
-/* ==================== [Typedefs] ========================================== */
+#define DEFAULT_QUEUE_COUNT XF_TASK_MBUS_QUEUE_COUNT
+#define SUB_BLOCK_MIN (4)       // 最小订阅数组容量
+#define SUB_SLAB_CLASS_NUM XF_TASK_MBUS_SLAB_CLASS_NUM
+#define SUB_CLASS_MAX (13)      // 最大容量等级
+
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+#define HIST_SUB_BITS XF_TASK_MBUS_HIST_SUB_BITS
+#define HIST_SUB_COUNT (1 << HIST_SUB_BITS)
+#define HIST_BUCKET_NUM XF_TASK_MBUS_HIST_BUCKET_NUM
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
 
-typedef struct _xf_task_xtopic_t {
-    xf_list_t node;
-    xf_list_t sub_list;         // 订阅链表
-    xf_task_queue_t pub_queue;  // 发布链表，有缓存有限用缓存，没缓存则创建
-    uint32_t id;                // topic id
-    uint32_t size;              // topic发布消息大小
-} xf_task_mtopic_t;
+/* ==================== [Typedefs] ========================================== */
 
-typedef struct _xf_task_xsub_t {
-    xf_list_t node;
-    xf_task_mbus_func_t mbus_cb; // 订阅回调
-    void *user_data;             // 用户订阅回调参数
-} xf_task_msub_t;
+/**
+ * 桥接。src 总线线程是唯一生产者，dst 总线线程是唯一消费者。
+ * head 只由消费者写，tail 只由生产者写，二者都是自由增长的计数。
+ */
+typedef struct _xf_task_mbridge_t {
+    xf_list_t src_node;             // 挂载在源 topic 的 bridge_list 上
+    xf_list_t dst_node;             // 挂载在目的总线的 bridge_list 上
+    xf_task_mbus_handle_t *src;     // 源总线
+    xf_task_mbus_handle_t *dst;     // 目的总线
+    xf_task_mtopic_t *src_topic;    // 源 topic
+    xf_task_mtopic_t *dst_topic;    // 目的 topic
+    volatile uint32_t head;         // 消费位置
+    volatile uint32_t tail;         // 生产位置
+    uint32_t mask;                  // 队列深度 - 1
+    volatile uint32_t dropped;      // 队列满而丢弃的消息数，生产者写、其他上下文读
+    uint8_t *buf;                   // 消息缓存
+} xf_task_mbridge_t;
 
 /* ==================== [Static Prototypes] ================================= */
 
-static void xf_task_mbus_run(xf_task_mtopic_t *mtopic, void *data);
-static xf_err_t xf_task_mbus_find(uint32_t topic_id, xf_task_mtopic_t **topic);
+static void xf_task_mbus_run(xf_task_mbus_handle_t *bus, xf_task_mtopic_t *mtopic, void *data, bool forward);
+static xf_err_t xf_task_mbus_find(xf_task_mbus_handle_t *bus, uint32_t topic_id, xf_task_mtopic_t **topic);
+static void xf_task_mbus_init(xf_task_mbus_handle_t *bus, xf_task_manager_t manager, bool is_static);
+static xf_err_t xf_task_mbus_topic_add(xf_task_mbus_handle_t *bus, xf_task_mtopic_t *mtopic, uint32_t topic_id,
+                                       uint32_t size, bool is_static);
+static void xf_task_mbus_topic_free(xf_task_mbus_handle_t *bus, xf_task_mtopic_t *mtopic);
+static xf_task_msub_block_t *xf_task_mbus_block_alloc(xf_task_mbus_handle_t *bus, uint8_t cls);
+static void xf_task_mbus_block_free(xf_task_mbus_handle_t *bus, xf_task_msub_block_t *block);
+static xf_task_msub_block_t *xf_task_mbus_subs_writable(xf_task_mbus_handle_t *bus, xf_task_mtopic_t *mtopic,
+        uint32_t count, uint32_t skip);
+static void xf_task_mbus_subs_commit(xf_task_mbus_handle_t *bus, xf_task_mtopic_t *mtopic,
+                                     xf_task_msub_block_t *block);
+static xf_err_t xf_task_mbus_subs_insert(xf_task_mbus_handle_t *bus, xf_task_mtopic_t *mtopic, uint16_t index,
+        const xf_task_msub_t *msub);
+static void xf_task_mbus_subs_remove(xf_task_mbus_handle_t *bus, xf_task_mtopic_t *mtopic, uint16_t index);
+static xf_task_mbridge_t *xf_task_mbus_bridge_find(xf_task_mbus_handle_t *src, xf_task_mbus_handle_t *dst,
+        uint32_t topic_id);
+static void xf_task_mbus_bridge_push(xf_task_mbridge_t *bridge, const void *data);
+static void xf_task_mbus_bridge_drain(xf_task_mbridge_t *bridge);
+#if XF_TASK_MBUS_PATTERN_IS_ENABLE
+static xf_err_t xf_task_mbus_sub_pattern(xf_task_mbus_handle_t *bus, uint32_t first, uint32_t last, uint32_t mask,
+        uint32_t value, xf_task_mbus_func_t mbus_cb, void *user_data);
+static xf_err_t xf_task_mbus_unsub_pattern(xf_task_mbus_handle_t *bus, uint32_t first, uint32_t last, uint32_t mask,
+        uint32_t value, xf_task_mbus_func_t mbus_cb);
+static bool xf_task_mbus_pattern_match(const xf_task_mpattern_t *mpattern, uint32_t topic_id);
+static xf_err_t xf_task_mbus_match_add(xf_task_mbus_handle_t *bus, xf_task_mtopic_t *mtopic,
+                                       xf_task_mpattern_t *mpattern);
+static void xf_task_mbus_match_remove(xf_task_mbus_handle_t *bus, xf_task_mtopic_t *mtopic,
+                                      xf_task_mpattern_t *mpattern);
+#endif // XF_TASK_MBUS_PATTERN_IS_ENABLE
+#if XF_TASK_MBUS_RPC_IS_ENABLE
+static xf_task_mbus_call_t *xf_task_mbus_call_find(xf_task_mbus_handle_t *bus, uint32_t corr_id);
+static void xf_task_mbus_call_finish(xf_task_mbus_call_t *call, xf_err_t err);
+#endif // XF_TASK_MBUS_RPC_IS_ENABLE
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+static void xf_task_mbus_hist_record(xf_task_mhist_t *hist, xf_task_time_t value);
+static void xf_task_mbus_hist_stat(const xf_task_mhist_t *hist, xf_task_mbus_stat_t *stat);
+static void xf_task_mbus_hist_free(xf_task_mtopic_t *mtopic);
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
 
 /* ==================== [Static Variables] ================================== */
 
-static xf_list_t _topic_list = XF_LIST_HEAD_INIT(_topic_list);
+static xf_task_mbus_handle_t _default_bus = {
+    .topic_list = XF_LIST_HEAD_INIT(_default_bus.topic_list),
+#if XF_TASK_MBUS_PATTERN_IS_ENABLE
+    .pattern_list = XF_LIST_HEAD_INIT(_default_bus.pattern_list),
+#endif // XF_TASK_MBUS_PATTERN_IS_ENABLE
+    .bridge_list = XF_LIST_HEAD_INIT(_default_bus.bridge_list),
+    .current_topic = NULL,
+    .manager = NULL,
+    .is_static = true,
+    .slab = {NULL},
+#if XF_TASK_MBUS_RPC_IS_ENABLE
+    .call_list = XF_LIST_HEAD_INIT(_default_bus.call_list),
+    .corr_seq = 0,
+#endif // XF_TASK_MBUS_RPC_IS_ENABLE
+#if XF_TASK_MBUS_TRACE_IS_ENABLE && XF_TASK_MBUS_TRACE_DUMP_PERIOD
+    .last_dump = 0,
+#endif
+};
 
 /* ==================== [Macros] ============================================ */
 
 #define TAG "mbus"
-#define DEFAULT_QUEUE_COUNT (2)
 
 /* ==================== [Global Functions] ================================== */
 
+xf_task_mbus_t xf_task_mbus_create_with_manager(xf_task_manager_t manager)
+{
+    XF_ASSERT(manager, NULL, TAG, "manager must not be NULL");
 
-xf_err_t xf_task_mbus_reg_topic(uint32_t topic_id, uint32_t size)
+    xf_task_mbus_handle_t *bus = (xf_task_mbus_handle_t *)xf_malloc(sizeof(xf_task_mbus_handle_t));
+    if (bus == NULL) {
+        XF_LOGE(TAG, "memory alloc failed!");
+        return NULL;
+    }
+
+    xf_task_mbus_init(bus, manager, false);
+
+    return (xf_task_mbus_t)bus;
+}
+
+xf_task_mbus_t xf_task_mbus_create_static_with_manager(xf_task_manager_t manager, void *storage)
 {
-    XF_ASSERT(xf_task_mbus_find(topic_id, NULL), XF_ERR_INITED, TAG, "topic:%d is exists", (int)topic_id);
+    XF_ASSERT(manager, NULL, TAG, "manager must not be NULL");
+    XF_ASSERT(storage, NULL, TAG, "storage must not be NULL");
 
-    // 找到指定的manager后，注册mtopic
-    xf_task_mtopic_t *mtopic = (xf_task_mtopic_t *)xf_malloc(sizeof(xf_task_mtopic_t) + DEFAULT_QUEUE_COUNT * size);
-    void *buf = (void *)((uint8_t *)mtopic + sizeof(xf_task_mtopic_t));
+    xf_task_mbus_handle_t *bus = (xf_task_mbus_handle_t *)storage;
+
+    xf_task_mbus_init(bus, manager, true);
+
+    return (xf_task_mbus_t)bus;
+}
+
+xf_err_t xf_task_mbus_delete(xf_task_mbus_t bus)
+{
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
+    XF_ASSERT(bus != &_default_bus, XF_ERR_INVALID_ARG, TAG, "default bus can not be deleted");
+
+    xf_task_mbus_handle_t *bus_handle = (xf_task_mbus_handle_t *)bus;
+    xf_task_mtopic_t *mtopic, *_mtopic;
+
+    if (!xf_list_empty(&bus_handle->bridge_list)) {
+        XF_LOGE(TAG, "bus is bridged");
+        return XF_ERR_BUSY;
+    }
+#if XF_TASK_MBUS_RPC_IS_ENABLE
+    if (!xf_list_empty(&bus_handle->call_list)) {
+        XF_LOGE(TAG, "bus has pending calls");
+        return XF_ERR_BUSY;
+    }
+#endif // XF_TASK_MBUS_RPC_IS_ENABLE
+    xf_list_for_each_entry(mtopic, &bus_handle->topic_list, xf_task_mtopic_t, node) {
+        if (!xf_list_empty(&mtopic->bridge_list)) {
+            XF_LOGE(TAG, "topic:%d is bridged", (int)mtopic->id);
+            return XF_ERR_BUSY;
+        }
+    }
+
+    xf_list_for_each_entry_safe(mtopic, _mtopic, &bus_handle->topic_list, xf_task_mtopic_t, node) {
+        xf_list_del_init(&mtopic->node);
+        xf_task_mbus_topic_free(bus_handle, mtopic);
+    }
+
+#if XF_TASK_MBUS_PATTERN_IS_ENABLE
+    xf_task_mpattern_t *mpattern, *_mpattern;
+    xf_list_for_each_entry_safe(mpattern, _mpattern, &bus_handle->pattern_list, xf_task_mpattern_t, node) {
+        xf_list_del_init(&mpattern->node);
+        xf_free(mpattern);
+    }
+#endif // XF_TASK_MBUS_PATTERN_IS_ENABLE
+
+    for (uint8_t i = 0; i < SUB_SLAB_CLASS_NUM; i++) {
+        while (bus_handle->slab[i] != NULL) {
+            xf_task_msub_block_t *block = bus_handle->slab[i];
+            bus_handle->slab[i] = block->next;
+            xf_free(block);
+        }
+    }
+
+    if (!bus_handle->is_static) {
+        xf_free(bus_handle);
+    }
+
+    return XF_OK;
+}
+
+xf_task_mbus_t xf_task_mbus_get_default(void)
+{
+    return (xf_task_mbus_t)&_default_bus;
+}
+
+xf_task_manager_t xf_task_mbus_get_manager(xf_task_mbus_t bus)
+{
+    XF_ASSERT(bus, NULL, TAG, "bus must not be NULL");
+
+    xf_task_mbus_handle_t *bus_handle = (xf_task_mbus_handle_t *)bus;
+
+    if (bus_handle->manager == NULL) {
+        return xf_task_get_default_manager();
+    }
+
+    return bus_handle->manager;
+}
+
+xf_err_t xf_task_mbus_reg_topic_with_bus(xf_task_mbus_t bus, uint32_t topic_id, uint32_t size)
+{
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
+    XF_ASSERT(size, XF_ERR_INVALID_ARG, TAG, "size must not be 0");
+
+    xf_task_mbus_handle_t *bus_handle = (xf_task_mbus_handle_t *)bus;
+
+    XF_ASSERT(xf_task_mbus_find(bus_handle, topic_id, NULL), XF_ERR_INITED, TAG, "topic:%d is exists", (int)topic_id);
+
+    xf_task_mtopic_t *mtopic = (xf_task_mtopic_t *)xf_malloc(XF_TASK_MTOPIC_STORAGE_SIZE(size));
 
     if (mtopic == NULL) {
         XF_LOGE(TAG, "memory alloc failed!");
         return XF_ERR_NO_MEM;
     }
 
-    xf_list_init(&mtopic->node);
-    xf_list_init(&mtopic->sub_list);
-    xf_task_queue_init(&mtopic->pub_queue, buf, size, DEFAULT_QUEUE_COUNT);
-    mtopic->id = topic_id;
-    mtopic->size = size;
-    xf_list_add_tail(&mtopic->node, &_topic_list);
-
-    return XF_OK;
+    return xf_task_mbus_topic_add(bus_handle, mtopic, topic_id, size, false);
 }
 
+xf_err_t xf_task_mbus_reg_topic_static_with_bus(xf_task_mbus_t bus, uint32_t topic_id, uint32_t size, void *storage)
+{
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
+    XF_ASSERT(size, XF_ERR_INVALID_ARG, TAG, "size must not be 0");
+    XF_ASSERT(storage, XF_ERR_INVALID_ARG, TAG, "storage must not be NULL");
 
-xf_err_t xf_task_mbus_unreg_topic(uint32_t topic_id)
+    xf_task_mbus_handle_t *bus_handle = (xf_task_mbus_handle_t *)bus;
+
+    XF_ASSERT(xf_task_mbus_find(bus_handle, topic_id, NULL), XF_ERR_INITED, TAG, "topic:%d is exists", (int)topic_id);
+
+    return xf_task_mbus_topic_add(bus_handle, (xf_task_mtopic_t *)storage, topic_id, size, true);
+}
+
+xf_err_t xf_task_mbus_unreg_topic_with_bus(xf_task_mbus_t bus, uint32_t topic_id)
 {
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
+
+    xf_task_mbus_handle_t *bus_handle = (xf_task_mbus_handle_t *)bus;
     xf_task_mtopic_t *mtopic = NULL;
-    xf_task_msub_t *msub, *_msub;
+    xf_task_mbridge_t *bridge;
 
-    if (xf_task_mbus_find(topic_id, &mtopic) == XF_ERR_NOT_FOUND) {
+    if (xf_task_mbus_find(bus_handle, topic_id, &mtopic) == XF_ERR_NOT_FOUND) {
         XF_LOGE(TAG, "topic:%d not found", (int)topic_id);
         return XF_ERR_NOT_FOUND;
     }
 
-    xf_list_for_each_entry_safe(msub, _msub, &mtopic->sub_list, xf_task_msub_t, node) {
-        xf_list_del_init(&msub->node);
-        xf_free(msub);
+    // 桥接的两端都引用了 topic，需要先解除桥接
+    if (!xf_list_empty(&mtopic->bridge_list)) {
+        XF_LOGE(TAG, "topic:%d is bridged", (int)topic_id);
+        return XF_ERR_BUSY;
+    }
+    xf_list_for_each_entry(bridge, &bus_handle->bridge_list, xf_task_mbridge_t, dst_node) {
+        if (bridge->dst_topic == mtopic) {
+            XF_LOGE(TAG, "topic:%d is bridged", (int)topic_id);
+            return XF_ERR_BUSY;
+        }
     }
+
     xf_list_del_init(&mtopic->node);
-    xf_free(mtopic);
+    xf_task_mbus_topic_free(bus_handle, mtopic);
 
     return XF_OK;
 }
 
-
-xf_err_t xf_task_mbus_pub_async(uint32_t topic_id, void *data)
+xf_err_t xf_task_mbus_pub_async_with_bus(xf_task_mbus_t bus, uint32_t topic_id, void *data)
 {
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
     XF_ASSERT(data, XF_ERR_INVALID_ARG, TAG, "data must not be NULL");
 
     xf_task_mtopic_t *mtopic = NULL;
 
-    if (xf_task_mbus_find(topic_id, &mtopic) == XF_ERR_NOT_FOUND) {
+    if (xf_task_mbus_find((xf_task_mbus_handle_t *)bus, topic_id, &mtopic) == XF_ERR_NOT_FOUND) {
         XF_LOGE(TAG, "topic:%d not found", (int)topic_id);
         return XF_ERR_NOT_FOUND;
     }
 
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+    // 只会从队尾发送、从队头取出，发布时间按同样的顺序记录
+    size_t index = (mtopic->stamp_head + xf_task_queue_count(&mtopic->pub_queue)) % DEFAULT_QUEUE_COUNT;
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+
     xf_err_t err = xf_task_queue_send(&mtopic->pub_queue, data, XF_TASK_QUEUE_SEND_TO_BACK);
+
+    if (err == XF_OK) {
+        XF_TASK_PROBE3(mbus__publish, bus, topic_id, 0);
+    }
+
+#if XF_TASK_TRACE_IS_ENABLE
+    if (err == XF_OK) {
+        xf_task_trace_record(xf_task_mbus_get_manager(bus), XF_TASK_TRACE_MBUS_PUBLISH, bus, topic_id, 0);
+    }
+#endif // XF_TASK_TRACE_IS_ENABLE
+
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+    if (err == XF_OK) {
+        mtopic->stamp[index] = xf_task_get_ticks();
+    }
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+
     return err;
 }
 
-
-xf_err_t xf_task_mbus_pub_sync(uint32_t topic_id, void *data)
+xf_err_t xf_task_mbus_pub_sync_with_bus(xf_task_mbus_t bus, uint32_t topic_id, void *data)
 {
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
     XF_ASSERT(data, XF_ERR_INVALID_ARG, TAG, "data must not be NULL");
 
+    xf_task_mbus_handle_t *bus_handle = (xf_task_mbus_handle_t *)bus;
     xf_task_mtopic_t *mtopic = NULL;
 
-    if (xf_task_mbus_find(topic_id, &mtopic) == XF_ERR_NOT_FOUND) {
+    if (xf_task_mbus_find(bus_handle, topic_id, &mtopic) == XF_ERR_NOT_FOUND) {
         XF_LOGE(TAG, "topic:%d not found", (int)topic_id);
         return XF_ERR_NOT_FOUND;
     }
 
-    xf_task_mbus_run(mtopic, data);
+#if XF_TASK_TRACE_IS_ENABLE
+    xf_task_trace_record(xf_task_mbus_get_manager(bus), XF_TASK_TRACE_MBUS_PUBLISH, bus, topic_id, 1);
+#endif // XF_TASK_TRACE_IS_ENABLE
+    XF_TASK_PROBE3(mbus__publish, bus, topic_id, 1);
+
+    xf_task_mbus_run(bus_handle, mtopic, data, true);
 
     return XF_OK;
 }
 
-xf_err_t xf_task_mbus_sub(uint32_t topic_id, xf_task_mbus_func_t mbus_cb, void *user_data)
+xf_err_t xf_task_mbus_sub_with_bus(xf_task_mbus_t bus, uint32_t topic_id, xf_task_mbus_func_t mbus_cb,
+                                   void *user_data)
 {
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
     XF_ASSERT(mbus_cb, XF_ERR_INVALID_ARG, TAG, "mbus_cb must not be NULL");
 
+    xf_task_mbus_handle_t *bus_handle = (xf_task_mbus_handle_t *)bus;
     xf_task_mtopic_t *mtopic = NULL;
-    xf_task_msub_t *msub = NULL;
+    xf_task_msub_block_t *block;
 
-    if (xf_task_mbus_find(topic_id, &mtopic) == XF_ERR_NOT_FOUND) {
+    if (xf_task_mbus_find(bus_handle, topic_id, &mtopic) == XF_ERR_NOT_FOUND) {
         XF_LOGE(TAG, "topic:%d not found", (int)topic_id);
         return XF_ERR_NOT_FOUND;
     }
 
-    xf_list_for_each_entry(msub, &mtopic->sub_list, xf_task_msub_t, node) {
-        if (msub->mbus_cb == mbus_cb) {
+    block = mtopic->subs;
+    for (uint16_t i = 0; block != NULL && i < block->exact; i++) {
+        if (block->subs[i].mbus_cb == mbus_cb) {
             XF_LOGD(TAG, "mbus_cb is exists!");
             return XF_ERR_INITED;
         }
     }
 
-    // 如果没有重复注册，则创建并加入链表
-    msub = (xf_task_msub_t *)xf_malloc(sizeof(xf_task_msub_t));
-
-    if (msub == NULL)
-    {
-        XF_LOGE(TAG, "memory alloc failed!");
-        return XF_ERR_NO_MEM;
-    }
-
-    xf_list_init(&msub->node);
-
-    msub->mbus_cb = mbus_cb;
-    msub->user_data = user_data;
+    // 如果没有重复注册，则追加到精确订阅的末尾
+    xf_task_msub_t msub = {
+        .mbus_cb = mbus_cb,
+        .user_data = user_data,
+#if XF_TASK_MBUS_PATTERN_IS_ENABLE
+        .owner = NULL,
+#endif // XF_TASK_MBUS_PATTERN_IS_ENABLE
+    };
 
-    xf_list_add_tail(&msub->node, &mtopic->sub_list);
-
-    return XF_OK;
+    return xf_task_mbus_subs_insert(bus_handle, mtopic, (block == NULL) ? 0 : block->exact, &msub);
 }
 
-xf_err_t xf_task_mbus_unsub(uint32_t topic_id, xf_task_mbus_func_t mbus_cb)
+xf_err_t xf_task_mbus_unsub_with_bus(xf_task_mbus_t bus, uint32_t topic_id, xf_task_mbus_func_t mbus_cb)
 {
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
     XF_ASSERT(mbus_cb, XF_ERR_INVALID_ARG, TAG, "mbus_cb must not be NULL");
 
+    xf_task_mbus_handle_t *bus_handle = (xf_task_mbus_handle_t *)bus;
     xf_task_mtopic_t *mtopic = NULL;
-    xf_task_msub_t *msub, *_msub;
+    xf_task_msub_block_t *block;
 
-    if (xf_task_mbus_find(topic_id, &mtopic) == XF_ERR_NOT_FOUND) {
+    if (xf_task_mbus_find(bus_handle, topic_id, &mtopic) == XF_ERR_NOT_FOUND) {
         XF_LOGE(TAG, "topic:%d not found", (int)topic_id);
         return XF_ERR_NOT_FOUND;
     }
 
-    xf_list_for_each_entry_safe(msub, _msub, &mtopic->sub_list, xf_task_msub_t, node) {
-        if (msub->mbus_cb == mbus_cb) {
-            xf_list_del_init(&msub->node);
-            xf_free(msub);
+    block = mtopic->subs;
+    for (uint16_t i = 0; block != NULL && i < block->exact; i++) {
+        if (block->subs[i].mbus_cb == mbus_cb) {
+            xf_task_mbus_subs_remove(bus_handle, mtopic, i);
             return XF_OK;
         }
     }
@@ -191,60 +408,1206 @@ xf_err_t xf_task_mbus_unsub(uint32_t topic_id, xf_task_mbus_func_t mbus_cb)
     return XF_ERR_NOT_FOUND;
 }
 
-xf_err_t xf_task_mbus_unsub_all(uint32_t topic_id)
+xf_err_t xf_task_mbus_unsub_all_with_bus(xf_task_mbus_t bus, uint32_t topic_id)
 {
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
+
+    xf_task_mbus_handle_t *bus_handle = (xf_task_mbus_handle_t *)bus;
     xf_task_mtopic_t *mtopic = NULL;
-    xf_task_msub_t *msub, *_msub;
 
-    if (xf_task_mbus_find(topic_id, &mtopic) == XF_ERR_NOT_FOUND) {
+    if (xf_task_mbus_find(bus_handle, topic_id, &mtopic) == XF_ERR_NOT_FOUND) {
         XF_LOGE(TAG, "topic:%d not found", (int)topic_id);
         return XF_ERR_NOT_FOUND;
     }
 
-    xf_list_for_each_entry_safe(msub, _msub, &mtopic->sub_list, xf_task_msub_t, node) {
-        xf_list_del_init(&msub->node);
-        xf_free(msub);
+    // 模式订阅不受影响，只移除精确订阅
+    while (mtopic->subs != NULL && mtopic->subs->exact != 0) {
+        xf_task_mbus_subs_remove(bus_handle, mtopic, 0);
     }
 
     return XF_OK;
 }
 
-void xf_task_mbus_handle(void)
+#if XF_TASK_MBUS_PATTERN_IS_ENABLE
+
+xf_err_t xf_task_mbus_sub_range_with_bus(xf_task_mbus_t bus, uint32_t first_id, uint32_t last_id,
+        xf_task_mbus_func_t mbus_cb, void *user_data)
+{
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
+    XF_ASSERT(mbus_cb, XF_ERR_INVALID_ARG, TAG, "mbus_cb must not be NULL");
+    XF_ASSERT(first_id <= last_id, XF_ERR_INVALID_ARG, TAG, "first_id must not be greater than last_id");
+
+    return xf_task_mbus_sub_pattern((xf_task_mbus_handle_t *)bus, first_id, last_id, 0, 0, mbus_cb, user_data);
+}
+
+xf_err_t xf_task_mbus_unsub_range_with_bus(xf_task_mbus_t bus, uint32_t first_id, uint32_t last_id,
+        xf_task_mbus_func_t mbus_cb)
+{
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
+    XF_ASSERT(mbus_cb, XF_ERR_INVALID_ARG, TAG, "mbus_cb must not be NULL");
+
+    return xf_task_mbus_unsub_pattern((xf_task_mbus_handle_t *)bus, first_id, last_id, 0, 0, mbus_cb);
+}
+
+xf_err_t xf_task_mbus_sub_mask_with_bus(xf_task_mbus_t bus, uint32_t topic_id, uint32_t mask,
+                                        xf_task_mbus_func_t mbus_cb, void *user_data)
+{
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
+    XF_ASSERT(mbus_cb, XF_ERR_INVALID_ARG, TAG, "mbus_cb must not be NULL");
+
+    return xf_task_mbus_sub_pattern((xf_task_mbus_handle_t *)bus, 0, UINT32_MAX, mask, topic_id & mask, mbus_cb,
+                                    user_data);
+}
+
+xf_err_t xf_task_mbus_unsub_mask_with_bus(xf_task_mbus_t bus, uint32_t topic_id, uint32_t mask,
+        xf_task_mbus_func_t mbus_cb)
+{
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
+    XF_ASSERT(mbus_cb, XF_ERR_INVALID_ARG, TAG, "mbus_cb must not be NULL");
+
+    return xf_task_mbus_unsub_pattern((xf_task_mbus_handle_t *)bus, 0, UINT32_MAX, mask, topic_id & mask, mbus_cb);
+}
+
+#endif // XF_TASK_MBUS_PATTERN_IS_ENABLE
+
+xf_err_t xf_task_mbus_get_current_topic_with_bus(xf_task_mbus_t bus, uint32_t *topic_id)
+{
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
+    XF_ASSERT(topic_id, XF_ERR_INVALID_ARG, TAG, "topic_id must not be NULL");
+
+    xf_task_mbus_handle_t *bus_handle = (xf_task_mbus_handle_t *)bus;
+
+    if (bus_handle->current_topic == NULL) {
+        return XF_ERR_INVALID_STATE;
+    }
+
+    *topic_id = bus_handle->current_topic->id;
+
+    return XF_OK;
+}
+
+void xf_task_mbus_handle_with_bus(xf_task_mbus_t bus)
 {
+    XF_ASSERT(bus, XF_RETURN_VOID, TAG, "bus must not be NULL");
+
+    xf_task_mbus_handle_t *bus_handle = (xf_task_mbus_handle_t *)bus;
+
     // 循环执行订阅回调
     xf_task_mtopic_t *mtopic;
-    xf_list_for_each_entry(mtopic, &_topic_list, xf_task_mtopic_t, node) {
+    xf_list_for_each_entry(mtopic, &bus_handle->topic_list, xf_task_mtopic_t, node) {
         while (!xf_task_queue_is_empty(&mtopic->pub_queue)) {
             void *pub_data = xf_task_queue_peek(&mtopic->pub_queue);
-            xf_task_mbus_run(mtopic, pub_data);
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+            xf_task_mbus_hist_record(&mtopic->queue_hist, xf_task_get_ticks() - mtopic->stamp[mtopic->stamp_head]);
+            mtopic->stamp_head = (mtopic->stamp_head + 1) % DEFAULT_QUEUE_COUNT;
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+            xf_task_mbus_run(bus_handle, mtopic, pub_data, true);
             xf_task_queue_remove_front(&mtopic->pub_queue);
         }
     }
+
+    // 处理其他总线桥接过来的消息
+    xf_task_mbridge_t *bridge;
+    xf_list_for_each_entry(bridge, &bus_handle->bridge_list, xf_task_mbridge_t, dst_node) {
+        xf_task_mbus_bridge_drain(bridge);
+    }
+
+#if XF_TASK_MBUS_RPC_IS_ENABLE
+    // 结束已超时的请求，并唤醒等待的任务
+    xf_task_mbus_call_t *call, *_call;
+    xf_list_for_each_entry_safe(call, _call, &bus_handle->call_list, xf_task_mbus_call_t, node) {
+        if ((int32_t)(xf_task_get_ticks() - call->deadline) >= 0) {
+            xf_task_mbus_call_finish(call, XF_ERR_TIMEOUT);
+            if (call->task != NULL) {
+                xf_task_trigger(call->task);
+            }
+        }
+    }
+#endif // XF_TASK_MBUS_RPC_IS_ENABLE
+
+#if XF_TASK_MBUS_TRACE_IS_ENABLE && XF_TASK_MBUS_TRACE_DUMP_PERIOD
+    xf_task_time_t now = xf_task_get_ticks();
+    if (now - bus_handle->last_dump >= XF_TASK_MBUS_TRACE_DUMP_PERIOD) {
+        bus_handle->last_dump = now;
+        xf_task_mbus_trace_dump_with_bus(bus);
+    }
+#endif
 }
 
-/* ==================== [Static Functions] ================================== */
+xf_err_t xf_task_mbus_bridge(xf_task_mbus_t src, xf_task_mbus_t dst, uint32_t topic_id, uint32_t depth)
+{
+    XF_ASSERT(src, XF_ERR_INVALID_ARG, TAG, "src must not be NULL");
+    XF_ASSERT(dst, XF_ERR_INVALID_ARG, TAG, "dst must not be NULL");
+    XF_ASSERT(src != dst, XF_ERR_INVALID_ARG, TAG, "src must not be dst");
+    XF_ASSERT(depth > 0 && depth <= (1UL << 16), XF_ERR_INVALID_ARG, TAG, "depth must be in 1 ~ 65536");
+
+    xf_task_mbus_handle_t *src_handle = (xf_task_mbus_handle_t *)src;
+    xf_task_mbus_handle_t *dst_handle = (xf_task_mbus_handle_t *)dst;
+    xf_task_mtopic_t *src_topic = NULL;
+    xf_task_mtopic_t *dst_topic = NULL;
+
+    if (xf_task_mbus_find(src_handle, topic_id, &src_topic) == XF_ERR_NOT_FOUND
+            || xf_task_mbus_find(dst_handle, topic_id, &dst_topic) == XF_ERR_NOT_FOUND) {
+        XF_LOGE(TAG, "topic:%d not found", (int)topic_id);
+        return XF_ERR_NOT_FOUND;
+    }
+
+    XF_ASSERT(src_topic->size == dst_topic->size, XF_ERR_INVALID_ARG, TAG, "topic size must be equal");
+
+    if (xf_task_mbus_bridge_find(src_handle, dst_handle, topic_id) != NULL) {
+        XF_LOGD(TAG, "bridge is exists!");
+        return XF_ERR_INITED;
+    }
+
+    // 深度向上取整为 2 的幂，便于用掩码取下标
+    uint32_t count = 1;
+    while (count < depth) {
+        count <<= 1;
+    }
+
+    xf_task_mbridge_t *bridge = (xf_task_mbridge_t *)xf_malloc(sizeof(xf_task_mbridge_t) + count * src_topic->size);
+    if (bridge == NULL) {
+        XF_LOGE(TAG, "memory alloc failed!");
+        return XF_ERR_NO_MEM;
+    }
+
+    bridge->src = src_handle;
+    bridge->dst = dst_handle;
+    bridge->src_topic = src_topic;
+    bridge->dst_topic = dst_topic;
+    bridge->head = 0;
+    bridge->tail = 0;
+    bridge->mask = count - 1;
+    bridge->dropped = 0;
+    bridge->buf = (uint8_t *)bridge + sizeof(xf_task_mbridge_t);
+    xf_list_init(&bridge->src_node);
+    xf_list_init(&bridge->dst_node);
+    xf_list_add_tail(&bridge->src_node, &src_topic->bridge_list);
+    xf_list_add_tail(&bridge->dst_node, &dst_handle->bridge_list);
+
+    return XF_OK;
+}
+
+xf_err_t xf_task_mbus_unbridge(xf_task_mbus_t src, xf_task_mbus_t dst, uint32_t topic_id)
+{
+    XF_ASSERT(src, XF_ERR_INVALID_ARG, TAG, "src must not be NULL");
+    XF_ASSERT(dst, XF_ERR_INVALID_ARG, TAG, "dst must not be NULL");
+
+    xf_task_mbridge_t *bridge = xf_task_mbus_bridge_find((xf_task_mbus_handle_t *)src,
+                                (xf_task_mbus_handle_t *)dst, topic_id);
+    if (bridge == NULL) {
+        XF_LOGE(TAG, "bridge not found!");
+        return XF_ERR_NOT_FOUND;
+    }
 
-static void xf_task_mbus_run(xf_task_mtopic_t *mtopic, void *data)
+    xf_list_del_init(&bridge->src_node);
+    xf_list_del_init(&bridge->dst_node);
+    xf_free(bridge);
+
+    return XF_OK;
+}
+
+uint32_t xf_task_mbus_bridge_get_dropped(xf_task_mbus_t src, xf_task_mbus_t dst, uint32_t topic_id)
+{
+    XF_ASSERT(src, 0, TAG, "src must not be NULL");
+    XF_ASSERT(dst, 0, TAG, "dst must not be NULL");
+
+    xf_task_mbridge_t *bridge = xf_task_mbus_bridge_find((xf_task_mbus_handle_t *)src,
+                                (xf_task_mbus_handle_t *)dst, topic_id);
+
+    return (bridge == NULL) ? 0 : XF_TASK_ATOMIC_LOAD(&bridge->dropped);
+}
+
+#if XF_TASK_MBUS_RPC_IS_ENABLE
+
+xf_err_t xf_task_mbus_serve_with_bus(xf_task_mbus_t bus, uint32_t topic_id, uint32_t resp_size,
+                                     xf_task_mbus_serve_func_t serve_cb, void *user_data)
 {
-    xf_task_msub_t *msub;
-    xf_list_for_each_entry(msub, &mtopic->sub_list, xf_task_msub_t, node) {
-        msub->mbus_cb(data, msub->user_data);
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
+    XF_ASSERT(resp_size, XF_ERR_INVALID_ARG, TAG, "resp_size must not be 0");
+    XF_ASSERT(serve_cb, XF_ERR_INVALID_ARG, TAG, "serve_cb must not be NULL");
+
+    xf_task_mtopic_t *mtopic = NULL;
+
+    if (xf_task_mbus_find((xf_task_mbus_handle_t *)bus, topic_id, &mtopic) == XF_ERR_NOT_FOUND) {
+        XF_LOGE(TAG, "topic:%d not found", (int)topic_id);
+        return XF_ERR_NOT_FOUND;
+    }
+
+    if (mtopic->serve_cb != NULL) {
+        XF_LOGD(TAG, "serve is exists!");
+        return XF_ERR_INITED;
     }
+
+    mtopic->serve_cb = serve_cb;
+    mtopic->serve_user_data = user_data;
+    mtopic->resp_size = resp_size;
+
+    return XF_OK;
 }
 
-static xf_err_t xf_task_mbus_find(uint32_t topic_id, xf_task_mtopic_t **topic)
+xf_err_t xf_task_mbus_unserve_with_bus(xf_task_mbus_t bus, uint32_t topic_id)
 {
-    xf_task_mtopic_t *mtopic;
-    xf_list_for_each_entry(mtopic, &_topic_list, xf_task_mtopic_t, node) {
-        if (mtopic->id == topic_id) {
-            if (topic != NULL) {
-                *topic = mtopic;
-            }
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
+
+    xf_task_mtopic_t *mtopic = NULL;
+
+    if (xf_task_mbus_find((xf_task_mbus_handle_t *)bus, topic_id, &mtopic) == XF_ERR_NOT_FOUND
+            || mtopic->serve_cb == NULL) {
+        XF_LOGE(TAG, "serve:%d not found", (int)topic_id);
+        return XF_ERR_NOT_FOUND;
+    }
+
+    mtopic->serve_cb = NULL;
+    mtopic->serve_user_data = NULL;
+
+    return XF_OK;
+}
+
+xf_err_t xf_task_mbus_call_with_bus(xf_task_mbus_t bus, uint32_t topic_id, void *req, void *resp,
+                                    uint32_t timeout)
+{
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
+
+#if XF_TASK_CONTEXT_IS_ENABLE
+    xf_task_manager_t manager = xf_task_mbus_get_manager(bus);
+    xf_task_t task = xf_task_manager_get_current_task(manager);
+    xf_task_mbus_call_t call;
+
+    // 只有ctask才能阻塞等待
+    if (task == NULL || XF_TASK_TYPE_CTASK != xf_task_get_type(task)) {
+        XF_LOGE(TAG, "task must ctask");
+        return XF_ERR_NOT_SUPPORTED;
+    }
+
+    xf_err_t err = xf_task_mbus_call_start_with_bus(bus, &call, task, topic_id, req, resp, timeout);
+    if (err != XF_OK) {
+        return err;
+    }
+
+    while (call.pending) {
+        // 应答到来时会被提前唤醒，从而延时未达到timeout
+        xf_ctask_delay_with_manager(manager, timeout);
+        if (!call.pending) {
+            break;
+        }
+        // 达到超时，撤销请求，之后的应答会被丢弃
+        if (xf_task_get_timeout(task) >= 0) {
+            xf_task_mbus_call_finish(&call, XF_ERR_TIMEOUT);
+            break;
+        }
+        // 没达到超时进入循环继续进行接下来的超时
+        timeout = -xf_task_get_timeout(task);
+    }
+
+    return call.err;
+#else
+    UNUSED(topic_id);
+    UNUSED(req);
+    UNUSED(resp);
+    UNUSED(timeout);
+    XF_LOGE(TAG, "ctask is disabled");
+    return XF_ERR_NOT_SUPPORTED;
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+}
+
+xf_err_t xf_task_mbus_call_start_with_bus(xf_task_mbus_t bus, xf_task_mbus_call_t *call, xf_task_t task,
+        uint32_t topic_id, void *req, void *resp, uint32_t timeout)
+{
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
+    XF_ASSERT(call, XF_ERR_INVALID_ARG, TAG, "call must not be NULL");
+    XF_ASSERT(req, XF_ERR_INVALID_ARG, TAG, "req must not be NULL");
+    XF_ASSERT(resp, XF_ERR_INVALID_ARG, TAG, "resp must not be NULL");
+
+    xf_task_mbus_handle_t *bus_handle = (xf_task_mbus_handle_t *)bus;
+    xf_task_mtopic_t *mtopic = NULL;
+
+    xf_list_init(&call->node);
+    call->task = NULL;
+    call->pending = false;
+    call->err = XF_ERR_NOT_FOUND;
+
+    if (xf_task_mbus_find(bus_handle, topic_id, &mtopic) == XF_ERR_NOT_FOUND || mtopic->serve_cb == NULL) {
+        XF_LOGE(TAG, "serve:%d not found", (int)topic_id);
+        return XF_ERR_NOT_FOUND;
+    }
+
+    // 0 保留给无效的关联 id
+    if (++bus_handle->corr_seq == 0) {
+        bus_handle->corr_seq = 1;
+    }
+
+    call->resp = resp;
+    call->resp_size = mtopic->resp_size;
+    call->corr_id = bus_handle->corr_seq;
+    call->deadline = xf_task_get_ticks() + xf_task_msec_to_ticks(timeout);
+    call->err = XF_ERR_BUSY;
+    call->pending = true;
+    xf_list_add_tail(&call->node, &bus_handle->call_list);
+
+    xf_task_mbus_reply_t reply = {
+        .bus = bus,
+        .corr_id = call->corr_id,
+    };
+
+    // 请求直接交给服务，服务回调内应答时调用者还没有开始等待，不需要唤醒
+    xf_task_mtopic_t *last_topic = bus_handle->current_topic;
+    bus_handle->current_topic = mtopic;
+    mtopic->serve_cb(req, &reply, mtopic->serve_user_data);
+    bus_handle->current_topic = last_topic;
+
+    call->task = task;
+
+    return XF_OK;
+}
+
+#endif // XF_TASK_MBUS_RPC_IS_ENABLE
+
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+
+xf_err_t xf_task_mbus_trace_queue_with_bus(xf_task_mbus_t bus, uint32_t topic_id, xf_task_mbus_stat_t *stat)
+{
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
+    XF_ASSERT(stat, XF_ERR_INVALID_ARG, TAG, "stat must not be NULL");
+
+    xf_task_mtopic_t *mtopic = NULL;
+
+    if (xf_task_mbus_find((xf_task_mbus_handle_t *)bus, topic_id, &mtopic) == XF_ERR_NOT_FOUND) {
+        XF_LOGE(TAG, "topic:%d not found", (int)topic_id);
+        return XF_ERR_NOT_FOUND;
+    }
+
+    xf_task_mbus_hist_stat(&mtopic->queue_hist, stat);
+
+    return XF_OK;
+}
+
+xf_err_t xf_task_mbus_trace_sub_with_bus(xf_task_mbus_t bus, uint32_t topic_id, xf_task_mbus_func_t mbus_cb,
+        xf_task_mbus_stat_t *stat)
+{
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
+    XF_ASSERT(mbus_cb, XF_ERR_INVALID_ARG, TAG, "mbus_cb must not be NULL");
+    XF_ASSERT(stat, XF_ERR_INVALID_ARG, TAG, "stat must not be NULL");
+
+    xf_task_mtopic_t *mtopic = NULL;
+    xf_task_msub_block_t *block;
+
+    if (xf_task_mbus_find((xf_task_mbus_handle_t *)bus, topic_id, &mtopic) == XF_ERR_NOT_FOUND) {
+        XF_LOGE(TAG, "topic:%d not found", (int)topic_id);
+        return XF_ERR_NOT_FOUND;
+    }
+
+    block = mtopic->subs;
+    for (uint16_t i = 0; block != NULL && i < block->count; i++) {
+        if (block->subs[i].mbus_cb == mbus_cb) {
+            xf_task_mbus_hist_stat(block->subs[i].hist, stat);
             return XF_OK;
         }
     }
 
+    XF_LOGE(TAG, "mbus_cb not found!");
+
     return XF_ERR_NOT_FOUND;
 }
 
+xf_err_t xf_task_mbus_trace_reset_with_bus(xf_task_mbus_t bus, uint32_t topic_id)
+{
+    XF_ASSERT(bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
+
+    xf_task_mtopic_t *mtopic = NULL;
+    xf_task_msub_block_t *block;
+
+    if (xf_task_mbus_find((xf_task_mbus_handle_t *)bus, topic_id, &mtopic) == XF_ERR_NOT_FOUND) {
+        XF_LOGE(TAG, "topic:%d not found", (int)topic_id);
+        return XF_ERR_NOT_FOUND;
+    }
+
+    xf_memset(&mtopic->queue_hist, 0, sizeof(xf_task_mhist_t));
+    block = mtopic->subs;
+    for (uint16_t i = 0; block != NULL && i < block->count; i++) {
+        xf_memset(block->subs[i].hist, 0, sizeof(xf_task_mhist_t));
+    }
+
+    return XF_OK;
+}
+
+void xf_task_mbus_trace_dump_with_bus(xf_task_mbus_t bus)
+{
+    XF_ASSERT(bus, XF_RETURN_VOID, TAG, "bus must not be NULL");
+
+    xf_task_mbus_handle_t *bus_handle = (xf_task_mbus_handle_t *)bus;
+    xf_task_mbus_stat_t stat;
+    xf_task_mtopic_t *mtopic;
+
+    xf_list_for_each_entry(mtopic, &bus_handle->topic_list, xf_task_mtopic_t, node) {
+        xf_task_mbus_hist_stat(&mtopic->queue_hist, &stat);
+        XF_LOGI(TAG, "topic:%d queue n:%d min:%d p50:%d p90:%d p99:%d max:%d", (int)mtopic->id, (int)stat.count,
+                (int)stat.min, (int)stat.p50, (int)stat.p90, (int)stat.p99, (int)stat.max);
+
+        xf_task_msub_block_t *block = mtopic->subs;
+        for (uint16_t i = 0; block != NULL && i < block->count; i++) {
+            xf_task_mbus_hist_stat(block->subs[i].hist, &stat);
+            XF_LOGI(TAG, "topic:%d sub[%d] n:%d min:%d p50:%d p90:%d p99:%d max:%d", (int)mtopic->id, (int)i,
+                    (int)stat.count, (int)stat.min, (int)stat.p50, (int)stat.p90, (int)stat.p99, (int)stat.max);
+        }
+    }
+}
+
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+
+xf_err_t xf_task_mbus_reg_topic(uint32_t topic_id, uint32_t size)
+{
+    return xf_task_mbus_reg_topic_with_bus(&_default_bus, topic_id, size);
+}
+
+xf_err_t xf_task_mbus_reg_topic_static(uint32_t topic_id, uint32_t size, void *storage)
+{
+    return xf_task_mbus_reg_topic_static_with_bus(&_default_bus, topic_id, size, storage);
+}
+
+xf_err_t xf_task_mbus_unreg_topic(uint32_t topic_id)
+{
+    return xf_task_mbus_unreg_topic_with_bus(&_default_bus, topic_id);
+}
+
+xf_err_t xf_task_mbus_pub_async(uint32_t topic_id, void *data)
+{
+    return xf_task_mbus_pub_async_with_bus(&_default_bus, topic_id, data);
+}
+
+xf_err_t xf_task_mbus_pub_sync(uint32_t topic_id, void *data)
+{
+    return xf_task_mbus_pub_sync_with_bus(&_default_bus, topic_id, data);
+}
+
+xf_err_t xf_task_mbus_sub(uint32_t topic_id, xf_task_mbus_func_t mbus_cb, void *user_data)
+{
+    return xf_task_mbus_sub_with_bus(&_default_bus, topic_id, mbus_cb, user_data);
+}
+
+xf_err_t xf_task_mbus_unsub(uint32_t topic_id, xf_task_mbus_func_t mbus_cb)
+{
+    return xf_task_mbus_unsub_with_bus(&_default_bus, topic_id, mbus_cb);
+}
+
+xf_err_t xf_task_mbus_unsub_all(uint32_t topic_id)
+{
+    return xf_task_mbus_unsub_all_with_bus(&_default_bus, topic_id);
+}
+
+#if XF_TASK_MBUS_PATTERN_IS_ENABLE
+
+xf_err_t xf_task_mbus_sub_range(uint32_t first_id, uint32_t last_id, xf_task_mbus_func_t mbus_cb, void *user_data)
+{
+    return xf_task_mbus_sub_range_with_bus(&_default_bus, first_id, last_id, mbus_cb, user_data);
+}
+
+xf_err_t xf_task_mbus_unsub_range(uint32_t first_id, uint32_t last_id, xf_task_mbus_func_t mbus_cb)
+{
+    return xf_task_mbus_unsub_range_with_bus(&_default_bus, first_id, last_id, mbus_cb);
+}
+
+xf_err_t xf_task_mbus_sub_mask(uint32_t topic_id, uint32_t mask, xf_task_mbus_func_t mbus_cb, void *user_data)
+{
+    return xf_task_mbus_sub_mask_with_bus(&_default_bus, topic_id, mask, mbus_cb, user_data);
+}
+
+xf_err_t xf_task_mbus_unsub_mask(uint32_t topic_id, uint32_t mask, xf_task_mbus_func_t mbus_cb)
+{
+    return xf_task_mbus_unsub_mask_with_bus(&_default_bus, topic_id, mask, mbus_cb);
+}
+
+#endif // XF_TASK_MBUS_PATTERN_IS_ENABLE
+
+xf_err_t xf_task_mbus_get_current_topic(uint32_t *topic_id)
+{
+    return xf_task_mbus_get_current_topic_with_bus(&_default_bus, topic_id);
+}
+
+void xf_task_mbus_handle(void)
+{
+    xf_task_mbus_handle_with_bus(&_default_bus);
+}
+
+#if XF_TASK_MBUS_RPC_IS_ENABLE
+
+xf_err_t xf_task_mbus_serve(uint32_t topic_id, uint32_t resp_size, xf_task_mbus_serve_func_t serve_cb,
+                            void *user_data)
+{
+    return xf_task_mbus_serve_with_bus(&_default_bus, topic_id, resp_size, serve_cb, user_data);
+}
+
+xf_err_t xf_task_mbus_unserve(uint32_t topic_id)
+{
+    return xf_task_mbus_unserve_with_bus(&_default_bus, topic_id);
+}
+
+xf_err_t xf_task_mbus_call(uint32_t topic_id, void *req, void *resp, uint32_t timeout)
+{
+    return xf_task_mbus_call_with_bus(&_default_bus, topic_id, req, resp, timeout);
+}
+
+xf_err_t xf_task_mbus_reply(const xf_task_mbus_reply_t *reply, const void *resp)
+{
+    XF_ASSERT(reply, XF_ERR_INVALID_ARG, TAG, "reply must not be NULL");
+    XF_ASSERT(reply->bus, XF_ERR_INVALID_ARG, TAG, "bus must not be NULL");
+    XF_ASSERT(resp, XF_ERR_INVALID_ARG, TAG, "resp must not be NULL");
+
+    xf_task_mbus_call_t *call = xf_task_mbus_call_find((xf_task_mbus_handle_t *)reply->bus, reply->corr_id);
+
+    if (call == NULL) {
+        XF_LOGD(TAG, "call:%d not found", (int)reply->corr_id);
+        return XF_ERR_NOT_FOUND;
+    }
+
+    // 按关联 id 直接送回调用者
+    xf_memcpy(call->resp, resp, call->resp_size);
+    xf_task_mbus_call_finish(call, XF_OK);
+    if (call->task != NULL) {
+        xf_task_trigger(call->task);
+    }
+
+    return XF_OK;
+}
+
+bool xf_task_mbus_call_is_pending(xf_task_mbus_call_t *call)
+{
+    XF_ASSERT(call, false, TAG, "call must not be NULL");
+
+    if (call->pending && (int32_t)(xf_task_get_ticks() - call->deadline) >= 0) {
+        xf_task_mbus_call_finish(call, XF_ERR_TIMEOUT);
+    }
+
+    return call->pending;
+}
+
+xf_err_t xf_task_mbus_call_get_err(const xf_task_mbus_call_t *call)
+{
+    XF_ASSERT(call, XF_ERR_INVALID_ARG, TAG, "call must not be NULL");
+
+    return call->err;
+}
+
+#endif // XF_TASK_MBUS_RPC_IS_ENABLE
+
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+
+xf_err_t xf_task_mbus_trace_queue(uint32_t topic_id, xf_task_mbus_stat_t *stat)
+{
+    return xf_task_mbus_trace_queue_with_bus(&_default_bus, topic_id, stat);
+}
+
+xf_err_t xf_task_mbus_trace_sub(uint32_t topic_id, xf_task_mbus_func_t mbus_cb, xf_task_mbus_stat_t *stat)
+{
+    return xf_task_mbus_trace_sub_with_bus(&_default_bus, topic_id, mbus_cb, stat);
+}
+
+xf_err_t xf_task_mbus_trace_reset(uint32_t topic_id)
+{
+    return xf_task_mbus_trace_reset_with_bus(&_default_bus, topic_id);
+}
+
+void xf_task_mbus_trace_dump(void)
+{
+    xf_task_mbus_trace_dump_with_bus(&_default_bus);
+}
+
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+
+/* ==================== [Static Functions] ================================== */
+
+static void xf_task_mbus_run(xf_task_mbus_handle_t *bus, xf_task_mtopic_t *mtopic, void *data, bool forward)
+{
+    // 回调中可能再次同步发布，需要保存上一层的 topic
+    xf_task_mtopic_t *last_topic = bus->current_topic;
+    bus->current_topic = mtopic;
+
+    // 分发期间订阅数组只读，回调中的订阅变更会写到新数组，本轮仍使用旧数组
+    xf_task_msub_block_t *block = mtopic->subs;
+#if XF_TASK_TRACE_IS_ENABLE
+    xf_task_manager_t manager = xf_task_mbus_get_manager((xf_task_mbus_t)bus);
+    xf_task_trace_record(manager, XF_TASK_TRACE_MBUS_DISPATCH_BEGIN, bus, mtopic->id,
+                         (block != NULL) ? block->count : 0);
+#endif // XF_TASK_TRACE_IS_ENABLE
+    if (block != NULL) {
+        mtopic->depth++;
+        for (uint16_t i = 0; i < block->count; i++) {
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+            xf_task_time_t start = xf_task_get_ticks();
+            block->subs[i].mbus_cb(data, block->subs[i].user_data);
+            xf_task_mbus_hist_record(block->subs[i].hist, xf_task_get_ticks() - start);
+#else
+            block->subs[i].mbus_cb(data, block->subs[i].user_data);
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+        }
+        mtopic->depth--;
+
+        // 最外层分发结束，回收分发期间被替换的数组
+        while (mtopic->depth == 0 && mtopic->retire != NULL) {
+            xf_task_msub_block_t *retire = mtopic->retire;
+            mtopic->retire = retire->next;
+            xf_task_mbus_block_free(bus, retire);
+        }
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+        if (mtopic->depth == 0) {
+            xf_task_mbus_hist_free(mtopic);
+        }
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+    }
+#if XF_TASK_TRACE_IS_ENABLE
+    xf_task_trace_record(manager, XF_TASK_TRACE_MBUS_DISPATCH_END, bus, mtopic->id, 0);
+#endif // XF_TASK_TRACE_IS_ENABLE
+
+    // 复制给桥接的其他总线
+    if (forward) {
+        xf_task_mbridge_t *bridge;
+        xf_list_for_each_entry(bridge, &mtopic->bridge_list, xf_task_mbridge_t, src_node) {
+            xf_task_mbus_bridge_push(bridge, data);
+        }
+    }
+
+    bus->current_topic = last_topic;
+}
+
+static xf_err_t xf_task_mbus_find(xf_task_mbus_handle_t *bus, uint32_t topic_id, xf_task_mtopic_t **topic)
+{
+    xf_task_mtopic_t *mtopic;
+    xf_list_for_each_entry(mtopic, &bus->topic_list, xf_task_mtopic_t, node) {
+        if (mtopic->id == topic_id) {
+            if (topic != NULL) {
+                *topic = mtopic;
+            }
+            return XF_OK;
+        }
+    }
+
+    return XF_ERR_NOT_FOUND;
+}
+
+static void xf_task_mbus_init(xf_task_mbus_handle_t *bus, xf_task_manager_t manager, bool is_static)
+{
+    xf_list_init(&bus->topic_list);
+#if XF_TASK_MBUS_PATTERN_IS_ENABLE
+    xf_list_init(&bus->pattern_list);
+#endif // XF_TASK_MBUS_PATTERN_IS_ENABLE
+    xf_list_init(&bus->bridge_list);
+    bus->current_topic = NULL;
+    bus->manager = manager;
+    bus->is_static = is_static;
+    xf_memset(bus->slab, 0, sizeof(bus->slab));
+#if XF_TASK_MBUS_RPC_IS_ENABLE
+    xf_list_init(&bus->call_list);
+    bus->corr_seq = 0;
+#endif // XF_TASK_MBUS_RPC_IS_ENABLE
+#if XF_TASK_MBUS_TRACE_IS_ENABLE && XF_TASK_MBUS_TRACE_DUMP_PERIOD
+    bus->last_dump = 0;
+#endif
+}
+
+static xf_err_t xf_task_mbus_topic_add(xf_task_mbus_handle_t *bus, xf_task_mtopic_t *mtopic, uint32_t topic_id,
+                                       uint32_t size, bool is_static)
+{
+    void *buf = (void *)((uint8_t *)mtopic + sizeof(xf_task_mtopic_t));
+
+    xf_list_init(&mtopic->node);
+    mtopic->subs = NULL;
+    mtopic->retire = NULL;
+    mtopic->depth = 0;
+    xf_list_init(&mtopic->bridge_list);
+    xf_task_queue_init(&mtopic->pub_queue, buf, size, DEFAULT_QUEUE_COUNT);
+    mtopic->id = topic_id;
+    mtopic->size = size;
+    mtopic->is_static = is_static;
+#if XF_TASK_MBUS_RPC_IS_ENABLE
+    mtopic->serve_cb = NULL;
+    mtopic->serve_user_data = NULL;
+    mtopic->resp_size = 0;
+#endif // XF_TASK_MBUS_RPC_IS_ENABLE
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+    mtopic->stamp_head = 0;
+    mtopic->dead_hist = NULL;
+    xf_memset(&mtopic->queue_hist, 0, sizeof(xf_task_mhist_t));
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+
+#if XF_TASK_MBUS_PATTERN_IS_ENABLE
+    // 新注册的 topic 需要编译已存在的模式订阅
+    xf_task_mpattern_t *mpattern;
+    xf_list_for_each_entry(mpattern, &bus->pattern_list, xf_task_mpattern_t, node) {
+        if (!xf_task_mbus_pattern_match(mpattern, topic_id)) {
+            continue;
+        }
+        if (xf_task_mbus_match_add(bus, mtopic, mpattern) != XF_OK) {
+            xf_task_mbus_topic_free(bus, mtopic);
+            return XF_ERR_NO_MEM;
+        }
+    }
+#endif // XF_TASK_MBUS_PATTERN_IS_ENABLE
+
+    xf_list_add_tail(&mtopic->node, &bus->topic_list);
+
+    return XF_OK;
+}
+
+static void xf_task_mbus_topic_free(xf_task_mbus_handle_t *bus, xf_task_mtopic_t *mtopic)
+{
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+    for (uint16_t i = 0; mtopic->subs != NULL && i < mtopic->subs->count; i++) {
+        xf_free(mtopic->subs->subs[i].hist);
+    }
+    xf_task_mbus_hist_free(mtopic);
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+    if (mtopic->subs != NULL) {
+        xf_task_mbus_block_free(bus, mtopic->subs);
+    }
+    while (mtopic->retire != NULL) {
+        xf_task_msub_block_t *retire = mtopic->retire;
+        mtopic->retire = retire->next;
+        xf_task_mbus_block_free(bus, retire);
+    }
+    if (!mtopic->is_static) {
+        xf_free(mtopic);
+    }
+}
+
+static xf_task_msub_block_t *xf_task_mbus_block_alloc(xf_task_mbus_handle_t *bus, uint8_t cls)
+{
+    xf_task_msub_block_t *block;
+
+    // 优先从同容量等级的空闲链表中取
+    if (cls < SUB_SLAB_CLASS_NUM && bus->slab[cls] != NULL) {
+        block = bus->slab[cls];
+        bus->slab[cls] = block->next;
+    } else {
+        block = (xf_task_msub_block_t *)xf_malloc(sizeof(xf_task_msub_block_t)
+                + sizeof(xf_task_msub_t) * ((uint32_t)SUB_BLOCK_MIN << cls));
+        if (block == NULL) {
+            XF_LOGE(TAG, "memory alloc failed!");
+            return NULL;
+        }
+    }
+
+    block->next = NULL;
+    block->count = 0;
+    block->exact = 0;
+    block->cls = cls;
+
+    return block;
+}
+
+static void xf_task_mbus_block_free(xf_task_mbus_handle_t *bus, xf_task_msub_block_t *block)
+{
+    if (block->cls >= SUB_SLAB_CLASS_NUM) {
+        xf_free(block);
+        return;
+    }
+
+    block->next = bus->slab[block->cls];
+    bus->slab[block->cls] = block;
+}
+
+/**
+ * 取得可写的订阅数组，count 为修改后的订阅数。
+ * 返回原数组时由调用者原地修改；返回新数组时已复制除 skip 以外的全部订阅。
+ */
+static xf_task_msub_block_t *xf_task_mbus_subs_writable(xf_task_mbus_handle_t *bus, xf_task_mtopic_t *mtopic,
+        uint32_t count, uint32_t skip)
+{
+    xf_task_msub_block_t *old = mtopic->subs;
+    uint8_t cls = 0;
+
+    while (((uint32_t)SUB_BLOCK_MIN << cls) < count) {
+        cls++;
+    }
+
+    // 没有在分发，并且容量合适（不小于需求，也没有大到可以缩两级）时原地修改
+    if (old != NULL && mtopic->depth == 0 && old->cls >= cls && old->cls <= cls + 1) {
+        return old;
+    }
+
+    xf_task_msub_block_t *block = xf_task_mbus_block_alloc(bus, cls);
+    if (block == NULL) {
+        return NULL;
+    }
+
+    if (old != NULL) {
+        for (uint16_t i = 0; i < old->count; i++) {
+            if (i != skip) {
+                block->subs[block->count++] = old->subs[i];
+            }
+        }
+        block->exact = (skip < old->exact) ? old->exact - 1 : old->exact;
+    }
+
+    return block;
+}
+
+static void xf_task_mbus_subs_commit(xf_task_mbus_handle_t *bus, xf_task_mtopic_t *mtopic,
+                                     xf_task_msub_block_t *block)
+{
+    xf_task_msub_block_t *old = mtopic->subs;
+
+    if (block != NULL && block->count == 0) {
+        if (block != old) {
+            xf_task_mbus_block_free(bus, block);
+        }
+        block = NULL;
+    }
+
+    if (old != NULL && old != block) {
+        // 正在分发的数组不能立即回收
+        if (mtopic->depth != 0) {
+            old->next = mtopic->retire;
+            mtopic->retire = old;
+        } else {
+            xf_task_mbus_block_free(bus, old);
+        }
+    }
+
+    mtopic->subs = block;
+}
+
+static xf_err_t xf_task_mbus_subs_insert(xf_task_mbus_handle_t *bus, xf_task_mtopic_t *mtopic, uint16_t index,
+        const xf_task_msub_t *msub)
+{
+    uint32_t count = (mtopic->subs == NULL) ? 1 : (uint32_t)mtopic->subs->count + 1;
+
+    if (count > ((uint32_t)SUB_BLOCK_MIN << SUB_CLASS_MAX)) {
+        XF_LOGE(TAG, "topic:%d has too many subscribers", (int)mtopic->id);
+        return XF_ERR_NO_MEM;
+    }
+
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+    xf_task_mhist_t *hist = (xf_task_mhist_t *)xf_malloc(sizeof(xf_task_mhist_t));
+    if (hist == NULL) {
+        XF_LOGE(TAG, "memory alloc failed!");
+        return XF_ERR_NO_MEM;
+    }
+    xf_memset(hist, 0, sizeof(xf_task_mhist_t));
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+
+    xf_task_msub_block_t *block = xf_task_mbus_subs_writable(bus, mtopic, count, UINT32_MAX);
+    if (block == NULL) {
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+        xf_free(hist);
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+        return XF_ERR_NO_MEM;
+    }
+
+    // 后续元素后移，保持订阅顺序
+    for (uint16_t i = block->count; i > index; i--) {
+        block->subs[i] = block->subs[i - 1];
+    }
+    block->subs[index] = *msub;
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+    block->subs[index].hist = hist;
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+    block->count++;
+#if XF_TASK_MBUS_PATTERN_IS_ENABLE
+    if (msub->owner == NULL) {
+        block->exact++;
+    }
+#else
+    block->exact++;
+#endif // XF_TASK_MBUS_PATTERN_IS_ENABLE
+
+    xf_task_mbus_subs_commit(bus, mtopic, block);
+
+    return XF_OK;
+}
+
+static void xf_task_mbus_subs_remove(xf_task_mbus_handle_t *bus, xf_task_mtopic_t *mtopic, uint16_t index)
+{
+    xf_task_msub_block_t *old = mtopic->subs;
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+    xf_task_mhist_t *hist = old->subs[index].hist;
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+    xf_task_msub_block_t *block = xf_task_mbus_subs_writable(bus, mtopic, old->count - 1U, index);
+
+    if (block == NULL) {
+        // 缩容失败时不缩容，原地删除；分发期间无法原地修改
+        if (mtopic->depth != 0) {
+            XF_LOGE(TAG, "topic:%d unsub failed", (int)mtopic->id);
+            return;
+        }
+        block = old;
+    }
+
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+    // 正在分发的旧数组仍会写入直方图，分发结束后再释放
+    hist->next = mtopic->dead_hist;
+    mtopic->dead_hist = hist;
+    if (mtopic->depth == 0) {
+        xf_task_mbus_hist_free(mtopic);
+    }
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+
+    if (block == old) {
+        if (index < block->exact) {
+            block->exact--;
+        }
+        // 后续元素前移，压缩数组
+        block->count--;
+        for (uint16_t i = index; i < block->count; i++) {
+            block->subs[i] = block->subs[i + 1];
+        }
+    }
+
+    xf_task_mbus_subs_commit(bus, mtopic, block);
+}
+
+static xf_task_mbridge_t *xf_task_mbus_bridge_find(xf_task_mbus_handle_t *src, xf_task_mbus_handle_t *dst,
+        uint32_t topic_id)
+{
+    xf_task_mbridge_t *bridge;
+    xf_list_for_each_entry(bridge, &dst->bridge_list, xf_task_mbridge_t, dst_node) {
+        if (bridge->src == src && bridge->dst_topic->id == topic_id) {
+            return bridge;
+        }
+    }
+
+    return NULL;
+}
+
+static void xf_task_mbus_bridge_push(xf_task_mbridge_t *bridge, const void *data)
+{
+    uint32_t tail = bridge->tail;
+    uint32_t head = XF_TASK_ATOMIC_LOAD(&bridge->head);
+
+    if (tail - head > bridge->mask) {
+        // 只有生产者会写 dropped，读改写不需要 CAS，原子存储保证读取方看到完整的值
+        XF_TASK_ATOMIC_STORE(&bridge->dropped, XF_TASK_ATOMIC_LOAD(&bridge->dropped) + 1);
+        return;
+    }
+
+    xf_memcpy(bridge->buf + (tail & bridge->mask) * bridge->src_topic->size, data, bridge->src_topic->size);
+    // 数据写完后再发布 tail，消费者看到 tail 时数据一定可见
+    XF_TASK_ATOMIC_STORE(&bridge->tail, tail + 1);
+}
+
+static void xf_task_mbus_bridge_drain(xf_task_mbridge_t *bridge)
+{
+    uint32_t head = bridge->head;
+    uint32_t tail = XF_TASK_ATOMIC_LOAD(&bridge->tail);
+
+    while (head != tail) {
+        void *data = bridge->buf + (head & bridge->mask) * bridge->dst_topic->size;
+        // 桥接进来的消息不再转发，避免双向桥接时消息循环
+        xf_task_mbus_run(bridge->dst, bridge->dst_topic, data, false);
+        head++;
+        // 回调结束后才释放槽位，生产者才能覆盖
+        XF_TASK_ATOMIC_STORE(&bridge->head, head);
+    }
+}
+
+#if XF_TASK_MBUS_PATTERN_IS_ENABLE
+
+static xf_err_t xf_task_mbus_sub_pattern(xf_task_mbus_handle_t *bus, uint32_t first, uint32_t last, uint32_t mask,
+        uint32_t value, xf_task_mbus_func_t mbus_cb, void *user_data)
+{
+    xf_task_mpattern_t *mpattern;
+    xf_task_mtopic_t *mtopic;
+
+    xf_list_for_each_entry(mpattern, &bus->pattern_list, xf_task_mpattern_t, node) {
+        if (mpattern->first == first && mpattern->last == last && mpattern->mask == mask
+                && mpattern->value == value && mpattern->mbus_cb == mbus_cb) {
+            XF_LOGD(TAG, "pattern is exists!");
+            return XF_ERR_INITED;
+        }
+    }
+
+    mpattern = (xf_task_mpattern_t *)xf_malloc(sizeof(xf_task_mpattern_t));
+    if (mpattern == NULL) {
+        XF_LOGE(TAG, "memory alloc failed!");
+        return XF_ERR_NO_MEM;
+    }
+
+    xf_list_init(&mpattern->node);
+    mpattern->first = first;
+    mpattern->last = last;
+    mpattern->mask = mask;
+    mpattern->value = value;
+    mpattern->mbus_cb = mbus_cb;
+    mpattern->user_data = user_data;
+
+    // 编译匹配索引：只在订阅时遍历一次 topic，发布时不再匹配
+    xf_list_for_each_entry(mtopic, &bus->topic_list, xf_task_mtopic_t, node) {
+        if (!xf_task_mbus_pattern_match(mpattern, mtopic->id)) {
+            continue;
+        }
+        if (xf_task_mbus_match_add(bus, mtopic, mpattern) != XF_OK) {
+            // 回滚已经编译进订阅数组的部分
+            xf_list_for_each_entry(mtopic, &bus->topic_list, xf_task_mtopic_t, node) {
+                xf_task_mbus_match_remove(bus, mtopic, mpattern);
+            }
+            xf_free(mpattern);
+            return XF_ERR_NO_MEM;
+        }
+    }
+
+    xf_list_add_tail(&mpattern->node, &bus->pattern_list);
+
+    return XF_OK;
+}
+
+static xf_err_t xf_task_mbus_unsub_pattern(xf_task_mbus_handle_t *bus, uint32_t first, uint32_t last, uint32_t mask,
+        uint32_t value, xf_task_mbus_func_t mbus_cb)
+{
+    xf_task_mpattern_t *mpattern, *_mpattern;
+    xf_task_mtopic_t *mtopic;
+
+    xf_list_for_each_entry_safe(mpattern, _mpattern, &bus->pattern_list, xf_task_mpattern_t, node) {
+        if (mpattern->first != first || mpattern->last != last || mpattern->mask != mask
+                || mpattern->value != value || mpattern->mbus_cb != mbus_cb) {
+            continue;
+        }
+        xf_list_for_each_entry(mtopic, &bus->topic_list, xf_task_mtopic_t, node) {
+            if (xf_task_mbus_pattern_match(mpattern, mtopic->id)) {
+                xf_task_mbus_match_remove(bus, mtopic, mpattern);
+            }
+        }
+        xf_list_del_init(&mpattern->node);
+        xf_free(mpattern);
+        return XF_OK;
+    }
+
+    XF_LOGE(TAG, "pattern not found!");
+
+    return XF_ERR_NOT_FOUND;
+}
+
+static bool xf_task_mbus_pattern_match(const xf_task_mpattern_t *mpattern, uint32_t topic_id)
+{
+    return (topic_id >= mpattern->first) && (topic_id <= mpattern->last)
+           && ((topic_id & mpattern->mask) == mpattern->value);
+}
+
+static xf_err_t xf_task_mbus_match_add(xf_task_mbus_handle_t *bus, xf_task_mtopic_t *mtopic,
+                                       xf_task_mpattern_t *mpattern)
+{
+    xf_task_msub_t msub = {
+        .mbus_cb = mpattern->mbus_cb,
+        .user_data = mpattern->user_data,
+        .owner = mpattern,
+    };
+
+    // 模式订阅追加在订阅数组末尾
+    return xf_task_mbus_subs_insert(bus, mtopic, (mtopic->subs == NULL) ? 0 : mtopic->subs->count, &msub);
+}
+
+static void xf_task_mbus_match_remove(xf_task_mbus_handle_t *bus, xf_task_mtopic_t *mtopic,
+                                      xf_task_mpattern_t *mpattern)
+{
+    xf_task_msub_block_t *block = mtopic->subs;
+
+    for (uint16_t i = (block == NULL) ? 0 : block->exact; block != NULL && i < block->count; i++) {
+        if (block->subs[i].owner == mpattern) {
+            xf_task_mbus_subs_remove(bus, mtopic, i);
+            return;
+        }
+    }
+}
+
+#endif // XF_TASK_MBUS_PATTERN_IS_ENABLE
+
+#if XF_TASK_MBUS_RPC_IS_ENABLE
+
+static xf_task_mbus_call_t *xf_task_mbus_call_find(xf_task_mbus_handle_t *bus, uint32_t corr_id)
+{
+    xf_task_mbus_call_t *call;
+    xf_list_for_each_entry(call, &bus->call_list, xf_task_mbus_call_t, node) {
+        if (call->corr_id == corr_id) {
+            return call;
+        }
+    }
+
+    return NULL;
+}
+
+static void xf_task_mbus_call_finish(xf_task_mbus_call_t *call, xf_err_t err)
+{
+    if (!call->pending) {
+        return;
+    }
+
+    xf_list_del_init(&call->node);
+    call->pending = false;
+    call->err = err;
+}
+
+#endif // XF_TASK_MBUS_RPC_IS_ENABLE
+
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+
+static void xf_task_mbus_hist_record(xf_task_mhist_t *hist, xf_task_time_t value)
+{
+    uint32_t index;
+
+    if (hist->count == 0 || value < hist->min) {
+        hist->min = value;
+    }
+    if (value > hist->max) {
+        hist->max = value;
+    }
+    hist->count++;
+
+    if (value < HIST_SUB_COUNT) {
+        index = (uint32_t)value;
+    } else {
+        // msb 为最高位的位置，取其后 HIST_SUB_BITS 位作为桶内偏移
+        uint32_t msb = HIST_SUB_BITS;
+        while (msb < XF_TASK_MBUS_TRACE_HIST_BITS && (value >> (msb + 1)) != 0) {
+            msb++;
+        }
+        if (msb >= XF_TASK_MBUS_TRACE_HIST_BITS) {
+            index = HIST_BUCKET_NUM - 1;
+        } else {
+            index = (msb - HIST_SUB_BITS + 1) * HIST_SUB_COUNT
+                    + (uint32_t)((value >> (msb - HIST_SUB_BITS)) & (HIST_SUB_COUNT - 1));
+        }
+    }
+
+    hist->bucket[index]++;
+}
+
+static void xf_task_mbus_hist_stat(const xf_task_mhist_t *hist, xf_task_mbus_stat_t *stat)
+{
+    const uint32_t permille[3] = {500, 900, 990};
+    xf_task_time_t *value[3] = {&stat->p50, &stat->p90, &stat->p99};
+    uint32_t seen = 0;
+    uint8_t n = 0;
+
+    stat->count = hist->count;
+    stat->min = hist->min;
+    stat->max = hist->max;
+    stat->p50 = stat->p90 = stat->p99 = 0;
+
+    for (uint32_t i = 0; i < HIST_BUCKET_NUM && n < 3 && hist->count != 0; i++) {
+        seen += hist->bucket[i];
+        while (n < 3 && (uint64_t)seen * 1000 >= (uint64_t)hist->count * permille[n]) {
+            // 取桶的上界，并限制在 [min, max] 内
+            xf_task_time_t upper;
+            if (i < HIST_SUB_COUNT) {
+                upper = i;
+            } else {
+                uint32_t shift = i / HIST_SUB_COUNT - 1;
+                upper = ((xf_task_time_t)(HIST_SUB_COUNT + i % HIST_SUB_COUNT + 1) << shift) - 1;
+            }
+            upper = (upper > hist->max) ? hist->max : upper;
+            upper = (upper < hist->min) ? hist->min : upper;
+            *value[n++] = upper;
+        }
+    }
+}
+
+static void xf_task_mbus_hist_free(xf_task_mtopic_t *mtopic)
+{
+    while (mtopic->dead_hist != NULL) {
+        xf_task_mhist_t *hist = mtopic->dead_hist;
+        mtopic->dead_hist = hist->next;
+        xf_free(hist);
+    }
+}
+
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+
 #endif // XF_TASK_MBUS_IS_ENABLE
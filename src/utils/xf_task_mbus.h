@@ -19,6 +19,8 @@
 #if XF_TASK_MBUS_IS_ENABLE
 
 #include "xf_utils.h"
+#include "../kernel/xf_task_manager.h"
+#include "../kernel/xf_task_kernel.h"
 
 /**
  * @ingroup group_xf_task_user
@@ -33,6 +35,36 @@ extern "C" {
 
 /* ==================== [Defines] =========================================== */
 
+/**
+ * @brief 静态创建消息总线所需的内存大小，见 xf_task_mbus_create_static_with_manager.
+ */
+#define XF_TASK_MBUS_STORAGE_SIZE (sizeof(xf_task_mbus_handle_t))
+
+/**
+ * @brief 定义静态创建消息总线所需的内存，对齐与对象一致。
+ *
+ * @param name 变量名。
+ */
+#define XF_TASK_MBUS_STORAGE_DEFINE(name) xf_task_mbus_handle_t name
+
+/**
+ * @brief 静态注册 topic 所需的内存大小（含异步发布的缓存），见 xf_task_mbus_reg_topic_static_with_bus.
+ *
+ * @param size topic 传输数据大小。
+ */
+#define XF_TASK_MTOPIC_STORAGE_SIZE(size) (sizeof(xf_task_mtopic_t) + XF_TASK_MBUS_QUEUE_COUNT * (size))
+
+/**
+ * @brief 定义静态注册 topic 所需的内存（含异步发布的缓存），对齐与对象一致。
+ *
+ * 例如 `static XF_TASK_MTOPIC_STORAGE_DEFINE(s_topic_temp, sizeof(int));` ，之后传入 `&s_topic_temp` 注册。
+ *
+ * @param name 变量名。
+ * @param size topic 传输数据大小。
+ */
+#define XF_TASK_MTOPIC_STORAGE_DEFINE(name, size) \
+    union { xf_task_mtopic_t topic; uint8_t bytes[XF_TASK_MTOPIC_STORAGE_SIZE(size)]; } name
+
 /* ==================== [Typedefs] ========================================== */
 
 /**
@@ -43,8 +75,319 @@ extern "C" {
  */
 typedef void (*xf_task_mbus_func_t)(const void *const data, void *user_data);
 
+/**
+ * @brief 消息总线句柄。
+ *
+ * 每个总线拥有独立的 topic 和订阅者，绑定在一个任务管理器上，
+ * 只应在该管理器所在的线程中使用。跨总线通信通过桥接 @ref xf_task_mbus_bridge 实现。
+ */
+typedef void *xf_task_mbus_t;
+
+#if XF_TASK_MBUS_RPC_IS_ENABLE
+
+/**
+ * @brief 应答句柄，由服务回调获得。
+ *
+ * 可以复制保存下来，在回调返回后（例如其他任务中）再调用 @ref xf_task_mbus_reply 应答。
+ */
+typedef struct _xf_task_mbus_reply_t {
+    xf_task_mbus_t bus;     /*!< 请求所在的总线 */
+    uint32_t corr_id;       /*!< 关联 id，用于把应答直接送回等待的调用者 */
+} xf_task_mbus_reply_t;
+
+/**
+ * @brief mbus 服务回调函数原型。
+ *
+ * @param req 请求数据。
+ * @param reply 应答句柄，回调内或回调返回后通过 @ref xf_task_mbus_reply 应答。
+ * @param user_data 用户自定义参数。
+ */
+typedef void (*xf_task_mbus_serve_func_t)(const void *const req, const xf_task_mbus_reply_t *reply,
+        void *user_data);
+
+/**
+ * @brief 一次请求的等待状态，由调用者提供存储。
+ *
+ * @note 成员仅供内部使用，请通过接口访问。
+ *       使用 @ref xf_ntask_mbus_call 时需要保证其在等待期间有效（如放在静态变量或任务参数中）。
+ */
+typedef struct _xf_task_mbus_call_t {
+    xf_list_t node;         /*!< 挂载在总线的等待链表上 */
+    xf_task_t task;         /*!< 等待应答的任务 */
+    void *resp;             /*!< 应答数据缓存 */
+    uint32_t resp_size;     /*!< 应答数据大小 */
+    uint32_t corr_id;       /*!< 关联 id */
+    xf_task_time_t deadline; /*!< 超时时间点 */
+    xf_err_t err;           /*!< 请求结果 */
+    bool pending;           /*!< 是否仍在等待应答 */
+} xf_task_mbus_call_t;
+
+#endif // XF_TASK_MBUS_RPC_IS_ENABLE
+
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+
+/**
+ * @brief mbus 跟踪统计结果，时间单位与 tick 相同。
+ *
+ * 分位数来自对数线性直方图（每个 2 的幂区间再分 8 份），相对误差不超过 12.5%。
+ */
+typedef struct _xf_task_mbus_stat_t {
+    uint32_t count;         /*!< 样本数 */
+    xf_task_time_t min;     /*!< 最小值 */
+    xf_task_time_t max;     /*!< 最大值 */
+    xf_task_time_t p50;     /*!< 50 分位 */
+    xf_task_time_t p90;     /*!< 90 分位 */
+    xf_task_time_t p99;     /*!< 99 分位 */
+} xf_task_mbus_stat_t;
+
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+
 /* ==================== [Global Prototypes] ================================= */
 
+/**
+ * @brief 创建绑定到指定任务管理器的消息总线。
+ *
+ * @param manager 任务管理器，该总线只应在此管理器所在的线程中使用。
+ * @return xf_task_mbus_t 总线对象，返回 NULL 则表示创建失败
+ */
+xf_task_mbus_t xf_task_mbus_create_with_manager(xf_task_manager_t manager);
+
+/**
+ * @brief 使用用户提供的内存创建绑定到指定任务管理器的消息总线，不申请堆内存。
+ *
+ * @note 总线删除时不释放这块内存。订阅、模式订阅与桥接仍然使用堆内存。
+ *
+ * @param manager 任务管理器，该总线只应在此管理器所在的线程中使用。
+ * @param storage 总线内存，至少 XF_TASK_MBUS_STORAGE_SIZE 字节，通常由 XF_TASK_MBUS_STORAGE_DEFINE 定义。
+ * @return xf_task_mbus_t 总线对象，返回 NULL 则表示参数错误
+ */
+xf_task_mbus_t xf_task_mbus_create_static_with_manager(xf_task_manager_t manager, void *storage);
+
+/**
+ * @brief 删除消息总线，同时注销其上所有的 topic 与订阅。
+ *
+ * @note 默认总线不能删除；存在桥接时需要先解除桥接。
+ *
+ * @param bus 总线对象。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_BUSY 仍存在桥接
+ *      - XF_OK 删除成功
+ */
+xf_err_t xf_task_mbus_delete(xf_task_mbus_t bus);
+
+/**
+ * @brief 获取默认消息总线。不带 `_with_bus` 后缀的接口均作用于默认总线。
+ *
+ * @return xf_task_mbus_t 默认总线对象
+ */
+xf_task_mbus_t xf_task_mbus_get_default(void);
+
+/**
+ * @brief 获取总线所绑定的任务管理器。
+ *
+ * @param bus 总线对象。
+ * @return xf_task_manager_t 任务管理器对象，默认总线返回默认任务管理器
+ */
+xf_task_manager_t xf_task_mbus_get_manager(xf_task_mbus_t bus);
+
+/**
+ * @brief 在指定总线上注册 topic，见 @ref xf_task_mbus_reg_topic.
+ */
+xf_err_t xf_task_mbus_reg_topic_with_bus(xf_task_mbus_t bus, uint32_t topic_id, uint32_t size);
+
+/**
+ * @brief 在指定总线上使用用户提供的内存注册 topic，见 @ref xf_task_mbus_reg_topic_static.
+ */
+xf_err_t xf_task_mbus_reg_topic_static_with_bus(xf_task_mbus_t bus, uint32_t topic_id, uint32_t size, void *storage);
+
+/**
+ * @brief 在指定总线上注销 topic，见 @ref xf_task_mbus_unreg_topic.
+ *
+ * @note topic 上存在桥接时返回 XF_ERR_BUSY。
+ */
+xf_err_t xf_task_mbus_unreg_topic_with_bus(xf_task_mbus_t bus, uint32_t topic_id);
+
+/**
+ * @brief 在指定总线上异步发布，见 @ref xf_task_mbus_pub_async.
+ */
+xf_err_t xf_task_mbus_pub_async_with_bus(xf_task_mbus_t bus, uint32_t topic_id, void *data);
+
+/**
+ * @brief 在指定总线上同步发布，见 @ref xf_task_mbus_pub_sync.
+ */
+xf_err_t xf_task_mbus_pub_sync_with_bus(xf_task_mbus_t bus, uint32_t topic_id, void *data);
+
+/**
+ * @brief 在指定总线上订阅 topic，见 @ref xf_task_mbus_sub.
+ */
+xf_err_t xf_task_mbus_sub_with_bus(xf_task_mbus_t bus, uint32_t topic_id, xf_task_mbus_func_t mbus_cb,
+                                   void *user_data);
+
+/**
+ * @brief 在指定总线上解除订阅，见 @ref xf_task_mbus_unsub.
+ */
+xf_err_t xf_task_mbus_unsub_with_bus(xf_task_mbus_t bus, uint32_t topic_id, xf_task_mbus_func_t mbus_cb);
+
+/**
+ * @brief 在指定总线上解除 topic 下所有订阅，见 @ref xf_task_mbus_unsub_all.
+ */
+xf_err_t xf_task_mbus_unsub_all_with_bus(xf_task_mbus_t bus, uint32_t topic_id);
+
+#if XF_TASK_MBUS_PATTERN_IS_ENABLE
+
+/**
+ * @brief 在指定总线上范围订阅，见 @ref xf_task_mbus_sub_range.
+ */
+xf_err_t xf_task_mbus_sub_range_with_bus(xf_task_mbus_t bus, uint32_t first_id, uint32_t last_id,
+        xf_task_mbus_func_t mbus_cb, void *user_data);
+
+/**
+ * @brief 在指定总线上解除范围订阅，见 @ref xf_task_mbus_unsub_range.
+ */
+xf_err_t xf_task_mbus_unsub_range_with_bus(xf_task_mbus_t bus, uint32_t first_id, uint32_t last_id,
+        xf_task_mbus_func_t mbus_cb);
+
+/**
+ * @brief 在指定总线上掩码订阅，见 @ref xf_task_mbus_sub_mask.
+ */
+xf_err_t xf_task_mbus_sub_mask_with_bus(xf_task_mbus_t bus, uint32_t topic_id, uint32_t mask,
+                                        xf_task_mbus_func_t mbus_cb, void *user_data);
+
+/**
+ * @brief 在指定总线上解除掩码订阅，见 @ref xf_task_mbus_unsub_mask.
+ */
+xf_err_t xf_task_mbus_unsub_mask_with_bus(xf_task_mbus_t bus, uint32_t topic_id, uint32_t mask,
+        xf_task_mbus_func_t mbus_cb);
+
+#endif // XF_TASK_MBUS_PATTERN_IS_ENABLE
+
+/**
+ * @brief 获取指定总线当前正在分发的 topic id，见 @ref xf_task_mbus_get_current_topic.
+ */
+xf_err_t xf_task_mbus_get_current_topic_with_bus(xf_task_mbus_t bus, uint32_t *topic_id);
+
+/**
+ * @brief 处理指定总线上异步的消息以及桥接进来的消息，见 @ref xf_task_mbus_handle.
+ */
+void xf_task_mbus_handle_with_bus(xf_task_mbus_t bus);
+
+/**
+ * @brief 将 src 总线上的 topic 桥接到 dst 总线上的同名 topic。
+ *
+ * src 上发布的消息（同步或异步）在分发给本地订阅者后，会被复制进一个单生产者单消费者的无锁队列；
+ * dst 总线在 @ref xf_task_mbus_handle_with_bus 中取出并分发给 dst 上的订阅者。
+ * 因此 src 与 dst 可以运行在不同的线程（核）上，只有被桥接的 topic 会跨越总线。
+ *
+ * @attention 桥接的创建与解除不是线程安全的，需要在两个总线运行前或停止后进行。
+ *
+ * @param src 源总线。
+ * @param dst 目的总线。
+ * @param topic_id 需要桥接的 topic id，两个总线上都需要已注册且数据大小一致。
+ * @param depth 无锁队列深度，向上取整为 2 的幂。队列满时新消息会被丢弃。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_NOT_FOUND topic 不存在
+ *      - XF_ERR_INITED 桥接已存在
+ *      - XF_ERR_NO_MEM 内存不足
+ *      - XF_OK 桥接成功
+ */
+xf_err_t xf_task_mbus_bridge(xf_task_mbus_t src, xf_task_mbus_t dst, uint32_t topic_id, uint32_t depth);
+
+/**
+ * @brief 解除桥接。
+ *
+ * @attention 同 @ref xf_task_mbus_bridge，需要在两个总线运行前或停止后进行。
+ *
+ * @param src 源总线。
+ * @param dst 目的总线。
+ * @param topic_id 桥接的 topic id。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_NOT_FOUND 桥接不存在
+ *      - XF_OK 解除成功
+ */
+xf_err_t xf_task_mbus_unbridge(xf_task_mbus_t src, xf_task_mbus_t dst, uint32_t topic_id);
+
+/**
+ * @brief 获取桥接因队列满而丢弃的消息数。
+ *
+ * @param src 源总线。
+ * @param dst 目的总线。
+ * @param topic_id 桥接的 topic id。
+ * @return uint32_t 丢弃的消息数，桥接不存在返回 0
+ */
+uint32_t xf_task_mbus_bridge_get_dropped(xf_task_mbus_t src, xf_task_mbus_t dst, uint32_t topic_id);
+
+#if XF_TASK_MBUS_RPC_IS_ENABLE
+
+/**
+ * @brief 在指定总线上提供服务，见 @ref xf_task_mbus_serve.
+ */
+xf_err_t xf_task_mbus_serve_with_bus(xf_task_mbus_t bus, uint32_t topic_id, uint32_t resp_size,
+                                     xf_task_mbus_serve_func_t serve_cb, void *user_data);
+
+/**
+ * @brief 取消指定总线上的服务，见 @ref xf_task_mbus_unserve.
+ */
+xf_err_t xf_task_mbus_unserve_with_bus(xf_task_mbus_t bus, uint32_t topic_id);
+
+/**
+ * @brief 向指定总线上的服务发起请求，见 @ref xf_task_mbus_call.
+ */
+xf_err_t xf_task_mbus_call_with_bus(xf_task_mbus_t bus, uint32_t topic_id, void *req, void *resp,
+                                    uint32_t timeout);
+
+/**
+ * @brief 发起请求但不等待，应答到来时触发 task。
+ *
+ * 用于无栈协程等无法阻塞的场景，一般通过 @ref xf_ntask_mbus_call 使用。
+ * 之后通过 @ref xf_task_mbus_call_is_pending 查询是否结束，通过 @ref xf_task_mbus_call_get_err 获取结果。
+ *
+ * @param bus 总线。
+ * @param call 等待状态，需要在应答或超时前保持有效。
+ * @param task 应答到来或超时后需要触发的任务，可以为 NULL。
+ * @param topic_id 服务所在的 topic id。
+ * @param req 请求数据，大小与 topic 一致。
+ * @param resp 应答数据缓存，大小与服务的应答大小一致。
+ * @param timeout 超时时间，单位为毫秒。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_NOT_FOUND topic 不存在或没有服务
+ *      - XF_OK 请求已发出（可能已经应答）
+ */
+xf_err_t xf_task_mbus_call_start_with_bus(xf_task_mbus_t bus, xf_task_mbus_call_t *call, xf_task_t task,
+        uint32_t topic_id, void *req, void *resp, uint32_t timeout);
+
+#endif // XF_TASK_MBUS_RPC_IS_ENABLE
+
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+
+/**
+ * @brief 获取指定总线上 topic 的队列等待时间统计，见 @ref xf_task_mbus_trace_queue.
+ */
+xf_err_t xf_task_mbus_trace_queue_with_bus(xf_task_mbus_t bus, uint32_t topic_id, xf_task_mbus_stat_t *stat);
+
+/**
+ * @brief 获取指定总线上订阅回调的耗时统计，见 @ref xf_task_mbus_trace_sub.
+ */
+xf_err_t xf_task_mbus_trace_sub_with_bus(xf_task_mbus_t bus, uint32_t topic_id, xf_task_mbus_func_t mbus_cb,
+        xf_task_mbus_stat_t *stat);
+
+/**
+ * @brief 清空指定总线上 topic 的跟踪数据，见 @ref xf_task_mbus_trace_reset.
+ */
+xf_err_t xf_task_mbus_trace_reset_with_bus(xf_task_mbus_t bus, uint32_t topic_id);
+
+/**
+ * @brief 输出指定总线上所有 topic 的跟踪统计，见 @ref xf_task_mbus_trace_dump.
+ */
+void xf_task_mbus_trace_dump_with_bus(xf_task_mbus_t bus);
+
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+
+/* 以下接口作用于默认总线 */
+
 /**
  * @brief 注册 topic。
  *
@@ -56,6 +399,20 @@ typedef void (*xf_task_mbus_func_t)(const void *const data, void *user_data);
  */
 xf_err_t xf_task_mbus_reg_topic(uint32_t topic_id, uint32_t size);
 
+/**
+ * @brief 使用用户提供的内存注册 topic ，不申请堆内存，注销时不释放这块内存。
+ *
+ * @param topic_id 需要注册的 topic id。
+ * @param size topic 传输数据大小。
+ * @param storage topic 内存，至少 XF_TASK_MTOPIC_STORAGE_SIZE(size) 字节，通常由 XF_TASK_MTOPIC_STORAGE_DEFINE 定义。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_INITED topic 已经被初始化
+ *      - XF_ERR_NO_MEM 已有的模式订阅无法加入
+ *      - XF_OK topic 注册成功
+ */
+xf_err_t xf_task_mbus_reg_topic_static(uint32_t topic_id, uint32_t size, void *storage);
+
 /**
  * @brief 注销 topic
  *
@@ -106,6 +463,9 @@ xf_err_t xf_task_mbus_sub(uint32_t topic_id, xf_task_mbus_func_t mbus_cb, void *
 /**
  * @brief 解除订阅。
  *
+ * @note 可以在订阅回调中解除订阅。正在进行的这次分发仍按解除前的订阅列表执行，
+ *       下一次发布开始生效。
+ *
  * @param topic_id 解除订阅的 topic id。
  * @param mbus_cb  解除的回调。
  * @return xf_err_t
@@ -116,7 +476,7 @@ xf_err_t xf_task_mbus_sub(uint32_t topic_id, xf_task_mbus_func_t mbus_cb, void *
 xf_err_t xf_task_mbus_unsub(uint32_t topic_id, xf_task_mbus_func_t mbus_cb);
 
 /**
- * @brief 解除 topic下所有订阅。
+ * @brief 解除 topic下所有订阅。模式订阅不受影响。
  *
  * @param topic_id 解除订阅的 topic id。
  * @return xf_err_t
@@ -125,15 +485,260 @@ xf_err_t xf_task_mbus_unsub(uint32_t topic_id, xf_task_mbus_func_t mbus_cb);
  */
 xf_err_t xf_task_mbus_unsub_all(uint32_t topic_id);
 
+#if XF_TASK_MBUS_PATTERN_IS_ENABLE
+
+/**
+ * @brief 范围订阅，订阅 [first_id, last_id] 区间内的所有 topic。
+ *
+ * @note 对之后注册的、落在区间内的 topic 同样生效。
+ *       订阅时会预编译到每个命中 topic 的匹配索引中，发布时只遍历命中的订阅者。
+ *
+ * @param first_id 区间起始 topic id（包含）。
+ * @param last_id 区间结束 topic id（包含）。
+ * @param mbus_cb 收到消息后处理的回调。
+ * @param user_data 用户的数据。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_INITED 相同的范围订阅已存在
+ *      - XF_ERR_NO_MEM 内存不足
+ *      - XF_OK 订阅成功
+ */
+xf_err_t xf_task_mbus_sub_range(uint32_t first_id, uint32_t last_id, xf_task_mbus_func_t mbus_cb, void *user_data);
+
+/**
+ * @brief 解除范围订阅。
+ *
+ * @param first_id 区间起始 topic id（包含）。
+ * @param last_id 区间结束 topic id（包含）。
+ * @param mbus_cb 解除的回调。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_NOT_FOUND 订阅不存在
+ *      - XF_OK 解除订阅成功
+ */
+xf_err_t xf_task_mbus_unsub_range(uint32_t first_id, uint32_t last_id, xf_task_mbus_func_t mbus_cb);
+
+/**
+ * @brief 掩码订阅，订阅所有满足 `(id & mask) == (topic_id & mask)` 的 topic。
+ *
+ * @note 层级（前缀）订阅可以用高位掩码表示，
+ *       如订阅 0x1200 ~ 0x12FF：`xf_task_mbus_sub_mask(0x1200, 0xFFFFFF00, cb, NULL)`。
+ *
+ * @param topic_id 匹配的 topic id。
+ * @param mask 参与匹配的位。
+ * @param mbus_cb 收到消息后处理的回调。
+ * @param user_data 用户的数据。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_INITED 相同的掩码订阅已存在
+ *      - XF_ERR_NO_MEM 内存不足
+ *      - XF_OK 订阅成功
+ */
+xf_err_t xf_task_mbus_sub_mask(uint32_t topic_id, uint32_t mask, xf_task_mbus_func_t mbus_cb, void *user_data);
+
+/**
+ * @brief 解除掩码订阅。
+ *
+ * @param topic_id 匹配的 topic id。
+ * @param mask 参与匹配的位。
+ * @param mbus_cb 解除的回调。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_NOT_FOUND 订阅不存在
+ *      - XF_OK 解除订阅成功
+ */
+xf_err_t xf_task_mbus_unsub_mask(uint32_t topic_id, uint32_t mask, xf_task_mbus_func_t mbus_cb);
+
+#endif // XF_TASK_MBUS_PATTERN_IS_ENABLE
+
+/**
+ * @brief 获取当前正在分发的 topic id。
+ *
+ * @note 只能在订阅回调中调用，一般给模式订阅的回调区分消息来源。
+ *
+ * @param[out] topic_id 当前分发的 topic id。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_INVALID_STATE 当前不在订阅回调中
+ *      - XF_OK 获取成功
+ */
+xf_err_t xf_task_mbus_get_current_topic(uint32_t *topic_id);
+
 /**
  * @brief 处理异步的消息。
- * 
+ *
  * @note 给异步订阅使用的，需要循环调用。
  */
 void xf_task_mbus_handle(void);
 
+#if XF_TASK_MBUS_RPC_IS_ENABLE
+
+/**
+ * @brief 在 topic 上提供服务（请求应答）。
+ *
+ * 每个 topic 只能有一个服务。请求数据大小为 topic 的大小，请求只会交给服务回调，不会广播给订阅者。
+ *
+ * @param topic_id 服务所在的 topic id，需要已注册。
+ * @param resp_size 应答数据大小。
+ * @param serve_cb 服务回调。
+ * @param user_data 用户自定义参数。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_NOT_FOUND topic 不存在
+ *      - XF_ERR_INITED topic 上已经有服务
+ *      - XF_OK 成功
+ */
+xf_err_t xf_task_mbus_serve(uint32_t topic_id, uint32_t resp_size, xf_task_mbus_serve_func_t serve_cb,
+                            void *user_data);
+
+/**
+ * @brief 取消 topic 上的服务。尚未应答的请求会在超时后返回。
+ *
+ * @param topic_id 服务所在的 topic id。
+ * @return xf_err_t
+ *      - XF_ERR_NOT_FOUND topic 不存在或没有服务
+ *      - XF_OK 成功
+ */
+xf_err_t xf_task_mbus_unserve(uint32_t topic_id);
+
+/**
+ * @brief 向 topic 上的服务发起请求，并阻塞当前有栈协程直到应答或超时。
+ *
+ * 服务回调在本函数内被同步调用，如果回调内直接应答，则不会阻塞。
+ * 应答按关联 id 直接唤醒等待的任务，不经过订阅分发。
+ *
+ * @attention 只能在有栈协程中调用。无栈协程请使用 @ref xf_ntask_mbus_call 。
+ *
+ * @param topic_id 服务所在的 topic id。
+ * @param req 请求数据，大小与 topic 一致。
+ * @param resp 应答数据缓存，大小与服务的应答大小一致。
+ * @param timeout 超时时间，单位为毫秒。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_NOT_FOUND topic 不存在或没有服务
+ *      - XF_ERR_NOT_SUPPORTED 不是在有栈协程中调用
+ *      - XF_ERR_TIMEOUT 超时
+ *      - XF_OK 收到应答
+ */
+xf_err_t xf_task_mbus_call(uint32_t topic_id, void *req, void *resp, uint32_t timeout);
+
+/**
+ * @brief 应答请求。
+ *
+ * @param reply 服务回调获得的应答句柄。
+ * @param resp 应答数据，大小为服务的应答大小。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_NOT_FOUND 请求已超时或不存在
+ *      - XF_OK 应答成功
+ */
+xf_err_t xf_task_mbus_reply(const xf_task_mbus_reply_t *reply, const void *resp);
+
+/**
+ * @brief 查询请求是否仍在等待应答，已超时的请求会在这里结束。
+ *
+ * @param call 等待状态。
+ * @return true 仍在等待
+ * @return false 已应答或已超时
+ */
+bool xf_task_mbus_call_is_pending(xf_task_mbus_call_t *call);
+
+/**
+ * @brief 获取已结束的请求的结果。
+ *
+ * @param call 等待状态。
+ * @return xf_err_t
+ *      - XF_ERR_BUSY 仍在等待
+ *      - XF_ERR_TIMEOUT 超时
+ *      - XF_OK 收到应答
+ */
+xf_err_t xf_task_mbus_call_get_err(const xf_task_mbus_call_t *call);
+
+#endif // XF_TASK_MBUS_RPC_IS_ENABLE
+
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+
+/**
+ * @brief 获取 topic 的队列等待时间统计。
+ *
+ * 等待时间为异步发布到 @ref xf_task_mbus_handle 开始分发之间的时间，同步发布不计入。
+ *
+ * @param topic_id topic id。
+ * @param[out] stat 统计结果。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_NOT_FOUND topic 不存在
+ *      - XF_OK 获取成功
+ */
+xf_err_t xf_task_mbus_trace_queue(uint32_t topic_id, xf_task_mbus_stat_t *stat);
+
+/**
+ * @brief 获取订阅回调在 topic 上的耗时统计。
+ *
+ * @note 同一个回调既有精确订阅又有模式订阅时，返回精确订阅的统计。
+ *
+ * @param topic_id topic id。
+ * @param mbus_cb 订阅回调。
+ * @param[out] stat 统计结果。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_NOT_FOUND topic 或订阅不存在
+ *      - XF_OK 获取成功
+ */
+xf_err_t xf_task_mbus_trace_sub(uint32_t topic_id, xf_task_mbus_func_t mbus_cb, xf_task_mbus_stat_t *stat);
+
+/**
+ * @brief 清空 topic 的队列等待时间与所有订阅回调耗时统计。
+ *
+ * @param topic_id topic id。
+ * @return xf_err_t
+ *      - XF_ERR_NOT_FOUND topic 不存在
+ *      - XF_OK 清空成功
+ */
+xf_err_t xf_task_mbus_trace_reset(uint32_t topic_id);
+
+/**
+ * @brief 通过日志输出所有 topic 的跟踪统计。
+ *
+ * @note 配置 XF_TASK_MBUS_TRACE_DUMP_PERIOD 后， @ref xf_task_mbus_handle 会按周期自动调用。
+ */
+void xf_task_mbus_trace_dump(void);
+
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+
 /* ==================== [Macros] ============================================ */
 
+#if XF_TASK_MBUS_RPC_IS_ENABLE
+
+/**
+ * @brief 无栈协程中向指定总线上的服务发起请求，等待应答或超时后继续执行。
+ *
+ * @attention 只能放在无栈协程内（XF_NTASK_BEGIN 与 XF_NTASK_END 之间）。
+ *            结果通过 @ref xf_task_mbus_call_get_err 获取。
+ *
+ * @param bus 服务所在的总线，协程需要运行在该总线绑定的任务管理器上。
+ * @param call 等待状态 @ref xf_task_mbus_call_t 的指针，等待期间需要保持有效。
+ * @param topic_id 服务所在的 topic id。
+ * @param req 请求数据。
+ * @param resp 应答数据缓存，等待期间需要保持有效。
+ * @param timeout 超时时间，单位为毫秒。超时在任务被唤醒或 mbus 处理时检查。
+ */
+#define xf_ntask_mbus_call_with_bus(bus, call, topic_id, req, resp, timeout)                    \
+    do                                                                                          \
+    {                                                                                           \
+        xf_task_mbus_call_start_with_bus((bus), (call), __xf_now_task,                          \
+                                         (topic_id), (req), (resp), (timeout));                 \
+        XF_NTASK_WAIT_UNTIL(!xf_task_mbus_call_is_pending(call));                               \
+    } while (0)
+
+/**
+ * @brief 无栈协程中向默认总线上的服务发起请求，见 @ref xf_ntask_mbus_call_with_bus.
+ */
+#define xf_ntask_mbus_call(call, topic_id, req, resp, timeout) \
+    xf_ntask_mbus_call_with_bus(xf_task_mbus_get_default(), call, topic_id, req, resp, timeout)
+
+#endif // XF_TASK_MBUS_RPC_IS_ENABLE
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -0,0 +1,160 @@
+/**
+ * @file xf_task_mbus_internal.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 消息总线与 topic 对象的定义。
+ *        外部只通过 xf_task_mbus_t 与 topic id 访问，这里公开定义是为了静态分配时计算大小。
+ * @version 0.1
+ * @date 2024-09-18
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_TASK_MBUS_INTERNAL_H__
+#define __XF_TASK_MBUS_INTERNAL_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_task_mbus.h"
+
+#if XF_TASK_MBUS_IS_ENABLE
+
+#include "xf_task_queue.h"
+
+/**
+ * @ingroup group_xf_task_internal
+ * @defgroup group_xf_task_internal_mbus mbus
+ * @brief 消息总线与 topic 对象。
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+#define XF_TASK_MBUS_QUEUE_COUNT (2)        /*!< 每个 topic 异步发布的缓存条数 */
+#define XF_TASK_MBUS_SLAB_CLASS_NUM (5)     /*!< 缓存的订阅数组容量等级数，超过的直接释放 */
+
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+#define XF_TASK_MBUS_HIST_SUB_BITS (3)      /*!< 直方图每个 2 的幂区间细分的位数 */
+#define XF_TASK_MBUS_HIST_SUB_COUNT (1 << XF_TASK_MBUS_HIST_SUB_BITS)
+#define XF_TASK_MBUS_HIST_BUCKET_NUM \
+    ((XF_TASK_MBUS_TRACE_HIST_BITS - XF_TASK_MBUS_HIST_SUB_BITS + 1) * XF_TASK_MBUS_HIST_SUB_COUNT)
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+
+/* ==================== [Typedefs] ========================================== */
+
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+/**
+ * 对数线性直方图：小于 XF_TASK_MBUS_HIST_SUB_COUNT 的值一个值一个桶，
+ * 之后每个 2 的幂区间均分为 XF_TASK_MBUS_HIST_SUB_COUNT 个桶。
+ */
+typedef struct _xf_task_mhist_t {
+    struct _xf_task_mhist_t *next; // 等待回收时使用
+    uint32_t count;             // 样本数
+    xf_task_time_t min;         // 最小值
+    xf_task_time_t max;         // 最大值
+    uint32_t bucket[XF_TASK_MBUS_HIST_BUCKET_NUM];
+} xf_task_mhist_t;
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+
+typedef struct _xf_task_xsub_t {
+    xf_task_mbus_func_t mbus_cb; // 订阅回调
+    void *user_data;             // 用户订阅回调参数
+#if XF_TASK_MBUS_PATTERN_IS_ENABLE
+    struct _xf_task_mpattern_t *owner; // 所属的模式订阅，精确订阅为 NULL
+#endif // XF_TASK_MBUS_PATTERN_IS_ENABLE
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+    xf_task_mhist_t *hist;       // 回调耗时直方图
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+} xf_task_msub_t;
+
+/**
+ * 订阅数组。精确订阅排在前面，命中本 topic 的模式订阅排在后面，
+ * 发布时只需要线性扫描一遍。
+ * 分发过程中数组只读，修改时复制一份新的（写时复制），旧数组在分发结束后回收。
+ */
+typedef struct _xf_task_msub_block_t {
+    struct _xf_task_msub_block_t *next; // 在空闲链表或待回收链表中时使用
+    uint16_t count;             // 有效订阅数
+    uint16_t exact;             // 其中精确订阅数
+    uint8_t cls;                // 容量等级，容量为 SUB_BLOCK_MIN << cls
+    xf_task_msub_t subs[];
+} xf_task_msub_block_t;
+
+typedef struct _xf_task_xtopic_t {
+    xf_list_t node;
+    xf_task_msub_block_t *subs; // 订阅数组，无订阅时为 NULL
+    xf_task_msub_block_t *retire; // 分发期间被替换、等待回收的订阅数组
+    uint16_t depth;             // 正在分发本 topic 的层数
+    xf_list_t bridge_list;      // 以本 topic 为源的桥接链表
+    xf_task_queue_t pub_queue;  // 发布链表，有缓存有限用缓存，没缓存则创建
+    uint32_t id;                // topic id
+    uint32_t size;              // topic发布消息大小
+    bool is_static;             // 内存由用户提供，注销时不释放
+#if XF_TASK_MBUS_RPC_IS_ENABLE
+    xf_task_mbus_serve_func_t serve_cb; // 服务回调，没有服务时为 NULL
+    void *serve_user_data;      // 服务回调参数
+    uint32_t resp_size;         // 应答数据大小
+#endif // XF_TASK_MBUS_RPC_IS_ENABLE
+#if XF_TASK_MBUS_TRACE_IS_ENABLE
+    xf_task_time_t stamp[XF_TASK_MBUS_QUEUE_COUNT]; // 与 pub_queue 一一对应的发布时间
+    uint8_t stamp_head;         // 最早一条消息的发布时间下标
+    xf_task_mhist_t *dead_hist; // 分发期间被取消订阅、等待回收的直方图
+    xf_task_mhist_t queue_hist; // 队列等待时间直方图
+#endif // XF_TASK_MBUS_TRACE_IS_ENABLE
+} xf_task_mtopic_t;
+
+#if XF_TASK_MBUS_PATTERN_IS_ENABLE
+/**
+ * 模式订阅。范围订阅与掩码订阅统一表示为：
+ * first <= id <= last && (id & mask) == value
+ */
+typedef struct _xf_task_mpattern_t {
+    xf_list_t node;
+    uint32_t first;              // 范围起点（包含）
+    uint32_t last;               // 范围终点（包含）
+    uint32_t mask;               // 参与匹配的位
+    uint32_t value;              // 匹配值（已与 mask 相与）
+    xf_task_mbus_func_t mbus_cb; // 订阅回调
+    void *user_data;             // 用户订阅回调参数
+} xf_task_mpattern_t;
+#endif // XF_TASK_MBUS_PATTERN_IS_ENABLE
+
+typedef struct _xf_task_mbus_handle_t {
+    xf_list_t topic_list;           // topic 链表
+#if XF_TASK_MBUS_PATTERN_IS_ENABLE
+    xf_list_t pattern_list;         // 模式订阅链表
+#endif // XF_TASK_MBUS_PATTERN_IS_ENABLE
+    xf_list_t bridge_list;          // 以本总线为目的的桥接链表
+    xf_task_mtopic_t *current_topic; // 当前正在分发的 topic
+    xf_task_manager_t manager;      // 绑定的任务管理器，默认总线为 NULL（即默认任务管理器）
+    bool is_static;                 // 内存由用户提供，删除时不释放
+    xf_task_msub_block_t *slab[XF_TASK_MBUS_SLAB_CLASS_NUM]; // 按容量等级缓存的空闲订阅数组
+#if XF_TASK_MBUS_RPC_IS_ENABLE
+    xf_list_t call_list;            // 等待应答的请求链表
+    uint32_t corr_seq;              // 关联 id 序号
+#endif // XF_TASK_MBUS_RPC_IS_ENABLE
+#if XF_TASK_MBUS_TRACE_IS_ENABLE && XF_TASK_MBUS_TRACE_DUMP_PERIOD
+    xf_task_time_t last_dump;       // 上次自动输出跟踪统计的时间
+#endif
+} xf_task_mbus_handle_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of group_xf_task_internal_mbus
+ * @}
+ */
+
+#endif // XF_TASK_MBUS_IS_ENABLE
+
+#endif // __XF_TASK_MBUS_INTERNAL_H__
@@ -0,0 +1,276 @@
+/**
+ * @file xf_task_parallel.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 数据并行（parallel_for / parallel_reduce）。
+ * @version 0.1
+ * @date 2024-08-28
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_task_utils_config.h"
+
+#if XF_TASK_PARALLEL_IS_ENABLE
+
+#include "xf_task_parallel.h"
+#include "../kernel/xf_task_atomic.h"
+#include "../port/xf_task_port_internal.h"
+#include "../task/xf_ctask.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "task_parallel"
+
+#define CHUNKS_PER_WORKER (8)       // 自动划分时每个线程的块数
+#define SLOT_SIZE (64)              // 每个线程的区间独占一个缓存行
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 每个线程待执行的块区间 [lo, hi)，lo 在低 32 位，hi 在高 32 位。
+ *        所有者从 lo 端取块，窃取者从 hi 端取走一半，两端都通过 CAS 修改。
+ */
+typedef union _xf_task_parallel_slot_t {
+    volatile uint64_t range;
+    uint8_t pad[SLOT_SIZE];
+} xf_task_parallel_slot_t;
+
+typedef struct _xf_task_parallel_job_t {
+    uint32_t begin;
+    uint32_t end;
+    uint32_t grain;
+    uint32_t workers;
+    xf_task_parallel_func_t func;
+    xf_task_parallel_reduce_func_t reduce;
+    void *arg;
+    uint8_t *partials;              // 每个线程的部分结果
+    size_t size;
+    xf_task_parallel_slot_t *slots;
+} xf_task_parallel_job_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static xf_err_t xf_task_parallel_exec(xf_task_manager_t manager, xf_task_parallel_job_t *job,
+                                      xf_task_parallel_join_func_t join, void *result);
+static void xf_task_parallel_serial(xf_task_manager_t manager, xf_task_parallel_job_t *job, void *partial,
+                                    bool can_yield);
+static void xf_task_parallel_entry(uint32_t index, void *arg);
+static bool xf_task_parallel_pop(xf_task_parallel_slot_t *slot, uint32_t *chunk);
+static bool xf_task_parallel_steal(xf_task_parallel_job_t *job, uint32_t index);
+static void xf_task_parallel_chunk(xf_task_parallel_job_t *job, uint32_t chunk, void *partial);
+
+/* ==================== [Static Variables] ================================== */
+
+static volatile uint32_t s_parallel_busy = 0;   // 同一时刻只有一组线程并行执行
+
+/* ==================== [Macros] ============================================ */
+
+#define RANGE_MAKE(lo, hi)  ((uint64_t)(lo) | ((uint64_t)(hi) << 32))
+#define RANGE_LO(range)     ((uint32_t)(range))
+#define RANGE_HI(range)     ((uint32_t)((range) >> 32))
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_task_parallel_for_with_manager(xf_task_manager_t manager, uint32_t begin, uint32_t end, uint32_t grain,
+        xf_task_parallel_func_t func, void *arg)
+{
+    XF_ASSERT(manager, XF_ERR_INVALID_ARG, TAG, "manager must not be NULL");
+    XF_ASSERT(func, XF_ERR_INVALID_ARG, TAG, "func must not be NULL");
+    XF_ASSERT(begin <= end, XF_ERR_INVALID_ARG, TAG, "begin must not be greater than end");
+
+    xf_task_parallel_job_t job = {
+        .begin = begin,
+        .end = end,
+        .grain = grain,
+        .func = func,
+        .reduce = NULL,
+        .arg = arg,
+        .partials = NULL,
+        .size = 0,
+    };
+
+    return xf_task_parallel_exec(manager, &job, NULL, NULL);
+}
+
+xf_err_t xf_task_parallel_reduce_with_manager(xf_task_manager_t manager, uint32_t begin, uint32_t end,
+        uint32_t grain, xf_task_parallel_reduce_func_t func, xf_task_parallel_join_func_t join, void *arg,
+        void *result, size_t size)
+{
+    XF_ASSERT(manager, XF_ERR_INVALID_ARG, TAG, "manager must not be NULL");
+    XF_ASSERT(func, XF_ERR_INVALID_ARG, TAG, "func must not be NULL");
+    XF_ASSERT(join, XF_ERR_INVALID_ARG, TAG, "join must not be NULL");
+    XF_ASSERT(result, XF_ERR_INVALID_ARG, TAG, "result must not be NULL");
+    XF_ASSERT(size, XF_ERR_INVALID_ARG, TAG, "size must not be 0");
+    XF_ASSERT(begin <= end, XF_ERR_INVALID_ARG, TAG, "begin must not be greater than end");
+
+    xf_task_parallel_job_t job = {
+        .begin = begin,
+        .end = end,
+        .grain = grain,
+        .func = NULL,
+        .reduce = func,
+        .arg = arg,
+        .partials = NULL,
+        .size = size,
+    };
+
+    return xf_task_parallel_exec(manager, &job, join, result);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static xf_err_t xf_task_parallel_exec(xf_task_manager_t manager, xf_task_parallel_job_t *job,
+                                      xf_task_parallel_join_func_t join, void *result)
+{
+    uint32_t workers = xf_task_parallel_get_workers();
+    uint32_t count = job->end - job->begin;
+
+    if (count == 0) {
+        return XF_OK;
+    }
+
+    if (job->grain == 0) {
+        uint32_t chunks = workers * CHUNKS_PER_WORKER;
+        job->grain = (count - 1) / chunks + 1;
+    }
+
+    uint32_t chunks = (count - 1) / job->grain + 1;
+    workers = (workers > chunks) ? chunks : workers;
+
+    // 块函数中嵌套调用，或者其他任务管理器正在并行执行时，直接在当前线程执行
+    uint32_t idle = 0;
+    if (workers <= 1 || !XF_TASK_ATOMIC_CAS(&s_parallel_busy, &idle, 1)) {
+        bool can_yield = (workers <= 1);
+        xf_task_parallel_serial(manager, job, result, can_yield);
+        return XF_OK;
+    }
+
+    xf_task_parallel_slot_t *slots = (xf_task_parallel_slot_t *)xf_malloc(sizeof(xf_task_parallel_slot_t) * workers
+                                     + job->size * workers);
+    if (slots == NULL) {
+        XF_LOGD(TAG, "memory alloc failed, run in current task");
+        XF_TASK_ATOMIC_STORE(&s_parallel_busy, 0);
+        xf_task_parallel_serial(manager, job, result, false);
+        return XF_OK;
+    }
+
+    job->workers = workers;
+    job->slots = slots;
+    job->partials = (uint8_t *)&slots[workers];
+
+    // 先平均分配，之后由窃取动态调整
+    for (uint32_t i = 0; i < workers; i++) {
+        uint32_t lo = (uint32_t)((uint64_t)chunks * i / workers);
+        uint32_t hi = (uint32_t)((uint64_t)chunks * (i + 1) / workers);
+        slots[i].range = RANGE_MAKE(lo, hi);
+        if (result != NULL) {
+            xf_memcpy(job->partials + job->size * i, result, job->size);
+        }
+    }
+
+    xf_task_parallel_run(xf_task_parallel_entry, job);
+
+    if (result != NULL) {
+        xf_memcpy(result, job->partials, job->size);
+        for (uint32_t i = 1; i < workers; i++) {
+            join(result, job->partials + job->size * i, job->arg);
+        }
+    }
+
+    xf_free(slots);
+    XF_TASK_ATOMIC_STORE(&s_parallel_busy, 0);
+
+    return XF_OK;
+}
+
+static void xf_task_parallel_serial(xf_task_manager_t manager, xf_task_parallel_job_t *job, void *partial,
+                                    bool can_yield)
+{
+#if XF_TASK_CONTEXT_IS_ENABLE
+    xf_task_t current = xf_task_manager_get_current_task(manager);
+    can_yield = can_yield && current != NULL && XF_TASK_TYPE_CTASK == xf_task_get_type(current);
+#else
+    UNUSED(manager);
+    UNUSED(can_yield);
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+
+    uint32_t chunks = (job->end - job->begin - 1) / job->grain + 1;
+
+    for (uint32_t chunk = 0; chunk < chunks; chunk++) {
+        xf_task_parallel_chunk(job, chunk, partial);
+#if XF_TASK_CONTEXT_IS_ENABLE
+        // 每块之间让出一次 CPU
+        if (can_yield && chunk + 1 < chunks) {
+            xf_ctask_delay_with_manager(manager, 0);
+        }
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+    }
+}
+
+static void xf_task_parallel_entry(uint32_t index, void *arg)
+{
+    xf_task_parallel_job_t *job = (xf_task_parallel_job_t *)arg;
+    void *partial = (job->reduce != NULL) ? (job->partials + job->size * index) : NULL;
+    uint32_t chunk;
+
+    while (1) {
+        if (xf_task_parallel_pop(&job->slots[index], &chunk)) {
+            xf_task_parallel_chunk(job, chunk, partial);
+            continue;
+        }
+        // 自己的块做完后去窃取，所有线程都没有剩余块时结束
+        if (!xf_task_parallel_steal(job, index)) {
+            break;
+        }
+    }
+}
+
+static bool xf_task_parallel_pop(xf_task_parallel_slot_t *slot, uint32_t *chunk)
+{
+    uint64_t range = XF_TASK_ATOMIC_LOAD(&slot->range);
+
+    while (RANGE_LO(range) < RANGE_HI(range)) {
+        if (XF_TASK_ATOMIC_CAS(&slot->range, &range, RANGE_MAKE(RANGE_LO(range) + 1, RANGE_HI(range)))) {
+            *chunk = RANGE_LO(range);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool xf_task_parallel_steal(xf_task_parallel_job_t *job, uint32_t index)
+{
+    for (uint32_t i = 1; i < job->workers; i++) {
+        xf_task_parallel_slot_t *victim = &job->slots[(index + i) % job->workers];
+        uint64_t range = XF_TASK_ATOMIC_LOAD(&victim->range);
+
+        while (RANGE_LO(range) < RANGE_HI(range)) {
+            // 取走后一半，只剩一块时整块取走
+            uint32_t mid = RANGE_LO(range) + (RANGE_HI(range) - RANGE_LO(range)) / 2;
+            if (XF_TASK_ATOMIC_CAS(&victim->range, &range, RANGE_MAKE(RANGE_LO(range), mid))) {
+                XF_TASK_ATOMIC_STORE(&job->slots[index].range, RANGE_MAKE(mid, RANGE_HI(range)));
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+static void xf_task_parallel_chunk(xf_task_parallel_job_t *job, uint32_t chunk, void *partial)
+{
+    uint32_t begin = job->begin + chunk * job->grain;
+    uint32_t end = (job->end - begin > job->grain) ? (begin + job->grain) : job->end;
+
+    if (job->reduce != NULL) {
+        job->reduce(begin, end, partial, job->arg);
+    } else {
+        job->func(begin, end, job->arg);
+    }
+}
+
+#endif // XF_TASK_PARALLEL_IS_ENABLE
@@ -0,0 +1,128 @@
+/**
+ * @file xf_task_parallel.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 数据并行（parallel_for / parallel_reduce）。
+ * @version 0.1
+ * @date 2024-08-28
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_TASK_PARALLEL_H__
+#define __XF_TASK_PARALLEL_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_task_utils_config.h"
+
+#if XF_TASK_PARALLEL_IS_ENABLE
+
+#include "../kernel/xf_task_kernel.h"
+
+/**
+ * @ingroup group_xf_task_user
+ * @defgroup group_xf_task_user_parallel parallel
+ * @brief 数据并行。
+ *
+ * 区间 [begin, end) 按 grain 切成若干块执行：
+ *  - 通过 @ref xf_task_parallel_init 对接了多线程时，块在多个线程上执行，
+ *    线程空闲时从其他线程窃取剩余块的一半，块的划分随线程负载自动调整；
+ *  - 没有对接多线程时，在 ctask 中调用会在每块之间让出 CPU，其他任务照常调度；
+ *    在 ntask 中调用则直接依次执行所有块。
+ *
+ * @attention 多线程执行时，块函数运行在其他线程上，不能调用 xf_task 的接口。
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief parallel_for 块函数，处理 [begin, end).
+ *
+ * @param begin 起始下标。
+ * @param end 结束下标（不包括）。
+ * @param arg 用户参数。
+ */
+typedef void (*xf_task_parallel_func_t)(uint32_t begin, uint32_t end, void *arg);
+
+/**
+ * @brief parallel_reduce 块函数，把 [begin, end) 的结果累加到 partial.
+ *
+ * @param begin 起始下标。
+ * @param end 结束下标（不包括）。
+ * @param partial 当前线程的部分结果。
+ * @param arg 用户参数。
+ */
+typedef void (*xf_task_parallel_reduce_func_t)(uint32_t begin, uint32_t end, void *partial, void *arg);
+
+/**
+ * @brief parallel_reduce 合并函数，把 partial 合并到 result.
+ *
+ * @param result 最终结果。
+ * @param partial 某个线程的部分结果。
+ * @param arg 用户参数。
+ */
+typedef void (*xf_task_parallel_join_func_t)(void *result, const void *partial, void *arg);
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 对 [begin, end) 并行执行 func.
+ *
+ * @param manager 任务管理器，协作执行时用于让出 CPU.
+ * @param begin 起始下标。
+ * @param end 结束下标（不包括）。
+ * @param grain 每块的大小，为 0 时按线程数自动划分。
+ * @param func 块函数。
+ * @param arg 用户参数。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_OK 全部执行完成
+ */
+xf_err_t xf_task_parallel_for_with_manager(xf_task_manager_t manager, uint32_t begin, uint32_t end, uint32_t grain,
+        xf_task_parallel_func_t func, void *arg);
+
+/**
+ * @brief 对 [begin, end) 并行归约。
+ *
+ * 调用前 result 中需要存放归约的初始值（如求和时为 0），每个线程以它为起点累加部分结果，
+ * 最后依次用 join 合并到 result.
+ *
+ * @param manager 任务管理器，协作执行时用于让出 CPU.
+ * @param begin 起始下标。
+ * @param end 结束下标（不包括）。
+ * @param grain 每块的大小，为 0 时按线程数自动划分。
+ * @param func 块函数。
+ * @param join 合并函数。
+ * @param arg 用户参数。
+ * @param[in,out] result 输入初始值，输出归约结果。
+ * @param size 结果的字节数。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_OK 全部执行完成
+ */
+xf_err_t xf_task_parallel_reduce_with_manager(xf_task_manager_t manager, uint32_t begin, uint32_t end,
+        uint32_t grain, xf_task_parallel_reduce_func_t func, xf_task_parallel_join_func_t join, void *arg,
+        void *result, size_t size);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of group_xf_task_user_parallel
+ * @}
+ */
+
+#endif // XF_TASK_PARALLEL_IS_ENABLE
+
+#endif // __XF_TASK_PARALLEL_H__
@@ -17,70 +17,200 @@
 
 #include "xf_task_pool.h"
 #include "../kernel/xf_task_base.h"
+#include "../port/xf_task_port_internal.h"
 #include "../task/xf_task_default.h"
 #include "../task/xf_ntask.h"
+#include "../task/xf_ctask.h"
 
 /* ==================== [Defines] =========================================== */
 
 #define TAG "task_pool"
 
+#define JOB_IDLE_MS (60U * 1000U)   // ctask 作业工作任务空闲时的等待周期，有作业时会被提前唤醒
+
 /* ==================== [Typedefs] ========================================== */
 
+typedef struct _xf_task_pool_pending_t {
+    xf_task_func_t func;
+    void *arg;
+    uint16_t priority;
+} xf_task_pool_pending_t;
+
+typedef struct _xf_task_pool_job_t {
+    xf_task_pool_job_func_t func;
+    xf_task_pool_job_func_t done;
+    void *arg;
+} xf_task_pool_job_t;
+
+struct _xf_task_pool_handle_t;
+
+typedef struct _xf_task_pool_job_worker_t {
+    xf_list_t node;
+    xf_task_t task;
+    struct _xf_task_pool_handle_t *pool;
+} xf_task_pool_job_worker_t;
+
 typedef struct _xf_task_pool_handle_t {
-    uint32_t max_works;
-    xf_list_t pool_list;
-    xf_list_t used_list;
+    xf_task_manager_t manager;
+    xf_task_type_t type;
+    union {
+        xf_ntask_config_t ntask;
+#if XF_TASK_CONTEXT_IS_ENABLE
+        xf_ctask_config_t ctask;
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+    } config;                       // 任务配置副本，扩充时使用
+    xf_task_pool_attr_t attr;
+    uint32_t total;                 // 已分配的工作任务数
+    uint32_t used;                  // 正在使用的工作任务数
+    xf_list_t chunk_list;           // 工作任务按批分配
+    xf_list_t pool_list;            // 空闲的工作任务，后进先出
+    xf_list_t used_list;            // 正在使用的工作任务
+    xf_list_t wait_list;            // 阻塞等待工作任务的有栈协程
+    xf_task_t shrink_task;          // 周期回收空闲工作任务的 ntask
+    xf_task_pool_pending_t *pending; // 等待队列
+    uint32_t pending_head;
+    uint32_t pending_count;
+    xf_task_pool_job_t *jobs;       // 作业队列
+    uint32_t job_head;
+    uint32_t job_count;
+    xf_task_pool_job_worker_t *job_workers; // 执行作业的常驻工作任务
+    xf_list_t job_idle_list;        // 空闲的作业工作任务
 } xf_task_pool_handle_t;
 
+typedef struct _xf_task_pool_chunk_t {
+    xf_list_t node;
+    uint32_t count;                 // 本批工作任务数
+    uint32_t used;                  // 本批正在使用的工作任务数
+    xf_task_time_t idle_since;      // 本批全部空闲的开始时间
+    bool resident;                  // 创建时分配的常驻批次，不会回收
+} xf_task_pool_chunk_t;
+
 typedef struct _xf_pool_task_t {
     xf_list_t node;
     xf_task_t task;
     xf_task_pool_handle_t *pool;
+    xf_task_pool_chunk_t *chunk;
 } xf_pool_task_t;
 
+typedef struct _xf_task_pool_waiter_t {
+    xf_list_t node;
+    xf_task_t task;
+} xf_task_pool_waiter_t;
 
 /* ==================== [Static Prototypes] ================================= */
 
 static void xf_task_pool_default_task(xf_task_t task);
+static void xf_task_pool_shrink_task(xf_task_t task);
 static void xf_task_delete_(xf_task_t task);
+static xf_err_t xf_task_pool_grow(xf_task_pool_handle_t *pool, uint32_t count, bool resident);
+static void xf_task_pool_chunk_free(xf_task_pool_handle_t *pool, xf_task_pool_chunk_t *chunk);
+static xf_task_t xf_task_pool_take(xf_task_pool_handle_t *pool, xf_task_func_t func, void *func_arg,
+                                   uint16_t priority);
+static xf_err_t xf_task_pool_job_worker_create(xf_task_pool_handle_t *pool, xf_task_pool_job_worker_t *worker);
+static bool xf_task_pool_job_drain(xf_task_pool_handle_t *pool);
+static void xf_task_pool_job_ntask(xf_task_t task);
+#if XF_TASK_CONTEXT_IS_ENABLE
+static void xf_task_pool_job_ctask(xf_task_t task);
+#endif // XF_TASK_CONTEXT_IS_ENABLE
 
 /* ==================== [Static Variables] ================================== */
 
 /* ==================== [Macros] ============================================ */
 
+#define CHUNK_WORKS(chunk) ((xf_pool_task_t *)((uint8_t *)(chunk) + sizeof(xf_task_pool_chunk_t)))
+
 /* ==================== [Global Functions] ================================== */
 
 xf_task_pool_t xf_task_pool_create_with_manager(uint32_t max_works, xf_task_manager_t manager, xf_task_type_t type,
         void *config)
 {
     XF_ASSERT(max_works, NULL, TAG, "max_works must not be 0");
+
+    xf_task_pool_attr_t attr = {
+        .min_works = max_works,
+        .max_works = max_works,
+        .grow_step = max_works,
+        .idle_shrink_ms = 0,
+        .pending_max = 0,
+        .job_queue_size = 0,
+    };
+
+    return xf_task_pool_create_with_attr(manager, type, config, &attr);
+}
+
+xf_task_pool_t xf_task_pool_create_with_attr(xf_task_manager_t manager, xf_task_type_t type, void *config,
+        const xf_task_pool_attr_t *attr)
+{
     XF_ASSERT(manager, NULL, TAG, "manager must not be NULL");
     XF_ASSERT(type < _XF_TASK_TYPE_MAX, NULL, TAG, "manager must less than %d", _XF_TASK_TYPE_MAX);
     XF_ASSERT(config, NULL, TAG, "config must not be NULL");
+    XF_ASSERT(attr, NULL, TAG, "attr must not be NULL");
+    XF_ASSERT(attr->max_works, NULL, TAG, "max_works must not be 0");
+    XF_ASSERT(attr->min_works <= attr->max_works, NULL, TAG, "min_works must not be greater than max_works");
 
+    uint32_t job_workers = (attr->job_queue_size == 0) ? 0 : ((attr->job_workers == 0) ? 1 : attr->job_workers);
     xf_task_pool_handle_t *pool = (xf_task_pool_handle_t *)xf_malloc(sizeof(xf_task_pool_handle_t) +
-                                  sizeof(xf_pool_task_t) * max_works);
+                                  sizeof(xf_task_pool_pending_t) * attr->pending_max +
+                                  sizeof(xf_task_pool_job_t) * attr->job_queue_size +
+                                  sizeof(xf_task_pool_job_worker_t) * job_workers);
     if (pool == NULL)
     {
         XF_LOGE(TAG, "memory alloc failed!");
         return NULL;
     }
 
-    pool->max_works = max_works;
+    pool->manager = manager;
+    pool->type = type;
+#if XF_TASK_CONTEXT_IS_ENABLE
+    if (type == XF_TASK_TYPE_CTASK) {
+        pool->config.ctask = *(xf_ctask_config_t *)config;
+    } else
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+    {
+        pool->config.ntask = *(xf_ntask_config_t *)config;
+    }
+    pool->attr = *attr;
+    pool->attr.grow_step = (attr->grow_step == 0) ? 1 : attr->grow_step;
+    pool->attr.job_workers = job_workers;
+    pool->total = 0;
+    pool->used = 0;
+    xf_list_init(&pool->chunk_list);
     xf_list_init(&pool->pool_list);
     xf_list_init(&pool->used_list);
+    xf_list_init(&pool->wait_list);
+    pool->shrink_task = NULL;
+    pool->pending = (xf_task_pool_pending_t *)((uint8_t *)pool + sizeof(xf_task_pool_handle_t));
+    pool->pending_head = 0;
+    pool->pending_count = 0;
+    pool->jobs = (xf_task_pool_job_t *)&pool->pending[attr->pending_max];
+    pool->job_head = 0;
+    pool->job_count = 0;
+    pool->job_workers = (xf_task_pool_job_worker_t *)&pool->jobs[attr->job_queue_size];
+    xf_list_init(&pool->job_idle_list);
+    for (uint32_t i = 0; i < job_workers; i++) {
+        pool->job_workers[i].task = NULL;
+    }
 
-    xf_pool_task_t *pool_task = (xf_pool_task_t *)((uint8_t *)pool + sizeof(xf_task_pool_handle_t));
+    if (attr->min_works != 0 && xf_task_pool_grow(pool, attr->min_works, true) != XF_OK) {
+        xf_task_pool_delete(pool);
+        return NULL;
+    }
 
-    for (size_t i = 0; i < max_works; i++) {
-        pool_task[i].task = xf_task_create_with_manager(manager, type, xf_task_pool_default_task, NULL, 0, config);
-        xf_task_base_t *task_base = (xf_task_base_t *)pool_task[i].task;
-        task_base->user_data = &pool_task[i];
-        task_base->delete = xf_task_delete_;
-        pool_task[i].pool = pool;
-        xf_task_suspend(pool_task[i].task);
-        xf_list_init(&pool_task[i].node);
-        xf_list_add_tail(&pool_task[i].node, &pool->pool_list);
+    // 需要回收时，用一个最低优先级的 ntask 周期检查
+    if (attr->idle_shrink_ms != 0 && attr->min_works != attr->max_works) {
+        pool->shrink_task = xf_ntask_create_loop_with_manager(manager, xf_task_pool_shrink_task, pool,
+                            XF_TASK_PRIORITY_LEVELS - 1, attr->idle_shrink_ms);
+        if (pool->shrink_task == NULL) {
+            xf_task_pool_delete(pool);
+            return NULL;
+        }
+    }
+
+    for (uint32_t i = 0; i < job_workers; i++) {
+        if (xf_task_pool_job_worker_create(pool, &pool->job_workers[i]) != XF_OK) {
+            xf_task_pool_delete(pool);
+            return NULL;
+        }
     }
 
     return pool;
@@ -91,17 +221,40 @@ xf_err_t xf_task_pool_delete(xf_task_pool_t pool)
     XF_ASSERT(pool, XF_ERR_INVALID_ARG, TAG, "pool must not be NULL");
     xf_task_pool_handle_t *pool_handle = (xf_task_pool_handle_t *)pool;
 
+    if (!xf_list_empty(&pool_handle->wait_list)) {
+        XF_LOGE(TAG, "pool has waiting tasks");
+        return XF_ERR_BUSY;
+    }
+
     xf_pool_task_t *task_pool;
     xf_list_for_each_entry(task_pool, &pool_handle->pool_list, xf_pool_task_t, node) {
         xf_task_base_t *handle = (xf_task_base_t *)task_pool->task;
-        handle->delete = xf_task_destructor;
+        xf_task_base_set_delete(handle, xf_task_destructor);
         xf_task_delete(task_pool->task);
     }
     xf_list_for_each_entry(task_pool, &pool_handle->used_list, xf_pool_task_t, node) {
         xf_task_base_t *handle = (xf_task_base_t *)task_pool->task;
-        handle->delete = xf_task_destructor;
+        xf_task_base_set_delete(handle, xf_task_destructor);
         xf_task_delete(task_pool->task);
     }
+
+    xf_task_pool_chunk_t *chunk, *_chunk;
+    xf_list_for_each_entry_safe(chunk, _chunk, &pool_handle->chunk_list, xf_task_pool_chunk_t, node) {
+        xf_list_del_init(&chunk->node);
+        xf_free(chunk);
+    }
+
+    if (pool_handle->shrink_task != NULL) {
+        xf_task_delete(pool_handle->shrink_task);
+    }
+
+    // 未执行的作业直接丢弃
+    for (uint32_t i = 0; i < pool_handle->attr.job_workers; i++) {
+        if (pool_handle->job_workers[i].task != NULL) {
+            xf_task_delete(pool_handle->job_workers[i].task);
+        }
+    }
+
     xf_free(pool);
 
     return XF_OK;
@@ -109,24 +262,180 @@ xf_err_t xf_task_pool_delete(xf_task_pool_t pool)
 
 xf_task_t xf_task_init_from_pool(xf_task_pool_t pool, xf_task_func_t func, void *func_arg, uint16_t priority)
 {
-    XF_ASSERT(pool, NULL, TAG, "pool must not be NULL");
-    XF_ASSERT(func, NULL, TAG, "func must not be NULL");
-    XF_ASSERT(priority < XF_TASK_PRIORITY_LEVELS, NULL, TAG, "priority must less than %d", XF_TASK_PRIORITY_LEVELS);
+    xf_task_t task = NULL;
+
+    xf_task_pool_acquire(pool, func, func_arg, priority, XF_TASK_POOL_NOWAIT, 0, &task);
+
+    return task;
+}
+
+xf_err_t xf_task_pool_acquire(xf_task_pool_t pool, xf_task_func_t func, void *func_arg, uint16_t priority,
+                              xf_task_pool_mode_t mode, uint32_t timeout, xf_task_t *task)
+{
+    XF_ASSERT(pool, XF_ERR_INVALID_ARG, TAG, "pool must not be NULL");
+    XF_ASSERT(func, XF_ERR_INVALID_ARG, TAG, "func must not be NULL");
+    XF_ASSERT(priority < XF_TASK_PRIORITY_LEVELS, XF_ERR_INVALID_ARG, TAG, "priority must less than %d",
+              XF_TASK_PRIORITY_LEVELS);
 
     xf_task_pool_handle_t *pool_handle = (xf_task_pool_handle_t *)pool;
+    xf_task_t work = xf_task_pool_take(pool_handle, func, func_arg, priority);
 
-    xf_pool_task_t *pool_task = xf_list_first_entry(&pool_handle->pool_list, xf_pool_task_t, node);
+    if (task != NULL) {
+        *task = work;
+    }
 
-    xf_list_del_init(&pool_task->node);
-    xf_list_add_tail(&pool_task->node, &pool_handle->used_list);
+    if (work != NULL) {
+        return XF_OK;
+    }
 
-    xf_task_reset(pool_task->task);
-    xf_task_base_t *handle = (xf_task_base_t *)pool_task->task;
-    handle->func = func;
-    handle->arg = func_arg;
-    handle->priority = priority;
+    if (mode == XF_TASK_POOL_PENDING) {
+        if (pool_handle->pending_count >= pool_handle->attr.pending_max) {
+            XF_LOGD(TAG, "pending queue is full");
+            return XF_ERR_NO_MEM;
+        }
+        uint32_t index = (pool_handle->pending_head + pool_handle->pending_count) % pool_handle->attr.pending_max;
+        pool_handle->pending[index].func = func;
+        pool_handle->pending[index].arg = func_arg;
+        pool_handle->pending[index].priority = priority;
+        pool_handle->pending_count++;
+        return XF_OK;
+    }
 
-    return pool_task->task;
+    if (mode != XF_TASK_POOL_BLOCK) {
+        XF_LOGD(TAG, "pool is exhausted");
+        return XF_ERR_NO_MEM;
+    }
+
+#if XF_TASK_CONTEXT_IS_ENABLE
+    xf_task_t current = xf_task_manager_get_current_task(pool_handle->manager);
+    xf_task_pool_waiter_t waiter;
+
+    // 只有ctask才能阻塞等待
+    if (current == NULL || XF_TASK_TYPE_CTASK != xf_task_get_type(current)) {
+        XF_LOGE(TAG, "task must ctask");
+        return XF_ERR_NOT_SUPPORTED;
+    }
+
+    waiter.task = current;
+    xf_list_init(&waiter.node);
+
+    while (work == NULL) {
+        xf_list_add_tail(&waiter.node, &pool_handle->wait_list);
+        // 这里有可能会被回收工作任务时唤醒，从而延时未达到timeout
+        xf_ctask_delay_with_manager(pool_handle->manager, timeout);
+        xf_list_del_init(&waiter.node);
+
+        // 被唤醒后重新尝试，可能被其他任务抢先取走
+        work = xf_task_pool_take(pool_handle, func, func_arg, priority);
+        if (work == NULL && xf_task_get_timeout(current) >= 0) {
+            XF_LOGD(TAG, "pool timeout");
+            return XF_ERR_TIMEOUT;
+        }
+        // 没达到超时进入循环继续进行接下来的超时
+        timeout = -xf_task_get_timeout(current);
+    }
+
+    if (task != NULL) {
+        *task = work;
+    }
+
+    return XF_OK;
+#else
+    UNUSED(timeout);
+    XF_LOGE(TAG, "ctask is disabled");
+    return XF_ERR_NOT_SUPPORTED;
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+}
+
+uint32_t xf_task_pool_shrink(xf_task_pool_t pool)
+{
+    XF_ASSERT(pool, 0, TAG, "pool must not be NULL");
+
+    xf_task_pool_handle_t *pool_handle = (xf_task_pool_handle_t *)pool;
+    xf_task_time_t now = xf_task_get_ticks();
+    int32_t idle_ticks = xf_task_msec_to_ticks(pool_handle->attr.idle_shrink_ms);
+    xf_task_pool_chunk_t *chunk, *_chunk;
+    uint32_t count = 0;
+
+    xf_list_for_each_entry_safe(chunk, _chunk, &pool_handle->chunk_list, xf_task_pool_chunk_t, node) {
+        if (chunk->resident || chunk->used != 0 || (int32_t)(now - chunk->idle_since) < idle_ticks) {
+            continue;
+        }
+        if (pool_handle->total - chunk->count < pool_handle->attr.min_works) {
+            continue;
+        }
+        count += chunk->count;
+        xf_task_pool_chunk_free(pool_handle, chunk);
+    }
+
+    return count;
+}
+
+xf_err_t xf_task_pool_get_works(xf_task_pool_t pool, uint32_t *total, uint32_t *used)
+{
+    XF_ASSERT(pool, XF_ERR_INVALID_ARG, TAG, "pool must not be NULL");
+
+    xf_task_pool_handle_t *pool_handle = (xf_task_pool_handle_t *)pool;
+
+    if (total != NULL) {
+        *total = pool_handle->total;
+    }
+    if (used != NULL) {
+        *used = pool_handle->used;
+    }
+
+    return XF_OK;
+}
+
+xf_err_t xf_task_pool_submit(xf_task_pool_t pool, xf_task_pool_job_func_t func, void *arg)
+{
+    return xf_task_pool_submit_with_done(pool, func, arg, NULL);
+}
+
+xf_err_t xf_task_pool_submit_with_done(xf_task_pool_t pool, xf_task_pool_job_func_t func, void *arg,
+                                       xf_task_pool_job_func_t done)
+{
+    XF_ASSERT(pool, XF_ERR_INVALID_ARG, TAG, "pool must not be NULL");
+    XF_ASSERT(func, XF_ERR_INVALID_ARG, TAG, "func must not be NULL");
+
+    xf_task_pool_handle_t *pool_handle = (xf_task_pool_handle_t *)pool;
+    uint32_t size = pool_handle->attr.job_queue_size;
+
+    if (size == 0) {
+        XF_LOGE(TAG, "pool has no job queue");
+        return XF_ERR_NOT_SUPPORTED;
+    }
+
+    if (pool_handle->job_count >= size) {
+        XF_LOGD(TAG, "job queue is full");
+        return XF_ERR_NO_MEM;
+    }
+
+    uint32_t index = pool_handle->job_head + pool_handle->job_count;
+    index = (index >= size) ? (index - size) : index;
+    pool_handle->jobs[index].func = func;
+    pool_handle->jobs[index].done = done;
+    pool_handle->jobs[index].arg = arg;
+    pool_handle->job_count++;
+
+    // 只唤醒空闲的工作任务，正在执行作业的 ctask 可能阻塞在作业中，不能打断
+    if (!xf_list_empty(&pool_handle->job_idle_list)) {
+        xf_task_pool_job_worker_t *worker = xf_list_first_entry(&pool_handle->job_idle_list,
+                                            xf_task_pool_job_worker_t, node);
+        xf_list_del_init(&worker->node);
+        xf_task_trigger(worker->task);
+    }
+
+    return XF_OK;
+}
+
+uint32_t xf_task_pool_get_jobs(xf_task_pool_t pool)
+{
+    XF_ASSERT(pool, 0, TAG, "pool must not be NULL");
+
+    xf_task_pool_handle_t *pool_handle = (xf_task_pool_handle_t *)pool;
+
+    return pool_handle->job_count;
 }
 
 /* ==================== [Static Functions] ================================== */
@@ -136,6 +445,111 @@ static void xf_task_pool_default_task(xf_task_t task)
     UNUSED(task);
 }
 
+static void xf_task_pool_shrink_task(xf_task_t task)
+{
+    xf_task_pool_shrink(xf_task_get_arg(task));
+}
+
+static xf_err_t xf_task_pool_grow(xf_task_pool_handle_t *pool, uint32_t count, bool resident)
+{
+    xf_task_pool_chunk_t *chunk = (xf_task_pool_chunk_t *)xf_malloc(sizeof(xf_task_pool_chunk_t) +
+                                  sizeof(xf_pool_task_t) * count);
+    if (chunk == NULL) {
+        XF_LOGE(TAG, "memory alloc failed!");
+        return XF_ERR_NO_MEM;
+    }
+
+    xf_pool_task_t *pool_task = CHUNK_WORKS(chunk);
+
+    for (uint32_t i = 0; i < count; i++) {
+        pool_task[i].task = xf_task_create_with_manager(pool->manager, pool->type, xf_task_pool_default_task, NULL, 0,
+                            &pool->config);
+        // 紧凑布局下删除函数表已满时无法替换删除函数，任务删除时会直接释放，同样回滚
+        if (pool_task[i].task != NULL
+                && xf_task_base_set_delete((xf_task_base_t *)pool_task[i].task, xf_task_delete_) != XF_OK) {
+            xf_task_delete(pool_task[i].task);
+            pool_task[i].task = NULL;
+        }
+        if (pool_task[i].task == NULL) {
+            // 回滚本批已经创建的任务
+            while (i-- > 0) {
+                xf_task_base_t *handle = (xf_task_base_t *)pool_task[i].task;
+                xf_list_del_init(&pool_task[i].node);
+                xf_task_base_set_delete(handle, xf_task_destructor);
+                xf_task_delete(pool_task[i].task);
+            }
+            xf_free(chunk);
+            return XF_ERR_NO_MEM;
+        }
+        xf_task_base_t *task_base = (xf_task_base_t *)pool_task[i].task;
+        task_base->user_data = &pool_task[i];
+        pool_task[i].pool = pool;
+        pool_task[i].chunk = chunk;
+        xf_task_suspend(pool_task[i].task);
+        xf_list_init(&pool_task[i].node);
+        xf_list_add_tail(&pool_task[i].node, &pool->pool_list);
+    }
+
+    xf_list_init(&chunk->node);
+    chunk->count = count;
+    chunk->used = 0;
+    chunk->idle_since = xf_task_get_ticks();
+    chunk->resident = resident;
+    xf_list_add_tail(&chunk->node, &pool->chunk_list);
+    pool->total += count;
+
+    return XF_OK;
+}
+
+static void xf_task_pool_chunk_free(xf_task_pool_handle_t *pool, xf_task_pool_chunk_t *chunk)
+{
+    xf_pool_task_t *pool_task = CHUNK_WORKS(chunk);
+
+    // 任务由任务管理器在空闲时异步销毁，销毁时不会再访问 chunk
+    for (uint32_t i = 0; i < chunk->count; i++) {
+        xf_task_base_t *handle = (xf_task_base_t *)pool_task[i].task;
+        xf_list_del_init(&pool_task[i].node);
+        xf_task_base_set_delete(handle, xf_task_destructor);
+        xf_task_delete(pool_task[i].task);
+    }
+
+    pool->total -= chunk->count;
+    xf_list_del_init(&chunk->node);
+    xf_free(chunk);
+}
+
+static xf_task_t xf_task_pool_take(xf_task_pool_handle_t *pool, xf_task_func_t func, void *func_arg,
+                                   uint16_t priority)
+{
+    // 没有空闲的工作任务时尝试扩充
+    if (xf_list_empty(&pool->pool_list)) {
+        uint32_t count = pool->attr.max_works - pool->total;
+        if (count == 0) {
+            return NULL;
+        }
+        count = (count > pool->attr.grow_step) ? pool->attr.grow_step : count;
+        if (xf_task_pool_grow(pool, count, false) != XF_OK) {
+            return NULL;
+        }
+    }
+
+    // 后进先出，刚回收的工作任务更可能还在缓存中
+    xf_pool_task_t *pool_task = xf_list_first_entry(&pool->pool_list, xf_pool_task_t, node);
+
+    xf_list_del_init(&pool_task->node);
+    xf_list_add_tail(&pool_task->node, &pool->used_list);
+    pool_task->chunk->used++;
+    pool->used++;
+
+    xf_task_reset(pool_task->task);
+    xf_task_base_t *handle = (xf_task_base_t *)pool_task->task;
+    handle->func = func;
+    handle->arg = func_arg;
+    handle->priority = priority;
+
+    return pool_task->task;
+}
+
 static void xf_task_delete_(xf_task_t task)
 {
     xf_task_base_t *task_base = (xf_task_base_t *)task;
@@ -148,7 +562,105 @@ static void xf_task_delete_(xf_task_t task)
     xf_task_suspend(task);
 
     xf_list_del_init(&pool_task->node);
-    xf_list_add_tail(&pool_task->node, &pool->pool_list);
+    xf_list_add(&pool_task->node, &pool->pool_list);
+    pool_task->chunk->used--;
+    pool->used--;
+    if (pool_task->chunk->used == 0) {
+        pool_task->chunk->idle_since = xf_task_get_ticks();
+    }
+
+    // 优先执行等待队列中的请求，其次唤醒阻塞等待的有栈协程
+    if (pool->pending_count != 0) {
+        xf_task_pool_pending_t *pending = &pool->pending[pool->pending_head];
+        pool->pending_head = (pool->pending_head + 1) % pool->attr.pending_max;
+        pool->pending_count--;
+        xf_task_pool_take(pool, pending->func, pending->arg, pending->priority);
+    } else if (!xf_list_empty(&pool->wait_list)) {
+        xf_task_pool_waiter_t *waiter = xf_list_first_entry(&pool->wait_list, xf_task_pool_waiter_t, node);
+        xf_list_del_init(&waiter->node);
+        xf_task_trigger(waiter->task);
+    }
+}
+
+static xf_err_t xf_task_pool_job_worker_create(xf_task_pool_handle_t *pool, xf_task_pool_job_worker_t *worker)
+{
+    xf_list_init(&worker->node);
+    worker->pool = pool;
+
+#if XF_TASK_CONTEXT_IS_ENABLE
+    if (pool->type == XF_TASK_TYPE_CTASK) {
+        // ctask 启动后会自行进入空闲队列
+        worker->task = xf_ctask_create_with_manager(pool->manager, xf_task_pool_job_ctask, worker,
+                       pool->attr.job_priority, pool->config.ctask.stack_size);
+    } else
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+    {
+        // 周期为 0 的 ntask 只在被触发时执行
+        worker->task = xf_ntask_create_with_manager(pool->manager, xf_task_pool_job_ntask, worker,
+                       pool->attr.job_priority, 0, XF_NTASK_INFINITE_LOOP);
+        xf_list_add_tail(&worker->node, &pool->job_idle_list);
+    }
+
+    if (worker->task == NULL) {
+        xf_list_del_init(&worker->node);
+        return XF_ERR_NO_MEM;
+    }
+
+    return XF_OK;
+}
+
+static bool xf_task_pool_job_drain(xf_task_pool_handle_t *pool)
+{
+    uint32_t batch = XF_TASK_POOL_JOB_BATCH;
+
+    while (pool->job_count != 0 && batch-- != 0) {
+        // 先取出作业，作业中可能继续提交作业
+        xf_task_pool_job_t job = pool->jobs[pool->job_head];
+        pool->job_head = (pool->job_head + 1 == pool->attr.job_queue_size) ? 0 : (pool->job_head + 1);
+        pool->job_count--;
+
+        job.func(job.arg);
+        if (job.done != NULL) {
+            job.done(job.arg);
+        }
+    }
+
+    return pool->job_count != 0;
+}
+
+static void xf_task_pool_job_ntask(xf_task_t task)
+{
+    xf_task_pool_job_worker_t *worker = (xf_task_pool_job_worker_t *)xf_task_get_arg(task);
+
+    if (xf_task_pool_job_drain(worker->pool)) {
+        // 还有作业，让出一次调度后继续执行下一批
+        xf_task_trigger(task);
+        return;
+    }
+
+    xf_list_del_init(&worker->node);
+    xf_list_add_tail(&worker->node, &worker->pool->job_idle_list);
+}
+
+#if XF_TASK_CONTEXT_IS_ENABLE
+static void xf_task_pool_job_ctask(xf_task_t task)
+{
+    xf_task_pool_job_worker_t *worker = (xf_task_pool_job_worker_t *)xf_task_get_arg(task);
+    xf_task_pool_handle_t *pool = worker->pool;
+
+    while (1) {
+        if (xf_task_pool_job_drain(pool)) {
+            // 还有作业，让出一次调度后继续执行下一批
+            xf_ctask_delay_with_manager(pool->manager, 0);
+            continue;
+        }
+
+        xf_list_del_init(&worker->node);
+        xf_list_add_tail(&worker->node, &pool->job_idle_list);
+        xf_ctask_delay_with_manager(pool->manager, JOB_IDLE_MS);
+        xf_list_del_init(&worker->node);
+    }
 }
+#endif // XF_TASK_CONTEXT_IS_ENABLE
 
 #endif
@@ -40,10 +40,40 @@ extern "C" {
  */
 typedef void *xf_task_pool_t;
 
+/**
+ * @brief 任务池属性。
+ */
+typedef struct _xf_task_pool_attr_t {
+    uint32_t min_works;         /*!< 常驻工作任务数，创建时预先分配，收缩时不会低于该值 */
+    uint32_t max_works;         /*!< 最大工作任务数 */
+    uint32_t grow_step;         /*!< 工作任务不足时一次扩充的数量，为 0 时按 1 处理 */
+    uint32_t idle_shrink_ms;    /*!< 一批扩充的工作任务全部空闲超过该时间后回收，为 0 时不回收 */
+    uint32_t pending_max;       /*!< 等待队列长度，见 XF_TASK_POOL_PENDING */
+    uint32_t job_queue_size;    /*!< 作业队列长度，为 0 时不创建作业队列，见 @ref xf_task_pool_submit */
+    uint32_t job_workers;       /*!< 执行作业的常驻工作任务数，为 0 时按 1 处理 */
+    uint16_t job_priority;      /*!< 执行作业的工作任务优先级 */
+} xf_task_pool_attr_t;
+
+/**
+ * @brief 作业函数。
+ *
+ * @param arg 提交作业时传入的参数。
+ */
+typedef void (*xf_task_pool_job_func_t)(void *arg);
+
+/**
+ * @brief 工作任务耗尽时的处理方式。
+ */
+typedef enum _xf_task_pool_mode_t {
+    XF_TASK_POOL_NOWAIT = 0,    /*!< 立即返回失败 */
+    XF_TASK_POOL_PENDING,       /*!< 放入等待队列，有工作任务被回收时立即用它执行 */
+    XF_TASK_POOL_BLOCK,         /*!< 阻塞当前有栈协程，直到有工作任务被回收或超时 */
+} xf_task_pool_mode_t;
+
 /* ==================== [Global Prototypes] ================================= */
 
 /**
- * @brief 创建一个任务池。
+ * @brief 创建一个任务池。所有工作任务在创建时分配，不会扩充与回收。
  *
  * @param max_works 任务池最大任务数。
  * @param manager 任务管理器。
@@ -54,12 +84,28 @@ typedef void *xf_task_pool_t;
 xf_task_pool_t xf_task_pool_create_with_manager(uint32_t max_works, xf_task_manager_t manager, xf_task_type_t type,
         void *config);
 
+/**
+ * @brief 按属性创建一个可伸缩的任务池。
+ *
+ * 创建时预先分配 min_works 个工作任务，不足时按 grow_step 一批一批扩充直到 max_works，
+ * 扩充的一批工作任务全部空闲超过 idle_shrink_ms 后被回收。
+ *
+ * @param manager 任务管理器。
+ * @param type 任务类型。
+ * @param config 任务配置，任务池会保存一份副本用于之后的扩充。
+ * @param attr 任务池属性。
+ * @return xf_task_pool_t 任务池对象，如果创建失败则返回 NULL
+ */
+xf_task_pool_t xf_task_pool_create_with_attr(xf_task_manager_t manager, xf_task_type_t type, void *config,
+        const xf_task_pool_attr_t *attr);
+
 /**
  * @brief 删除任务池。
  *
  * @param pool 任务池对象。
  * @return xf_err_t
  *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_BUSY 还有有栈协程阻塞等待工作任务
  *      - XF_OK 任务池删除成功
  */
 xf_err_t xf_task_pool_delete(xf_task_pool_t pool);
@@ -67,6 +113,8 @@ xf_err_t xf_task_pool_delete(xf_task_pool_t pool);
 /**
  * @brief 初始化任务。
  *
+ * @note 工作任务耗尽且无法扩充时返回 NULL，等价于 XF_TASK_POOL_NOWAIT 的 @ref xf_task_pool_acquire.
+ *
  * @param pool 任务池对象。
  * @param func 任务执行的函数。
  * @param func_arg 用户自定义执行函数参数。
@@ -75,6 +123,86 @@ xf_err_t xf_task_pool_delete(xf_task_pool_t pool);
  */
 xf_task_t xf_task_init_from_pool(xf_task_pool_t pool, xf_task_func_t func, void *func_arg, uint16_t priority);
 
+/**
+ * @brief 从任务池中取出工作任务执行 func，并指定工作任务耗尽时的处理方式。
+ *
+ * @param pool 任务池对象。
+ * @param func 任务执行的函数。
+ * @param func_arg 用户自定义执行函数参数。
+ * @param priority 任务优先级。
+ * @param mode 工作任务耗尽时的处理方式，见 @ref xf_task_pool_mode_t.
+ * @param timeout XF_TASK_POOL_BLOCK 时的超时时间，单位为毫秒。
+ * @param[out] task 取到的任务对象，可以为 NULL。进入等待队列时为 NULL。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_NO_MEM 工作任务耗尽（XF_TASK_POOL_NOWAIT）或等待队列已满（XF_TASK_POOL_PENDING）
+ *      - XF_ERR_NOT_SUPPORTED XF_TASK_POOL_BLOCK 不是在有栈协程中调用
+ *      - XF_ERR_TIMEOUT 等待超时
+ *      - XF_OK 成功取到工作任务或已进入等待队列
+ */
+xf_err_t xf_task_pool_acquire(xf_task_pool_t pool, xf_task_func_t func, void *func_arg, uint16_t priority,
+                              xf_task_pool_mode_t mode, uint32_t timeout, xf_task_t *task);
+
+/**
+ * @brief 立即回收空闲超时的工作任务。
+ *
+ * @note 设置了 idle_shrink_ms 时任务池会周期性地自动调用。
+ *
+ * @param pool 任务池对象。
+ * @return uint32_t 回收的工作任务数
+ */
+uint32_t xf_task_pool_shrink(xf_task_pool_t pool);
+
+/**
+ * @brief 获取任务池当前的工作任务数。
+ *
+ * @param pool 任务池对象。
+ * @param[out] total 已分配的工作任务数，可以为 NULL。
+ * @param[out] used 正在使用的工作任务数，可以为 NULL。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_OK 成功
+ */
+xf_err_t xf_task_pool_get_works(xf_task_pool_t pool, uint32_t *total, uint32_t *used);
+
+/**
+ * @brief 向任务池的作业队列提交一个作业。
+ *
+ * 作业只是一个函数与参数，不占用任务对象。作业队列中的作业由任务池常驻的工作任务
+ * 按批次（XF_TASK_POOL_JOB_BATCH）依次执行，适合大量短小的作业。
+ * 工作任务的类型与任务池相同，ctask 类型的作业中可以阻塞等待。
+ *
+ * @param pool 任务池对象，需要以 job_queue_size 不为 0 的属性创建。
+ * @param func 作业函数。
+ * @param arg 作业函数参数。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_NOT_SUPPORTED 任务池没有作业队列
+ *      - XF_ERR_NO_MEM 作业队列已满
+ *      - XF_OK 提交成功
+ */
+xf_err_t xf_task_pool_submit(xf_task_pool_t pool, xf_task_pool_job_func_t func, void *arg);
+
+/**
+ * @brief 向任务池的作业队列提交一个作业，并在作业完成后调用 done。
+ *
+ * @param pool 任务池对象。
+ * @param func 作业函数。
+ * @param arg 作业函数参数，同时传给 done。
+ * @param done 作业完成回调，可以为 NULL。
+ * @return xf_err_t 同 @ref xf_task_pool_submit.
+ */
+xf_err_t xf_task_pool_submit_with_done(xf_task_pool_t pool, xf_task_pool_job_func_t func, void *arg,
+                                       xf_task_pool_job_func_t done);
+
+/**
+ * @brief 获取作业队列中还未执行的作业数。
+ *
+ * @param pool 任务池对象。
+ * @return uint32_t 未执行的作业数
+ */
+uint32_t xf_task_pool_get_jobs(xf_task_pool_t pool);
+
 /* ==================== [Macros] ============================================ */
 
 #ifdef __cplusplus
@@ -0,0 +1,381 @@
+/**
+ * @file xf_task_sim.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 调度仿真（虚拟时钟与负载生成）。
+ * @version 0.1
+ * @date 2024-09-12
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_task_utils_config.h"
+
+#if XF_TASK_SIM_IS_ENABLE
+
+#include "xf_task_sim.h"
+#include "../kernel/xf_task_base.h"
+#include "../port/xf_task_port_config.h"
+#include "../port/xf_task_port_internal.h"
+#include "../task/xf_ntask.h"
+#include "../task/xf_ctask.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "task_sim"
+
+#define QUEUE_WAIT_MS (1000U)       // ctask 队列的等待时间，超时后重新等待
+
+/* ==================== [Typedefs] ========================================== */
+
+struct _xf_task_sim_handle_t;
+
+typedef struct _xf_task_sim_task_t {
+    xf_task_t task;
+    struct _xf_task_sim_handle_t *sim;
+    uint32_t period_ms;             // 周期任务与生产者的周期
+    xf_task_time_t release;         // 事件任务被触发的时间
+    bool pending;                   // 事件任务已被触发还未执行
+#if XF_TASK_CONTEXT_IS_ENABLE
+    xf_ctask_queue_t queue;         // 生产者与消费者共用的队列
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+} xf_task_sim_task_t;
+
+typedef struct _xf_task_sim_hist_t {
+    uint32_t count;
+    xf_task_time_t max;
+    uint32_t buckets[XF_TASK_SIM_HIST_SIZE];
+} xf_task_sim_hist_t;
+
+typedef struct _xf_task_sim_handle_t {
+    const xf_task_sim_config_t *config;
+    xf_task_manager_t manager;
+    uint32_t rand;                  // xorshift32 状态
+    uint32_t task_count;
+    xf_task_sim_task_t *tasks;      // 周期任务、事件任务、生产者与消费者依次排列
+    xf_task_sim_task_t *events;
+    xf_task_sim_report_t *report;
+    xf_task_sim_hist_t latency;
+    xf_task_sim_hist_t queue;
+} xf_task_sim_handle_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static uint32_t xf_task_sim_rand(xf_task_sim_handle_t *sim, uint32_t min, uint32_t max);
+static void xf_task_sim_exec(xf_task_sim_handle_t *sim);
+static void xf_task_sim_record(xf_task_sim_hist_t *hist, xf_task_time_t value);
+static void xf_task_sim_percentile(const xf_task_sim_hist_t *hist, xf_task_sim_latency_t *latency);
+static xf_err_t xf_task_sim_create(xf_task_sim_handle_t *sim);
+static void xf_task_sim_destroy(xf_task_sim_handle_t *sim);
+static void xf_task_sim_periodic_entry(xf_task_t task);
+static void xf_task_sim_event_entry(xf_task_t task);
+#if XF_TASK_CONTEXT_IS_ENABLE
+static void xf_task_sim_producer_entry(xf_task_t task);
+static void xf_task_sim_consumer_entry(xf_task_t task);
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_task_time_t s_now = 0;
+static xf_task_time_t s_end = 0;
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_task_time_t xf_task_sim_get_ticks(void)
+{
+    return s_now;
+}
+
+void xf_task_sim_on_idle(unsigned long int max_idle_ms)
+{
+    uint64_t ticks = (uint64_t)max_idle_ms * XF_TASK_TICKS_FREQUENCY / 1000;
+    int32_t remain = s_end - s_now;
+
+    // 没有定时唤醒的任务时直接跳到仿真结束
+    if (remain > 0 && ticks > (uint64_t)remain) {
+        ticks = (uint64_t)remain;
+    }
+
+    // 空闲时间不足一个 tick 时也要前进，否则调度器会原地空转
+    s_now += (ticks == 0) ? 1 : (xf_task_time_t)ticks;
+}
+
+void xf_task_sim_advance(xf_task_time_t ticks)
+{
+    s_now += ticks;
+}
+
+xf_err_t xf_task_sim_run(const xf_task_sim_config_t *config, xf_task_sim_report_t *report)
+{
+    XF_ASSERT(config, XF_ERR_INVALID_ARG, TAG, "config must not be NULL");
+    XF_ASSERT(report, XF_ERR_INVALID_ARG, TAG, "report must not be NULL");
+    XF_ASSERT(config->duration_ms, XF_ERR_INVALID_ARG, TAG, "duration must not be 0");
+    XF_ASSERT(config->period_min_ms && config->period_min_ms <= config->period_max_ms, XF_ERR_INVALID_ARG, TAG,
+              "period range is invalid");
+    XF_ASSERT(config->exec_min_ticks <= config->exec_max_ticks, XF_ERR_INVALID_ARG, TAG, "exec range is invalid");
+    XF_ASSERT(config->priorities <= XF_TASK_PRIORITY_LEVELS, XF_ERR_INVALID_ARG, TAG,
+              "priorities must not be greater than %d", XF_TASK_PRIORITY_LEVELS);
+    XF_ASSERT(config->event_tasks == 0 || config->ntasks != 0, XF_ERR_INVALID_ARG, TAG,
+              "event tasks need periodic tasks to trigger them");
+
+#if XF_TASK_CONTEXT_IS_ENABLE
+    XF_ASSERT(config->ctask_pairs == 0 || (config->queue_depth && config->stack_size), XF_ERR_INVALID_ARG, TAG,
+              "queue depth and stack size must not be 0");
+#else
+    if (config->ctask_pairs != 0) {
+        XF_LOGE(TAG, "ctask is disabled");
+        return XF_ERR_NOT_SUPPORTED;
+    }
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+
+    uint32_t task_count = config->ntasks + config->event_tasks + config->ctask_pairs * 2;
+    xf_task_sim_handle_t *sim = (xf_task_sim_handle_t *)xf_malloc(sizeof(xf_task_sim_handle_t) +
+                                sizeof(xf_task_sim_task_t) * task_count);
+    if (sim == NULL) {
+        XF_LOGE(TAG, "memory alloc failed!");
+        return XF_ERR_NO_MEM;
+    }
+
+    xf_bzero(sim, sizeof(xf_task_sim_handle_t) + sizeof(xf_task_sim_task_t) * task_count);
+    xf_bzero(report, sizeof(xf_task_sim_report_t));
+    sim->config = config;
+    sim->report = report;
+    sim->rand = (config->seed == 0) ? 1 : config->seed;
+    sim->task_count = task_count;
+    sim->tasks = (xf_task_sim_task_t *)((uint8_t *)sim + sizeof(xf_task_sim_handle_t));
+    sim->events = &sim->tasks[config->ntasks];
+
+    // 从 0 开始计时，所有周期任务在同一时刻释放，即最坏情况的临界时刻
+    s_now = 0;
+    s_end = (xf_task_time_t)((uint64_t)config->duration_ms * XF_TASK_TICKS_FREQUENCY / 1000);
+
+    sim->manager = xf_task_manager_create(xf_task_sim_on_idle);
+    xf_err_t err = (sim->manager == NULL) ? XF_ERR_NO_MEM : xf_task_sim_create(sim);
+
+    if (err == XF_OK) {
+        while ((int32_t)(s_now - s_end) < 0) {
+            xf_task_manager_run(sim->manager);
+        }
+
+        report->elapsed = s_now;
+        report->utilization = (uint32_t)((uint64_t)report->busy * 1000 / s_now);
+        report->throughput = (uint32_t)((uint64_t)report->jobs * XF_TASK_TICKS_FREQUENCY / s_now);
+        for (uint32_t i = 0; i < config->ntasks; i++) {
+            report->skipped += xf_ntask_get_overrun(sim->tasks[i].task);
+        }
+        xf_task_sim_percentile(&sim->latency, &report->latency);
+        xf_task_sim_percentile(&sim->queue, &report->queue);
+    }
+
+    xf_task_sim_destroy(sim);
+    xf_free(sim);
+
+    return err;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static uint32_t xf_task_sim_rand(xf_task_sim_handle_t *sim, uint32_t min, uint32_t max)
+{
+    uint32_t x = sim->rand;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    sim->rand = x;
+
+    return (max > min) ? min + x % (max - min + 1) : min;
+}
+
+static void xf_task_sim_exec(xf_task_sim_handle_t *sim)
+{
+    xf_task_time_t ticks = xf_task_sim_rand(sim, sim->config->exec_min_ticks, sim->config->exec_max_ticks);
+
+    xf_task_sim_advance(ticks);
+    sim->report->busy += ticks;
+    sim->report->jobs++;
+}
+
+static void xf_task_sim_record(xf_task_sim_hist_t *hist, xf_task_time_t value)
+{
+    hist->buckets[(value < XF_TASK_SIM_HIST_SIZE) ? value : XF_TASK_SIM_HIST_SIZE - 1]++;
+    hist->max = (value > hist->max) ? value : hist->max;
+    hist->count++;
+}
+
+static void xf_task_sim_percentile(const xf_task_sim_hist_t *hist, xf_task_sim_latency_t *latency)
+{
+    // 超出直方图范围的分位数按最大值计
+    const uint32_t permille[3] = {500, 900, 990};
+    xf_task_time_t *value[3] = {&latency->p50, &latency->p90, &latency->p99};
+    uint32_t sum = 0;
+    uint32_t index = 0;
+
+    latency->max = hist->max;
+    for (uint32_t i = 0; i < XF_TASK_SIM_HIST_SIZE && index < 3; i++) {
+        sum += hist->buckets[i];
+        while (index < 3 && hist->count != 0 && (uint64_t)sum * 1000 >= (uint64_t)hist->count * permille[index]) {
+            *value[index++] = (i == XF_TASK_SIM_HIST_SIZE - 1) ? hist->max : i;
+        }
+    }
+}
+
+static xf_err_t xf_task_sim_create(xf_task_sim_handle_t *sim)
+{
+    const xf_task_sim_config_t *config = sim->config;
+    uint32_t priorities = (config->priorities == 0) ? XF_TASK_PRIORITY_LEVELS : config->priorities;
+
+    for (uint32_t i = 0; i < sim->task_count; i++) {
+        xf_task_sim_task_t *sim_task = &sim->tasks[i];
+        uint16_t priority = (uint16_t)xf_task_sim_rand(sim, 0, priorities - 1);
+
+        sim_task->sim = sim;
+        sim_task->period_ms = xf_task_sim_rand(sim, config->period_min_ms, config->period_max_ms);
+
+        if (i < config->ntasks) {
+            sim_task->task = xf_ntask_create_loop_with_manager(sim->manager, xf_task_sim_periodic_entry, sim_task,
+                             priority, sim_task->period_ms);
+            if (sim_task->task != NULL) {
+                xf_ntask_set_rate(sim_task->task, XF_NTASK_RATE_SKIP);
+            }
+        } else if (i < (uint32_t)config->ntasks + config->event_tasks) {
+            sim_task->task = xf_ntask_create_loop_with_manager(sim->manager, xf_task_sim_event_entry, sim_task,
+                             priority, 0);
+        }
+#if XF_TASK_CONTEXT_IS_ENABLE
+        else if ((i - config->ntasks - config->event_tasks) % 2 == 0) {
+            // 生产者与紧随其后的消费者共用一个队列，由生产者持有
+            sim_task->queue = xf_ctask_queue_create_with_manager(sim->manager, sizeof(xf_task_time_t),
+                              config->queue_depth);
+            if (sim_task->queue == NULL) {
+                return XF_ERR_NO_MEM;
+            }
+            sim_task->task = xf_ctask_create_with_manager(sim->manager, xf_task_sim_producer_entry, sim_task,
+                             priority, config->stack_size);
+        } else {
+            sim_task->queue = sim->tasks[i - 1].queue;
+            sim_task->task = xf_ctask_create_with_manager(sim->manager, xf_task_sim_consumer_entry, sim_task,
+                             priority, config->stack_size);
+        }
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+
+        if (sim_task->task == NULL) {
+            return XF_ERR_NO_MEM;
+        }
+    }
+
+    return XF_OK;
+}
+
+static void xf_task_sim_destroy(xf_task_sim_handle_t *sim)
+{
+    if (sim->manager == NULL) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < sim->task_count; i++) {
+        if (sim->tasks[i].task != NULL) {
+            xf_task_delete(sim->tasks[i].task);
+        }
+    }
+
+    // 所有任务都已删除，下一次调度进入空闲并释放它们，之后才能释放队列
+    xf_task_manager_run(sim->manager);
+
+#if XF_TASK_CONTEXT_IS_ENABLE
+    for (uint32_t i = sim->config->ntasks + sim->config->event_tasks; i < sim->task_count; i += 2) {
+        if (sim->tasks[i].queue != NULL) {
+            xf_ctask_queue_delete(sim->tasks[i].queue);
+        }
+    }
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+
+    xf_task_manager_delete(sim->manager);
+}
+
+static void xf_task_sim_periodic_entry(xf_task_t task)
+{
+    xf_task_sim_task_t *sim_task = (xf_task_sim_task_t *)xf_task_get_arg(task);
+    xf_task_sim_handle_t *sim = sim_task->sim;
+    // 执行函数返回后才推进周期点，这里的唤醒时间就是本次的周期点
+    xf_task_time_t release = ((xf_task_base_t *)task)->weakup;
+    xf_task_time_t deadline = release + ((xf_task_base_t *)task)->delay;
+
+    xf_task_sim_record(&sim->latency, s_now - release);
+    xf_task_sim_exec(sim);
+
+    if ((int32_t)(s_now - deadline) > 0) {
+        sim->report->deadline_miss++;
+    }
+
+    if (sim->config->event_tasks != 0
+            && xf_task_sim_rand(sim, 0, 999) < sim->config->trigger_permille) {
+        xf_task_sim_task_t *event = &sim->events[xf_task_sim_rand(sim, 0, sim->config->event_tasks - 1)];
+        if (!event->pending) {
+            event->pending = true;
+            event->release = s_now;
+            sim->report->triggers++;
+            xf_task_trigger(event->task);
+        }
+    }
+}
+
+static void xf_task_sim_event_entry(xf_task_t task)
+{
+    xf_task_sim_task_t *sim_task = (xf_task_sim_task_t *)xf_task_get_arg(task);
+    xf_task_sim_handle_t *sim = sim_task->sim;
+
+    if (!sim_task->pending) {
+        return;
+    }
+
+    sim_task->pending = false;
+    xf_task_sim_record(&sim->latency, s_now - sim_task->release);
+    xf_task_sim_exec(sim);
+}
+
+#if XF_TASK_CONTEXT_IS_ENABLE
+
+static void xf_task_sim_producer_entry(xf_task_t task)
+{
+    xf_task_sim_task_t *sim_task = (xf_task_sim_task_t *)xf_task_get_arg(task);
+    xf_task_sim_handle_t *sim = sim_task->sim;
+
+    while (1) {
+        // 生产消息的执行时间计入忙碌时间，消息在消费后才算完成一个作业
+        xf_task_time_t ticks = xf_task_sim_rand(sim, sim->config->exec_min_ticks, sim->config->exec_max_ticks);
+        xf_task_sim_advance(ticks);
+        sim->report->busy += ticks;
+
+        xf_task_time_t stamp = s_now;
+        while (xf_ctask_queue_send(sim_task->queue, &stamp, QUEUE_WAIT_MS) != XF_OK) {
+        }
+
+        xf_ctask_delay_with_manager(sim->manager, sim_task->period_ms);
+    }
+}
+
+static void xf_task_sim_consumer_entry(xf_task_t task)
+{
+    xf_task_sim_task_t *sim_task = (xf_task_sim_task_t *)xf_task_get_arg(task);
+    xf_task_sim_handle_t *sim = sim_task->sim;
+    xf_task_time_t stamp;
+
+    while (1) {
+        if (xf_ctask_queue_receive(sim_task->queue, &stamp, QUEUE_WAIT_MS) != XF_OK) {
+            continue;
+        }
+
+        xf_task_sim_record(&sim->queue, s_now - stamp);
+        sim->report->messages++;
+        xf_task_sim_exec(sim);
+    }
+}
+
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+
+#endif // XF_TASK_SIM_IS_ENABLE
@@ -0,0 +1,145 @@
+/**
+ * @file xf_task_sim.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 调度仿真（虚拟时钟与负载生成）。
+ * @version 0.1
+ * @date 2024-09-12
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_TASK_SIM_H__
+#define __XF_TASK_SIM_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_task_utils_config.h"
+
+#if XF_TASK_SIM_IS_ENABLE
+
+#include "../kernel/xf_task_kernel.h"
+
+/**
+ * @ingroup group_xf_task_user
+ * @defgroup group_xf_task_user_sim sim
+ * @brief 调度仿真。
+ *
+ * 虚拟时钟只在任务声明消耗执行时间（xf_task_sim_advance）或者调度器进入空闲时前进，
+ * 空闲时直接跳到最近的唤醒时间，因此仿真速度与真实时间无关，几个小时的负载可以在几秒内跑完。
+ *
+ * xf_task_sim_run 按随机种子生成负载（周期 ntask、被随机触发的事件 ntask、通过队列通信的 ctask 对），
+ * 在独立的任务管理器上运行指定的虚拟时长，并给出吞吐量、截止时间错过次数与延迟分位数。
+ * 相同的种子与配置得到完全相同的结果，可以用来对比调度器修改前后的表现或评估容量。
+ *
+ * @note 使用前需要通过 xf_task_tick_init(xf_task_sim_get_ticks) 对接虚拟时钟，
+ *       此时所有任务管理器都使用虚拟时钟，不要同时运行真实任务。
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 仿真负载配置，时间范围均为均匀分布。
+ */
+typedef struct _xf_task_sim_config_t {
+    uint32_t seed;                  /*!< 随机种子 */
+    uint32_t duration_ms;           /*!< 仿真的虚拟时长 */
+    uint16_t ntasks;                /*!< 周期 ntask 数，按固定速率（XF_NTASK_RATE_SKIP）运行 */
+    uint16_t event_tasks;           /*!< 事件 ntask 数，只由周期任务触发 */
+    uint16_t ctask_pairs;           /*!< ctask 生产者/消费者对数，每对共用一个队列，需要先对接上下文 */
+    uint16_t priorities;            /*!< 任务随机分布在 0 ~ priorities - 1 的优先级上，为 0 时使用全部优先级 */
+    uint32_t period_min_ms;         /*!< 周期任务与生产者的最短周期 */
+    uint32_t period_max_ms;         /*!< 周期任务与生产者的最长周期 */
+    uint32_t exec_min_ticks;        /*!< 单次执行的最短时间 */
+    uint32_t exec_max_ticks;        /*!< 单次执行的最长时间 */
+    uint16_t trigger_permille;      /*!< 周期任务每次执行后触发一个随机事件任务的概率，单位为千分之一 */
+    uint16_t queue_depth;           /*!< ctask 队列深度 */
+    size_t stack_size;              /*!< ctask 栈大小 */
+} xf_task_sim_config_t;
+
+/**
+ * @brief 延迟分布，单位为 tick.
+ */
+typedef struct _xf_task_sim_latency_t {
+    xf_task_time_t p50;             /*!< 中位数 */
+    xf_task_time_t p90;             /*!< 90 分位 */
+    xf_task_time_t p99;             /*!< 99 分位 */
+    xf_task_time_t max;             /*!< 最大值 */
+} xf_task_sim_latency_t;
+
+/**
+ * @brief 仿真结果，时间单位为 tick.
+ */
+typedef struct _xf_task_sim_report_t {
+    xf_task_time_t elapsed;         /*!< 实际仿真的虚拟时间 */
+    xf_task_time_t busy;            /*!< 任务执行消耗的虚拟时间 */
+    uint32_t utilization;           /*!< 利用率，单位为千分之一 */
+    uint32_t jobs;                  /*!< 完成的作业数：周期或事件任务执行一次，或者消费一条消息 */
+    uint32_t throughput;            /*!< 每秒（虚拟时间）完成的作业数 */
+    uint32_t deadline_miss;         /*!< 周期任务在下一个周期点之后才完成的次数 */
+    uint32_t skipped;               /*!< 周期任务因超限跳过的周期数 */
+    uint32_t triggers;              /*!< 触发事件任务的次数（任务已经在等待执行时不重复计） */
+    uint32_t messages;              /*!< ctask 队列传递的消息数 */
+    xf_task_sim_latency_t latency;  /*!< 周期任务从周期点、事件任务从触发到开始执行的延迟 */
+    xf_task_sim_latency_t queue;    /*!< 消息从发送到被消费的延迟 */
+} xf_task_sim_report_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 获取虚拟时钟，作为 xf_task_tick_init 的参数。
+ *
+ * @return xf_task_time_t 虚拟时间
+ */
+xf_task_time_t xf_task_sim_get_ticks(void);
+
+/**
+ * @brief 虚拟时钟的空闲回调，作为任务管理器的空闲回调。直接把时钟推进到最近的唤醒时间。
+ *
+ * @param max_idle_ms 空闲时间。
+ */
+void xf_task_sim_on_idle(unsigned long int max_idle_ms);
+
+/**
+ * @brief 在任务中调用，表示这次执行消耗了 ticks 的时间。
+ *
+ * @param ticks 消耗的时间。
+ */
+void xf_task_sim_advance(xf_task_time_t ticks);
+
+/**
+ * @brief 按配置生成负载并运行仿真。
+ *
+ * @note 仿真从虚拟时间 0 开始，在独立的任务管理器上运行，结束后删除所有任务与任务管理器。
+ *
+ * @param config 负载配置。
+ * @param[out] report 仿真结果。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG 参数错误
+ *      - XF_ERR_NOT_SUPPORTED 未打开上下文功能时配置了 ctask
+ *      - XF_ERR_NO_MEM 内存不足
+ *      - XF_OK 仿真完成
+ */
+xf_err_t xf_task_sim_run(const xf_task_sim_config_t *config, xf_task_sim_report_t *report);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of group_xf_task_user_sim
+ * @}
+ */
+
+#endif // XF_TASK_SIM_IS_ENABLE
+
+#endif // __XF_TASK_SIM_H__
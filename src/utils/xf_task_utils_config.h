@@ -15,6 +15,7 @@
 /* ==================== [Includes] ========================================== */
 
 #include "../xf_task_config_internal.h"
+#include "../kernel/xf_task_kernel_config.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -31,6 +32,47 @@ extern "C" {
 #   define XF_TASK_MBUS_IS_ENABLE (0)
 #endif
 
+/**
+ * @brief 是否打开 MBUS 模式订阅（范围订阅、掩码订阅）功能。
+ */
+#if XF_TASK_MBUS_IS_ENABLE && (!defined(XF_TASK_MBUS_PATTERN_ENABLE) || (XF_TASK_MBUS_PATTERN_ENABLE))
+#   define XF_TASK_MBUS_PATTERN_IS_ENABLE (1)
+#else
+#   define XF_TASK_MBUS_PATTERN_IS_ENABLE (0)
+#endif
+
+/**
+ * @brief 是否打开 MBUS 请求应答（RPC）功能。
+ */
+#if XF_TASK_MBUS_IS_ENABLE && (!defined(XF_TASK_MBUS_RPC_ENABLE) || (XF_TASK_MBUS_RPC_ENABLE))
+#   define XF_TASK_MBUS_RPC_IS_ENABLE (1)
+#else
+#   define XF_TASK_MBUS_RPC_IS_ENABLE (0)
+#endif
+
+/**
+ * @brief 是否打开 MBUS 跟踪功能（队列等待时间、订阅回调耗时直方图）。默认关闭。
+ */
+#if XF_TASK_MBUS_IS_ENABLE && defined(XF_TASK_MBUS_TRACE_ENABLE) && (XF_TASK_MBUS_TRACE_ENABLE)
+#   define XF_TASK_MBUS_TRACE_IS_ENABLE (1)
+#else
+#   define XF_TASK_MBUS_TRACE_IS_ENABLE (0)
+#endif
+
+/**
+ * @brief MBUS 跟踪直方图可精确统计的最大值位数，超过 2^n 的时间计入最后一个桶。
+ */
+#ifndef XF_TASK_MBUS_TRACE_HIST_BITS
+#   define XF_TASK_MBUS_TRACE_HIST_BITS (16)
+#endif
+
+/**
+ * @brief MBUS 跟踪自动输出周期（单位与 tick 相同），为 0 时不自动输出。
+ */
+#ifndef XF_TASK_MBUS_TRACE_DUMP_PERIOD
+#   define XF_TASK_MBUS_TRACE_DUMP_PERIOD (0)
+#endif
+
 /**
  * @brief 是否打开任务池功能。
  */
@@ -40,6 +82,61 @@ extern "C" {
 #   define XF_TASK_POOL_IS_ENABLE (0)
 #endif
 
+/**
+ * @brief 任务池作业队列中每个工作任务单次调度最多执行的作业数。
+ */
+#ifndef XF_TASK_POOL_JOB_BATCH
+#   define XF_TASK_POOL_JOB_BATCH (16)
+#endif
+
+/**
+ * @brief 是否打开 future 功能。
+ */
+#if !defined(XF_TASK_FUTURE_ENABLE) || (XF_TASK_FUTURE_ENABLE)
+#   define XF_TASK_FUTURE_IS_ENABLE (1)
+#else
+#   define XF_TASK_FUTURE_IS_ENABLE (0)
+#endif
+
+// 紧凑布局下删除函数表除了默认与静态任务的删除函数，还要容纳任务池与 future 替换的删除函数
+#if XF_TASK_COMPACT_IS_ENABLE && (XF_TASK_DELETE_TYPES < 2 + XF_TASK_POOL_IS_ENABLE + XF_TASK_FUTURE_IS_ENABLE)
+#   error "XF_TASK_DELETE_TYPES is too small for the task pool and future delete hooks"
+#endif
+
+/**
+ * @brief 是否打开并行（parallel_for / parallel_reduce）功能。
+ */
+#if !defined(XF_TASK_PARALLEL_ENABLE) || (XF_TASK_PARALLEL_ENABLE)
+#   define XF_TASK_PARALLEL_IS_ENABLE (1)
+#else
+#   define XF_TASK_PARALLEL_IS_ENABLE (0)
+#endif
+
+/**
+ * @brief 是否打开任务依赖图功能。
+ */
+#if !defined(XF_TASK_GRAPH_ENABLE) || (XF_TASK_GRAPH_ENABLE)
+#   define XF_TASK_GRAPH_IS_ENABLE (1)
+#else
+#   define XF_TASK_GRAPH_IS_ENABLE (0)
+#endif
+
+/**
+ * @brief 是否打开仿真功能（虚拟时钟与负载生成），用于压测调度器。默认关闭。
+ */
+#if defined(XF_TASK_SIM_ENABLE) && (XF_TASK_SIM_ENABLE)
+#   define XF_TASK_SIM_IS_ENABLE (1)
+#else
+#   define XF_TASK_SIM_IS_ENABLE (0)
+#endif
+
+/**
+ * @brief 仿真延迟直方图的桶数，每个桶为 1 tick，超过的延迟计入最后一个桶。
+ */
+#ifndef XF_TASK_SIM_HIST_SIZE
+#   define XF_TASK_SIM_HIST_SIZE (1024)
+#endif
+
 /* ==================== [Typedefs] ========================================== */
 
 /* ==================== [Global Prototypes] ================================= */
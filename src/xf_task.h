@@ -54,6 +54,16 @@
 #include "utils/xf_task_mbus.h"
 #include "utils/xf_task_queue.h"
 #include "utils/xf_task_pool.h"
+#include "utils/xf_task_future.h"
+#include "utils/xf_task_parallel.h"
+#include "utils/xf_task_graph.h"
+#include "utils/xf_task_sim.h"
+
+/* 对象定义，只用于 XF_*_STORAGE_SIZE 等静态分配的宏 */
+#include "kernel/xf_task_manager_internal.h"
+#include "task/xf_ntask_internal.h"
+#include "task/xf_ctask_internal.h"
+#include "utils/xf_task_mbus_internal.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -89,6 +99,24 @@ xf_task_t xf_ctask_create(xf_task_func_t func, void *func_arg, uint16_t priority
                                        &config);
 }
 
+/**
+ * @brief 在默认的任务管理下，使用用户提供的内存创建 ctask 任务。
+ *
+ * @param func ctask 任务执行的函数。
+ * @param func_arg 用户自定义执行函数参数。
+ * @param priority 任务优先级。
+ * @param stack_size 任务上下文堆栈大小。
+ * @param storage 任务内存，至少 XF_CTASK_STORAGE_SIZE(stack_size) 字节。
+ * @return xf_task_t 任务对象，返回为 NULL 则表示创建失败
+ */
+static inline
+xf_task_t xf_ctask_create_static(xf_task_func_t func, void *func_arg, uint16_t priority, size_t stack_size,
+                                 void *storage)
+{
+    return xf_ctask_create_static_with_manager(xf_task_get_default_manager(), func, func_arg, priority, stack_size,
+            storage);
+}
+
 /**
  * @brief 延时函数。
  *
@@ -102,6 +130,22 @@ void xf_ctask_delay(uint32_t delay_ms)
     xf_ctask_delay_with_manager(xf_task_get_default_manager(), delay_ms);
 }
 
+#if XF_TASK_YIELD_CHECK_IS_ENABLE
+/**
+ * @brief 在需要时让出 CPU.
+ *
+ * @attention 该函数只能在 ctask 任务中使用。
+ *
+ * @return true 已经让出并重新被调度
+ * @return false 不需要让出
+ */
+static inline
+bool xf_ctask_yield_if_needed(void)
+{
+    return xf_ctask_yield_if_needed_with_manager(xf_task_get_default_manager());
+}
+#endif // XF_TASK_YIELD_CHECK_IS_ENABLE
+
 /**
  * @brief 创建 ctask 消息队列。
  *
@@ -117,6 +161,20 @@ xf_ctask_queue_t xf_ctask_queue_create(const size_t size, const size_t count)
     return xf_ctask_queue_create_with_manager(xf_task_get_default_manager(), size, count);
 }
 
+/**
+ * @brief 使用用户提供的内存创建 ctask 消息队列。
+ *
+ * @param size 消息队列的大小。
+ * @param count 消息队列的数量。
+ * @param storage 队列内存，至少 XF_CTASK_QUEUE_STORAGE_SIZE(size, count) 字节。
+ * @return xf_ctask_queue_t 消息队列对象，返回为 NULL 则表示创建失败
+ */
+static inline
+xf_ctask_queue_t xf_ctask_queue_create_static(const size_t size, const size_t count, void *storage)
+{
+    return xf_ctask_queue_create_static_with_manager(xf_task_get_default_manager(), size, count, storage);
+}
+
 /**
  * End of group_xf_task_user_ctask
  * @}
@@ -164,6 +222,25 @@ xf_task_t xf_ntask_create_loop(xf_task_func_t func, void *func_arg, uint16_t pri
                                        &config);
 }
 
+/**
+ * @brief 在默认的任务管理下，使用用户提供的内存创建 ntask 任务。
+ *
+ * @param func ntask 任务执行的函数。
+ * @param func_arg 用户自定义执行函数参数。
+ * @param priority 任务优先级。
+ * @param delay_ms 任务延时周期，单位为毫秒。
+ * @param count 任务循环的次数上限。
+ * @param storage 任务内存，至少 @ref XF_NTASK_STORAGE_SIZE 字节。
+ * @return xf_task_t 任务对象，返回为 NULL 则表示创建失败
+ */
+static inline
+xf_task_t xf_ntask_create_static(xf_task_func_t func, void *func_arg, uint16_t priority, uint32_t delay_ms,
+                                 uint32_t count, void *storage)
+{
+    return xf_ntask_create_static_with_manager(xf_task_get_default_manager(), func, func_arg, priority, delay_ms,
+            count, storage);
+}
+
 /**
  * End of group_xf_task_user_ntask
  * @}
@@ -255,6 +332,146 @@ static inline xf_task_pool_t xf_ntask_pool_create(uint32_t max_works, uint32_t d
 
 #endif // XF_TASK_POOL_IS_ENABLE
 
+#if XF_TASK_FUTURE_IS_ENABLE
+
+/**
+ * @ingroup group_xf_task_user_future
+ * @{
+ */
+
+/**
+ * @brief 在默认的任务管理下，创建一个 future.
+ *
+ * @return xf_task_future_t future 对象，返回 NULL 则表示创建失败
+ */
+static inline xf_task_future_t xf_task_future_create(void)
+{
+    return xf_task_future_create_with_manager(xf_task_get_default_manager());
+}
+
+#if XF_TASK_CONTEXT_IS_ENABLE
+
+/**
+ * @brief 在默认的任务管理下，创建 ctask 并返回表示其完成的 future.
+ *
+ * @param func ctask 任务执行的函数。
+ * @param func_arg 用户自定义执行函数参数。
+ * @param priority 任务优先级。
+ * @param stack_size 任务上下文堆栈大小。
+ * @return xf_task_future_t future 对象，返回 NULL 则表示创建失败
+ */
+static inline xf_task_future_t xf_ctask_spawn_future(xf_task_func_t func, void *func_arg, uint16_t priority,
+        size_t stack_size)
+{
+    xf_ctask_config_t config = {.stack_size = stack_size};
+    return xf_task_spawn_future_with_manager(xf_task_get_default_manager(), XF_TASK_TYPE_CTASK, func, func_arg,
+            priority, &config);
+}
+
+#endif // XF_TASK_CONTEXT_IS_ENABLE
+
+/**
+ * @brief 在默认的任务管理下，创建 ntask 并返回表示其完成的 future.
+ *
+ * @param func ntask 任务执行的函数。
+ * @param func_arg 用户自定义执行函数参数。
+ * @param priority 任务优先级。
+ * @param delay_ms 任务延时，单位为毫秒。
+ * @param count 任务循环的次数上限。
+ * @return xf_task_future_t future 对象，返回 NULL 则表示创建失败
+ */
+static inline xf_task_future_t xf_ntask_spawn_future(xf_task_func_t func, void *func_arg, uint16_t priority,
+        uint32_t delay_ms, uint32_t count)
+{
+    xf_ntask_config_t config = {.count = count, .delay_ms = delay_ms};
+    return xf_task_spawn_future_with_manager(xf_task_get_default_manager(), XF_TASK_TYPE_NTASK, func, func_arg,
+            priority, &config);
+}
+
+/**
+ * End of group_xf_task_user_future
+ * @}
+ */
+
+#endif // XF_TASK_FUTURE_IS_ENABLE
+
+#if XF_TASK_PARALLEL_IS_ENABLE
+
+/**
+ * @ingroup group_xf_task_user_parallel
+ * @{
+ */
+
+/**
+ * @brief 在默认的任务管理下，对 [begin, end) 并行执行 func.
+ *
+ * @param begin 起始下标。
+ * @param end 结束下标（不包括）。
+ * @param grain 每块的大小，为 0 时按线程数自动划分。
+ * @param func 块函数。
+ * @param arg 用户参数。
+ * @return xf_err_t 同 @ref xf_task_parallel_for_with_manager.
+ */
+static inline xf_err_t xf_task_parallel_for(uint32_t begin, uint32_t end, uint32_t grain,
+        xf_task_parallel_func_t func, void *arg)
+{
+    return xf_task_parallel_for_with_manager(xf_task_get_default_manager(), begin, end, grain, func, arg);
+}
+
+/**
+ * @brief 在默认的任务管理下，对 [begin, end) 并行归约。
+ *
+ * @param begin 起始下标。
+ * @param end 结束下标（不包括）。
+ * @param grain 每块的大小，为 0 时按线程数自动划分。
+ * @param func 块函数。
+ * @param join 合并函数。
+ * @param arg 用户参数。
+ * @param[in,out] result 输入初始值，输出归约结果。
+ * @param size 结果的字节数。
+ * @return xf_err_t 同 @ref xf_task_parallel_reduce_with_manager.
+ */
+static inline xf_err_t xf_task_parallel_reduce(uint32_t begin, uint32_t end, uint32_t grain,
+        xf_task_parallel_reduce_func_t func, xf_task_parallel_join_func_t join, void *arg, void *result, size_t size)
+{
+    return xf_task_parallel_reduce_with_manager(xf_task_get_default_manager(), begin, end, grain, func, join, arg,
+            result, size);
+}
+
+/**
+ * End of group_xf_task_user_parallel
+ * @}
+ */
+
+#endif // XF_TASK_PARALLEL_IS_ENABLE
+
+#if XF_TASK_GRAPH_IS_ENABLE
+
+/**
+ * @ingroup group_xf_task_user_graph
+ * @{
+ */
+
+/**
+ * @brief 在默认的任务管理下创建任务依赖图。
+ *
+ * @param max_nodes 最大节点数。
+ * @param max_edges 最大边数。
+ * @param priority 关键路径上节点的优先级。
+ * @return xf_task_graph_t 任务依赖图，返回 NULL 则表示创建失败
+ */
+static inline xf_task_graph_t xf_task_graph_create(uint32_t max_nodes, uint32_t max_edges, uint16_t priority)
+{
+    return xf_task_graph_create_with_manager(xf_task_get_default_manager(), max_nodes, max_edges, priority);
+}
+
+/**
+ * End of group_xf_task_user_graph
+ * @}
+ */
+
+#endif // XF_TASK_GRAPH_IS_ENABLE
+
 /* ==================== [Macros] ============================================ */
 
 #ifdef __cplusplus
@@ -34,10 +34,14 @@ extern "C" {
 #endif
 
 /**
- * @brief 设置 xf_task 时间戳类型宏。
+ * @brief 设置 xf_task 时间戳类型宏，紧凑布局（XF_TASK_COMPACT_ENABLE）下默认为 32 位。
  */
 #ifndef XF_TASK_TIME_TYPE
-#   define XF_TASK_TIME_TYPE uint64_t
+#   if defined(XF_TASK_COMPACT_ENABLE) && (XF_TASK_COMPACT_ENABLE)
+#       define XF_TASK_TIME_TYPE uint32_t
+#   else
+#       define XF_TASK_TIME_TYPE uint64_t
+#   endif
 #endif
 
 /* ==================== [Typedefs] ========================================== */
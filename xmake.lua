@@ -18,6 +18,7 @@ function add_port()
     add_includedirs("port")
     add_files("port/asm/jump_gas.S")
     add_files("port/asm/make_gas.S")
+    add_syslinks("pthread")
 end
 
 -- 模板化添加示例工程
@@ -32,6 +33,20 @@ function add_target(name)
         add_port()
 end 
 
+-- 模板化添加基准测试，与示例不同需要打开优化
+function add_bench(name) 
+    target("bench_" .. name)
+        set_kind("binary")
+        set_group("bench")
+        set_default(false)
+        add_cflags("-Wall")
+        add_files(string.format("bench/bench_%s.c", name))
+        add_includedirs("bench")
+        add_xf_task()
+        set_optimize("faster")
+        add_port()
+end 
+
 add_target("ctask")
 add_target("ntask")
 add_target("task")
@@ -43,7 +58,47 @@ add_target("trigger")
 add_target("mbus")
 add_target("ntask2")
 add_target("task_pool")
-add_target("test")
+add_target("sim")
+add_target("table")
 
+-- 带断言的功能例程，运行结束即退出，可以用 xmake r test 全部运行
+test_examples = {
+    "deadline",
+    "fair",
+    "yield",
+    "future",
+    "parallel",
+    "graph",
+    "mbus_rpc",
+    "mbus_pattern",
+    "mbus_bridge",
+    "urgent_queue",
+    "pool",
+    "ntask_rate",
+    "stats",
+    "trace",
+    "compact",
+    "static",
+    "ntask_fast",
+}
+for _, name in ipairs(test_examples) do
+    add_target(name)
+end
 
+target("test")
+    set_kind("phony")
+    set_default(false)
+    add_deps(test_examples)
+    on_run(function (target)
+        for _, dep in ipairs(target:orderdeps()) do
+            os.execv(dep:targetfile())
+        end
+    end)
 
+add_bench("dispatch")
+add_bench("trigger")
+add_bench("ctask_switch")
+add_bench("queue")
+add_bench("mbus")
+add_bench("pool")
+add_bench("memory")